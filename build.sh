@@ -139,6 +139,10 @@ do
         CMAKE_EXTRA_OPTIONS="-DTESTS=ON ${CMAKE_EXTRA_OPTIONS}"
         echo "Build tests"
     ;;
+    bench)
+        CMAKE_EXTRA_OPTIONS="-DTESTS=ON -DBENCHMARKS=ON ${CMAKE_EXTRA_OPTIONS}"
+        echo "Build tests and benchmarks"
+    ;;
     coverage)
         CMAKE_EXTRA_OPTIONS="-DLLVM_EXTRA_TOOLS=ON -DENABLE_COVERAGE=ON ${CMAKE_EXTRA_OPTIONS}"
         run_code_coverage=1
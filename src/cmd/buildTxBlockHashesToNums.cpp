@@ -51,8 +51,11 @@ int main(int argc, char* argv[]) {
   const auto it = std::unique_ptr<leveldb::Iterator>(
       txBlockchainDB.GetDB()->NewIterator(leveldb::ReadOptions()));
   for (it->SeekToFirst(); it->Valid(); it->Next()) {
-    const uint64_t blockNum = std::stoull(it->key().ToString());
-    const auto blockString = txBlockchainDB.Lookup(blockNum);
+    uint64_t blockNum = 0;
+    if (!LevelDB::ParseBlockNumKey(it->key(), blockNum)) {
+      continue;
+    }
+    const auto blockString = it->value().ToString();
     TxBlock block;
     block.Deserialize(zbytes(blockString.begin(), blockString.end()), 0);
     txBlockHashToNumDB.Insert(block.GetBlockHash(), std::to_string(blockNum));
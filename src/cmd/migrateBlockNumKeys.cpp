@@ -0,0 +1,60 @@
+/*
+ * Copyright (C) 2023 Zilliqa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <iostream>
+#include <limits>
+
+#include <depends/libDatabase/LevelDB.h>
+
+// Rewrites the decimal block number keys of the block databases as binary
+// keys (see LevelDB::BlockNumKey). Every batch is atomic and reads fall back
+// to the decimal keys, so the migration can be interrupted and resumed.
+int main(int argc, char* argv[]) {
+  if (argc < 2 || argc > 3) {
+    std::cerr << "Usage: " << argv[0] << " PERSISTENCE_PATH [BATCH_SIZE]"
+              << std::endl;
+    exit(1);
+  }
+  const std::string persistencePath = argv[1];
+  const unsigned int batchSize = (argc == 3) ? std::stoul(argv[2]) : 1000;
+  const std::string EMPTY_SUBDIR{};
+
+  for (const auto& dbName : {"dsBlocks", "txBlocks", "blockLinks",
+                             "stateDelta"}) {
+    // Pass explicitly subdir as an empty std::string type to invoke proper ctor
+    LevelDB db{dbName, persistencePath, EMPTY_SUBDIR};
+    if (!db.GetDB()) {
+      std::cerr << "Skipping " << dbName << ", unable to open it" << std::endl;
+      continue;
+    }
+
+    uint64_t total = 0;
+    for (;;) {
+      const auto migrated = db.MigrateBlockNumKeys(batchSize * 100, batchSize);
+      if (migrated == 0) {
+        break;
+      }
+      total += migrated;
+      std::cerr << dbName << ": migrated " << total << " keys" << std::endl;
+    }
+
+    db.compact();
+    std::cerr << dbName << ": done, " << total << " keys migrated" << std::endl;
+  }
+
+  return 0;
+}
@@ -15,11 +15,16 @@
  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
  */
 
+#include <filesystem>
 #include <iostream>
+#include <random>
 
 #include <depends/libDatabase/LevelDB.h>
+#include <depends/libTrie/TrieCommon.h>
 #include <libBlockchain/TxBlock.h>
 #include <libData/AccountStore/AccountStore.h>
+#include <libPersistence/BlockStorage.h>
+#include <libUtils/DataConversion.h>
 
 #include <boost/asio/post.hpp>
 #include <boost/asio/thread_pool.hpp>
@@ -61,10 +66,180 @@ int findMaxTxBlock(const LevelDB& txBlockchainDB) {
   return left;
 }
 
+struct TrieStats {
+  uint64_t nodes = 0;
+  uint64_t leaves = 0;
+  uint64_t leafDepthSum = 0;
+  unsigned int maxDepth = 0;
+};
+
+void CollectTrieStats(const dev::OverlayDB& db, const dev::RLP& node,
+                      unsigned int depth, TrieStats& stats) {
+  auto visitChild = [&](const dev::RLP& child) {
+    if (child.isList()) {
+      CollectTrieStats(db, child, depth + 1, stats);
+    } else if (child.isData() && child.size() == 32) {
+      const auto childNode = db.lookup(child.toHash<dev::h256>());
+      CollectTrieStats(db, dev::RLP(childNode), depth + 1, stats);
+    }
+  };
+
+  stats.nodes++;
+  if (node.itemCount() == 17) {
+    for (unsigned int i = 0; i < 16; i++) {
+      if (!node[i].isEmpty()) {
+        visitChild(node[i]);
+      }
+    }
+  } else if (node.itemCount() == 2) {
+    if (dev::isLeaf(node)) {
+      stats.leaves++;
+      stats.leafDepthSum += depth;
+      stats.maxDepth = std::max(stats.maxDepth, depth);
+    } else {
+      visitChild(node[1]);
+    }
+  }
+}
+
+void PrintTrieStats(const std::string& name, const dev::OverlayDB& db,
+                    const dev::h256& root, const std::string& dbPath) {
+  TrieStats stats;
+  const auto rootNode = db.lookup(root);
+  CollectTrieStats(db, dev::RLP(rootNode), 1, stats);
+
+  uint64_t dbSize = 0;
+  for (const auto& entry : std::filesystem::directory_iterator(dbPath)) {
+    if (entry.is_regular_file()) {
+      dbSize += entry.file_size();
+    }
+  }
+
+  std::cerr << name << ": " << stats.leaves << " accounts, " << stats.nodes
+            << " nodes, max depth " << stats.maxDepth << ", average depth "
+            << (stats.leaves ? stats.leafDepthSum / double(stats.leaves) : 0)
+            << ", db size " << dbSize / (1024 * 1024) << " MB" << std::endl;
+}
+
+template <class Trie>
+int64_t TimeLookups(const Trie& trie, const std::vector<Address>& addresses,
+                    unsigned int keyVersion) {
+  const auto started = std::chrono::steady_clock::now();
+  for (const auto& address : addresses) {
+    if (trie.at(GetStateTrieKey(address, keyVersion)).empty()) {
+      std::cerr << "Account " << address << " is missing" << std::endl;
+      exit(1);
+    }
+  }
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+             std::chrono::steady_clock::now() - started)
+      .count();
+}
+
+// Rewrites the latest account state trie with binary address keys into a new
+// database, validates it and swaps it in place of the "state" database. The
+// historical roots are not carried over.
+int MigrateStateTrieKeys() {
+  constexpr unsigned int NUM_SAMPLED_LOOKUPS = 10000;
+
+  const std::string persistence = STORAGE_PATH + PERSISTENCE_PATH + "/";
+  const std::string statePath = persistence + "state";
+  const std::string migratedPath = persistence + "state_migrated";
+
+  auto& blockStorage = BlockStorage::GetBlockStorage();
+  zbytes data;
+  unsigned int keyVersion = HEX_ADDRESS_KEYS;
+  if (blockStorage.GetMetadata(STATE_TRIE_KEY_VERSION_USED, data, true)) {
+    keyVersion = std::stoul(DataConversion::CharArrayToString(data));
+  }
+  if (keyVersion == BINARY_ADDRESS_KEYS) {
+    std::cerr << "State trie already uses binary keys" << std::endl;
+    return 0;
+  }
+  if (!blockStorage.GetStateRoot(data)) {
+    std::cerr << "Unable to read the state root" << std::endl;
+    return 1;
+  }
+  const dev::h256 oldRoot(data);
+  dev::h256 newRoot;
+
+  std::vector<Address> sample;
+  std::mt19937 gen(std::random_device{}());
+  uint64_t count = 0;
+
+  {
+    dev::OverlayDB oldDb{"state"};
+    dev::GenericTrieDB oldState{&oldDb};
+    oldState.setRoot(oldRoot);
+
+    dev::OverlayDB newDb{"state_migrated"};
+    newDb.ResetDB();
+    dev::GenericTrieDB newState{&newDb};
+    newState.init();
+
+    for (auto iter = oldState.begin(); iter != oldState.end(); ++iter) {
+      const auto [key, val] = iter.at();
+      const auto address = GetAddressFromStateTrieKey(key);
+      newState.insert(GetStateTrieKey(address, BINARY_ADDRESS_KEYS), val);
+
+      // Reservoir sample of the addresses for the lookup timings
+      if (sample.size() < NUM_SAMPLED_LOOKUPS) {
+        sample.push_back(address);
+      } else {
+        std::uniform_int_distribution<uint64_t> dist(0, count);
+        const auto idx = dist(gen);
+        if (idx < NUM_SAMPLED_LOOKUPS) {
+          sample[idx] = address;
+        }
+      }
+      if (++count % 100000 == 0) {
+        std::cerr << "Migrated " << count << " accounts" << std::endl;
+        newDb.commit();
+      }
+    }
+    newDb.commit();
+    newRoot = newState.root();
+    newDb.compact();
+    std::cerr << "Migrated " << count << " accounts, new state root "
+              << newRoot << std::endl;
+
+    PrintTrieStats("Hex keys", oldDb, oldRoot, statePath);
+    PrintTrieStats("Binary keys", newDb, newRoot, migratedPath);
+
+    std::cerr << "Lookup of " << sample.size() << " accounts, hex keys: "
+              << TimeLookups(oldState, sample, HEX_ADDRESS_KEYS)
+              << " us, binary keys: "
+              << TimeLookups(newState, sample, BINARY_ADDRESS_KEYS) << " us"
+              << std::endl;
+  }
+
+  std::filesystem::rename(statePath, persistence + "state_hexkeys");
+  std::filesystem::rename(migratedPath, statePath);
+
+  if (!blockStorage.PutStateRoot(newRoot.asBytes()) ||
+      !blockStorage.PutMetadata(
+          STATE_TRIE_KEY_VERSION_USED,
+          DataConversion::StringToCharArray(
+              std::to_string(BINARY_ADDRESS_KEYS)))) {
+    std::cerr << "Unable to store the new state root" << std::endl;
+    return 1;
+  }
+
+  std::cerr << "Done, the previous state is kept in " << persistence
+            << "state_hexkeys. Set STATE_TRIE_KEY_VERSION to "
+            << BINARY_ADDRESS_KEYS << " before starting the node." << std::endl;
+  return 0;
+}
+
 int main(int argc, char* argv[]) {
+  if (argc == 2 && std::string(argv[1]) == "--migrate-trie-keys") {
+    return MigrateStateTrieKeys();
+  }
+
   if (argc != 2) {
     std::cerr << "Usage: " << argv[0] << " NUM_OF_BLOCKS_TO_KEEP_STATE"
               << std::endl;
+    std::cerr << "       " << argv[0] << " --migrate-trie-keys" << std::endl;
     exit(1);
   }
   const auto blocksNum = std::atoi(argv[1]);
@@ -0,0 +1,235 @@
+/*
+ * Copyright (C) 2023 Zilliqa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "libData/AccountStore/AccountStore.h"
+#include "libPersistence/BlockStorage.h"
+#include "libUtils/Logger.h"
+#include "libUtils/TxnExtras.h"
+
+/// Re-executes the transactions recorded in the persistence of a lookup, to
+/// measure the execution engines on real workloads without a network. Should
+/// be run from a folder with constants.xml and the "persistence" folder. The
+/// state trie must still hold the state of the block before FROM, as kept by
+/// lookups with KEEP_HISTORICAL_STATE.
+
+namespace {
+
+struct TypeStats {
+  std::vector<double> m_latenciesUs;
+  uint64_t m_gas = 0;
+  uint64_t m_failed = 0;
+};
+
+std::string GetTypeName(const Transaction& tx) {
+  std::string name = tx.IsEth() ? "eth " : "zil ";
+  switch (Transaction::GetTransactionType(tx)) {
+    case Transaction::NON_CONTRACT:
+      return name + "transfer";
+    case Transaction::CONTRACT_CREATION:
+      return name + "contract creation";
+    case Transaction::CONTRACT_CALL:
+      return name + "contract call";
+    default:
+      return name + "error";
+  }
+}
+
+double Percentile(std::vector<double>& values, double fraction) {
+  const auto idx = static_cast<size_t>(fraction * (values.size() - 1));
+  std::nth_element(values.begin(), values.begin() + idx, values.end());
+  return values[idx];
+}
+
+bool GetStateRoot(uint64_t blockNum, dev::h256& root) {
+  TxBlockSharedPtr txBlock;
+  if (!BlockStorage::GetBlockStorage().GetTxBlock(blockNum, txBlock)) {
+    std::cerr << "Unable to find TxBlock " << blockNum << std::endl;
+    return false;
+  }
+  root = txBlock->GetHeader().GetStateRootHash();
+  return true;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  if (argc != 3) {
+    std::cerr << "Usage: " << argv[0] << " FROM_TXBLOCK TO_TXBLOCK"
+              << std::endl;
+    std::cerr << "Restores the state after TxBlock FROM_TXBLOCK - 1 and "
+                 "replays the transactions of TxBlocks FROM_TXBLOCK to "
+                 "TO_TXBLOCK"
+              << std::endl;
+    return 1;
+  }
+  const uint64_t fromBlock = std::stoull(argv[1]);
+  const uint64_t toBlock = std::stoull(argv[2]);
+  if (fromBlock == 0 || toBlock < fromBlock) {
+    std::cerr << "Invalid block range" << std::endl;
+    return 1;
+  }
+
+  INIT_FILE_LOGGER("replayBlocks", std::filesystem::current_path());
+
+  // Only lookups keep the transaction bodies, but they are executed as a DS
+  // node does
+  LOOKUP_NODE_MODE = true;
+  auto& blockStorage = BlockStorage::GetBlockStorage();
+  LOOKUP_NODE_MODE = false;
+  auto& accountStore = AccountStore::GetInstance();
+
+  dev::h256 root;
+  if (!GetStateRoot(fromBlock - 1, root) ||
+      !accountStore.RetrieveFromDisk(root)) {
+    std::cerr << "Unable to restore the state of TxBlock " << fromBlock - 1
+              << std::endl;
+    return 1;
+  }
+
+  std::cerr << "Replaying TxBlocks " << fromBlock << " to " << toBlock
+            << (ENABLE_CPS ? " with" : " without") << " CPS" << std::endl;
+
+  std::map<std::string, TypeStats> statsByType;
+  uint64_t numTxns = 0;
+  uint64_t totalGas = 0;
+  uint64_t numMismatches = 0;
+  std::chrono::nanoseconds executionTime{0};
+  std::chrono::nanoseconds commitTime{0};
+
+  for (uint64_t blockNum = fromBlock; blockNum <= toBlock; blockNum++) {
+    TxBlockSharedPtr prevBlock, txBlock;
+    DSBlockSharedPtr dsBlock;
+    if (!blockStorage.GetTxBlock(blockNum - 1, prevBlock) ||
+        !blockStorage.GetTxBlock(blockNum, txBlock) ||
+        !blockStorage.GetDSBlock(txBlock->GetHeader().GetDSBlockNum(),
+                                 dsBlock)) {
+      std::cerr << "Unable to find the blocks of TxBlock " << blockNum
+                << std::endl;
+      return 1;
+    }
+
+    // As Validator::CheckCreatedTransaction sets them for the epoch
+    const TxnExtras extras{
+        dsBlock->GetHeader().GetGasPrice(),
+        prevBlock->GetTimestamp() / 1000000,  // From microseconds to seconds.
+        dsBlock->GetHeader().GetDifficulty()};
+
+    accountStore.InitTemp();
+    uint64_t blockTxns = 0;
+    for (const auto& info : txBlock->GetMicroBlockInfos()) {
+      if (info.m_txnRootHash == TxnHash()) {
+        continue;
+      }
+      MicroBlockSharedPtr microBlock;
+      if (!blockStorage.GetMicroBlock(info.m_microBlockHash, microBlock)) {
+        std::cerr << "Unable to find microblock " << info.m_microBlockHash
+                  << std::endl;
+        return 1;
+      }
+      for (const auto& tranHash : microBlock->GetTranHashes()) {
+        TxBodySharedPtr body;
+        if (!blockStorage.GetTxBody(tranHash, body)) {
+          std::cerr << "Unable to find transaction " << tranHash << std::endl;
+          return 1;
+        }
+        const auto& tx = body->GetTransaction();
+
+        TransactionReceipt receipt;
+        receipt.SetEpochNum(blockNum);
+        TxnStatus error_code;
+        const auto started = std::chrono::steady_clock::now();
+        const bool applied = accountStore.UpdateAccountsTemp(
+            blockNum, 0, true, tx, extras, receipt, error_code);
+        const auto elapsed = std::chrono::steady_clock::now() - started;
+
+        auto& stats = statsByType[GetTypeName(tx)];
+        stats.m_latenciesUs.push_back(
+            std::chrono::duration<double, std::micro>(elapsed).count());
+        if (applied) {
+          stats.m_gas += receipt.GetCumGas();
+          totalGas += receipt.GetCumGas();
+        } else {
+          // Only the transactions that were applied are recorded
+          stats.m_failed++;
+          std::cerr << "Transaction " << tranHash << " failed with "
+                    << static_cast<int>(error_code) << std::endl;
+        }
+        executionTime += elapsed;
+        blockTxns++;
+      }
+    }
+    accountStore.ProcessStorageRootUpdateBufferTemp();
+    accountStore.CleanNewLibrariesCacheTemp();
+
+    const auto started = std::chrono::steady_clock::now();
+    accountStore.SerializeDelta();
+    accountStore.CommitTemp();
+    commitTime += std::chrono::steady_clock::now() - started;
+    numTxns += blockTxns;
+
+    const auto expected = txBlock->GetHeader().GetStateRootHash();
+    if (accountStore.GetStateRootHash() != expected) {
+      // The rewards of vacuous epochs aren't replayed, so they mismatch
+      // without any transaction
+      if (blockTxns > 0) {
+        numMismatches++;
+        std::cerr << "TxBlock " << blockNum << " state root "
+                  << accountStore.GetStateRootHash() << " instead of "
+                  << expected << std::endl;
+      }
+      // Carry on from the recorded state
+      if (!accountStore.RetrieveFromDisk(expected)) {
+        std::cerr << "Unable to restore the state of TxBlock " << blockNum
+                  << std::endl;
+        return 1;
+      }
+    }
+    std::cerr << "TxBlock " << blockNum << ": " << blockTxns << " txns"
+              << std::endl;
+  }
+
+  const double executionSecs =
+      std::chrono::duration<double>(executionTime).count();
+  std::cerr << "Replayed " << numTxns << " txns using " << totalGas
+            << " gas in " << executionSecs << " s, commits took "
+            << std::chrono::duration<double>(commitTime).count() << " s"
+            << std::endl;
+  if (executionSecs > 0) {
+    std::cerr << numTxns / executionSecs << " tx/s, "
+              << totalGas / executionSecs << " gas/s" << std::endl;
+  }
+  for (auto& [name, stats] : statsByType) {
+    auto& latencies = stats.m_latenciesUs;
+    std::cerr << name << ": " << latencies.size() << " txns, " << stats.m_failed
+              << " failed, " << stats.m_gas << " gas, latency p50 "
+              << Percentile(latencies, 0.5) << " us, p99 "
+              << Percentile(latencies, 0.99) << " us, max "
+              << *std::max_element(latencies.begin(), latencies.end()) << " us"
+              << std::endl;
+  }
+  std::cerr << numMismatches << " state root mismatches" << std::endl;
+
+  return numMismatches == 0 ? 0 : 1;
+}
@@ -144,6 +144,28 @@ const unsigned int MAX_LOG_FILE_SIZE_KB{
     ReadConstantNumeric("MAX_LOG_FILE_SIZE_KB")};
 const bool JSON_LOGGING{ReadConstantString("JSON_LOGGING") == "true"};
 const bool AUTO_UPGRADE{ReadConstantString("AUTO_UPGRADE") == "true"};
+const unsigned int LEVELDB_BLOCK_CACHE_MB{
+    ReadConstantNumeric("LEVELDB_BLOCK_CACHE_MB", "node.general.", 256)};
+const unsigned int LEVELDB_BLOOM_FILTER_BITS_PER_KEY{ReadConstantNumeric(
+    "LEVELDB_BLOOM_FILTER_BITS_PER_KEY", "node.general.", 10)};
+const unsigned int LEVELDB_WRITE_BUFFER_MB{
+    ReadConstantNumeric("LEVELDB_WRITE_BUFFER_MB", "node.general.", 4)};
+const unsigned int LEVELDB_SEQUENTIAL_WRITE_BUFFER_MB{ReadConstantNumeric(
+    "LEVELDB_SEQUENTIAL_WRITE_BUFFER_MB", "node.general.", 32)};
+const string LEVELDB_POINT_LOOKUP_DBS{ReadConstantString(
+    "LEVELDB_POINT_LOOKUP_DBS", "node.general.",
+    "txBodies,txEpochs,txLocations,microBlocks,txBlockHashToNum,txTraces,"
+    "otterTraces,state,contractTrie,contractCode,contractInitState2")};
+const string LEVELDB_SEQUENTIAL_WRITE_DBS{ReadConstantString(
+    "LEVELDB_SEQUENTIAL_WRITE_DBS", "node.general.",
+    "dsBlocks,txBlocks,txBlocksAux,VCBlocks,blockLinks,stateDelta,"
+    "microBlockKeys")};
+const unsigned int TRIE_NODE_CACHE_MB{
+    ReadConstantNumeric("TRIE_NODE_CACHE_MB", "node.general.", 256)};
+const unsigned int PURGE_TICK_INTERVAL_MS{
+    ReadConstantNumeric("PURGE_TICK_INTERVAL_MS", "node.general.", 1000)};
+const unsigned int PURGE_MAX_NODES_PER_TICK{
+    ReadConstantNumeric("PURGE_MAX_NODES_PER_TICK", "node.general.", 20000)};
 
 // Version constants
 const unsigned int MSG_VERSION{
@@ -164,6 +186,8 @@ const unsigned int SHARDINGSTRUCTURE_VERSION{
     ReadConstantNumeric("SHARDINGSTRUCTURE_VERSION", "node.version.")};
 const unsigned int CONTRACT_STATE_VERSION{
     ReadConstantNumeric("CONTRACT_STATE_VERSION", "node.version.")};
+const unsigned int STATE_TRIE_KEY_VERSION{
+    ReadConstantNumeric("STATE_TRIE_KEY_VERSION", "node.version.")};
 
 // Seed constans
 const bool ARCHIVAL_LOOKUP{
@@ -214,6 +238,14 @@ bool REMOTESTORAGE_DB_ENABLE{
     "true"};
 string REMOTESTORAGE_DB_TXN_UPDATER_NODE{ReadConstantString(
     "REMOTESTORAGE_DB_TXN_UPDATER_NODE", "node.remotestorageDB.", "lookup-1")};
+const unsigned int REMOTESTORAGE_DB_QUEUE_SIZE{ReadConstantNumeric(
+    "REMOTESTORAGE_DB_QUEUE_SIZE", "node.remotestorageDB.", 100000)};
+const unsigned int REMOTESTORAGE_DB_BATCH_SIZE{ReadConstantNumeric(
+    "REMOTESTORAGE_DB_BATCH_SIZE", "node.remotestorageDB.", 1000)};
+const unsigned int REMOTESTORAGE_DB_BATCH_INTERVAL_MS{ReadConstantNumeric(
+    "REMOTESTORAGE_DB_BATCH_INTERVAL_MS", "node.remotestorageDB.", 500)};
+const unsigned int REMOTESTORAGE_DB_ENQUEUE_TIMEOUT_MS{ReadConstantNumeric(
+    "REMOTESTORAGE_DB_ENQUEUE_TIMEOUT_MS", "node.remotestorageDB.", 100)};
 
 // Consensus constants
 const double TOLERANCE_FRACTION{
@@ -232,6 +264,9 @@ const unsigned int COMMIT_TOLERANCE_PERCENT{
     ReadConstantNumeric("COMMIT_TOLERANCE_PERCENT", "node.consensus.")};
 const unsigned int SUBSET0_RESPONSE_DELAY_IN_MS{
     ReadConstantNumeric("SUBSET0_RESPONSE_DELAY_IN_MS", "node.consensus.")};
+const bool CONSENSUS_OPTIMISTIC_RESPONSE_VERIFY{
+    ReadConstantString("CONSENSUS_OPTIMISTIC_RESPONSE_VERIFY",
+                       "node.consensus.") == "true"};
 
 // Data sharing constants
 const bool BROADCAST_TREEBASED_CLUSTER_MODE{
@@ -298,6 +333,10 @@ const unsigned int RETRY_REJOINING_TIMEOUT{
     ReadConstantNumeric("RETRY_REJOINING_TIMEOUT", "node.epoch_timing.")};
 const unsigned int RETRY_GETSTATEDELTAS_COUNT{
     ReadConstantNumeric("RETRY_GETSTATEDELTAS_COUNT", "node.epoch_timing.")};
+const unsigned int GETSTATEDELTAS_WINDOW{
+    ReadConstantNumeric("GETSTATEDELTAS_WINDOW", "node.epoch_timing.", 4)};
+const unsigned int GETSTATEDELTAS_CHUNK_SIZE{
+    ReadConstantNumeric("GETSTATEDELTAS_CHUNK_SIZE", "node.epoch_timing.", 10)};
 const unsigned int RETRY_COSIGREWARDS_COUNT{
     ReadConstantNumeric("RETRY_COSIGREWARDS_COUNT", "node.epoch_timing.")};
 const unsigned int MAX_FETCHMISSINGMBS_NUM{
@@ -443,6 +482,12 @@ const size_t REQUEST_PROCESSING_THREADS{
     ReadConstantNumeric("REQUEST_PROCESSING_THREADS", "node.jsonrpc.", 64)};
 const size_t REQUEST_QUEUE_SIZE{
     ReadConstantNumeric("REQUEST_QUEUE_SIZE", "node.jsonrpc.", 65536)};
+const unsigned int RPC_RESPONSE_CACHE_SIZE_MB{
+    ReadConstantNumeric("RPC_RESPONSE_CACHE_SIZE_MB", "node.jsonrpc.", 256)};
+const size_t RPC_MAX_BATCH_SIZE{
+    ReadConstantNumeric("RPC_MAX_BATCH_SIZE", "node.jsonrpc.", 1000)};
+const unsigned int MAX_CONTRACT_STATE_PAGE_SIZE{
+    ReadConstantNumeric("MAX_CONTRACT_STATE_PAGE_SIZE", "node.jsonrpc.", 1000)};
 
 // Network composition constants
 const unsigned int COMM_SIZE{
@@ -509,6 +554,14 @@ const bool OPENCL_GPU_MINE{ReadConstantString("OPENCL_GPU_MINE", "node.pow.") ==
                            "true"};
 const bool REMOTE_MINE{ReadConstantString("REMOTE_MINE", "node.pow.") ==
                        "true"};
+const unsigned int CPU_MINE_THREADS{
+    ReadConstantNumeric("CPU_MINE_THREADS", "node.pow.", 0)};
+const unsigned int ETHASH_PREGEN_BLOCKS_AHEAD{
+    ReadConstantNumeric("ETHASH_PREGEN_BLOCKS_AHEAD", "node.pow.", 5)};
+const unsigned int POW_VERIFY_THREADS{
+    ReadConstantNumeric("POW_VERIFY_THREADS", "node.pow.", 0)};
+const unsigned int POW_VERIFY_BATCH_SIZE{
+    ReadConstantNumeric("POW_VERIFY_BATCH_SIZE", "node.pow.", 256)};
 const bool REMOTE_MINE_EXTRA_DATA{
     ReadConstantString("REMOTE_MINE_EXTRA_DATA", "node.pow.") == "true"};
 const std::string MINING_PROXY_URL{
@@ -803,6 +856,8 @@ const std::string METRIC_ZILLIQA_SCHEMA_VERSION{ReadConstantString(
     "METRIC_ZILLIQA_SCHEMA_VERSION", "node.metric.zilliqa.", "1.2.0")};
 std::string METRIC_ZILLIQA_MASK{
     ReadConstantString("METRIC_ZILLIQA_MASK", "node.metric.zilliqa.", "NONE")};
+const std::string METRIC_ZILLIQA_LOGGED_TIMERS{ReadConstantString(
+    "METRIC_ZILLIQA_LOGGED_TIMERS", "node.metric.zilliqa.", "")};
 const std::string TRACE_ZILLIQA_MASK{
     ReadConstantString("TRACE_ZILLIQA_MASK", "node.trace.zilliqa.", "NONE")};
 const std::string TRACE_ZILLIQA_PROVIDER{ReadConstantString(
@@ -85,6 +85,13 @@ enum MetaType : unsigned char {
   LATEST_EPOCH_STATES_UPDATED,  // [deprecated soon]
   EPOCHFIN,
   EARLIEST_HISTORY_STATE_EPOCH,
+  STATE_TRIE_KEY_VERSION_USED,
+};
+
+// Key format of the account state trie
+enum StateTrieKeyVersion : unsigned int {
+  HEX_ADDRESS_KEYS = 0,     // 40-byte hex string of the address
+  BINARY_ADDRESS_KEYS = 1,  // 20 raw address bytes
 };
 
 // Sync Type
@@ -145,6 +152,15 @@ extern const unsigned int MAX_ARCHIVED_LOG_COUNT;
 extern const unsigned int MAX_LOG_FILE_SIZE_KB;
 extern const bool JSON_LOGGING;
 extern const bool AUTO_UPGRADE;
+extern const unsigned int LEVELDB_BLOCK_CACHE_MB;
+extern const unsigned int LEVELDB_BLOOM_FILTER_BITS_PER_KEY;
+extern const unsigned int LEVELDB_WRITE_BUFFER_MB;
+extern const unsigned int LEVELDB_SEQUENTIAL_WRITE_BUFFER_MB;
+extern const std::string LEVELDB_POINT_LOOKUP_DBS;
+extern const std::string LEVELDB_SEQUENTIAL_WRITE_DBS;
+extern const unsigned int TRIE_NODE_CACHE_MB;
+extern const unsigned int PURGE_TICK_INTERVAL_MS;
+extern const unsigned int PURGE_MAX_NODES_PER_TICK;
 
 // Version constants
 extern const unsigned int MSG_VERSION;
@@ -160,6 +176,7 @@ extern const unsigned int BLOCKLINK_VERSION;
 extern const unsigned int DSCOMMITTEE_VERSION;
 extern const unsigned int SHARDINGSTRUCTURE_VERSION;
 extern const unsigned int CONTRACT_STATE_VERSION;
+extern const unsigned int STATE_TRIE_KEY_VERSION;
 
 // Seed Node
 extern const bool ARCHIVAL_LOOKUP;
@@ -185,6 +202,10 @@ extern const unsigned int REMOTESTORAGE_DB_SOCKET_TIMEOUT_MS;
 extern const std::string REMOTESTORAGE_DB_TLS_FILE;
 extern bool REMOTESTORAGE_DB_ENABLE;
 extern std::string REMOTESTORAGE_DB_TXN_UPDATER_NODE;
+extern const unsigned int REMOTESTORAGE_DB_QUEUE_SIZE;
+extern const unsigned int REMOTESTORAGE_DB_BATCH_SIZE;
+extern const unsigned int REMOTESTORAGE_DB_BATCH_INTERVAL_MS;
+extern const unsigned int REMOTESTORAGE_DB_ENQUEUE_TIMEOUT_MS;
 
 // Consensus constants
 extern const double TOLERANCE_FRACTION;
@@ -195,6 +216,7 @@ extern const unsigned int DS_NUM_CONSENSUS_SUBSETS;
 extern const unsigned int SHARD_NUM_CONSENSUS_SUBSETS;
 extern const unsigned int COMMIT_TOLERANCE_PERCENT;
 extern const unsigned int SUBSET0_RESPONSE_DELAY_IN_MS;
+extern const bool CONSENSUS_OPTIMISTIC_RESPONSE_VERIFY;
 
 // Data sharing constants
 extern const bool BROADCAST_TREEBASED_CLUSTER_MODE;
@@ -231,6 +253,8 @@ extern const unsigned int GETSTATEDELTAS_TIMEOUT_IN_SECONDS;
 extern const unsigned int GETCOSIGREWARDS_TIMEOUT_IN_SECONDS;
 extern const unsigned int RETRY_REJOINING_TIMEOUT;
 extern const unsigned int RETRY_GETSTATEDELTAS_COUNT;
+extern const unsigned int GETSTATEDELTAS_WINDOW;
+extern const unsigned int GETSTATEDELTAS_CHUNK_SIZE;
 extern const unsigned int RETRY_COSIGREWARDS_COUNT;
 extern const unsigned int MAX_FETCHMISSINGMBS_NUM;
 extern const unsigned int LAST_N_TXBLKS_TOCHECK_FOR_MISSINGMBS;
@@ -321,6 +345,9 @@ extern const unsigned int CONNECTION_ALL_TIMEOUT;
 extern const unsigned int CONNECTION_CALLBACK_TIMEOUT;
 extern const size_t REQUEST_PROCESSING_THREADS;
 extern const size_t REQUEST_QUEUE_SIZE;
+extern const unsigned int RPC_RESPONSE_CACHE_SIZE_MB;
+extern const size_t RPC_MAX_BATCH_SIZE;
+extern const unsigned int MAX_CONTRACT_STATE_PAGE_SIZE;
 
 // Network composition constants
 extern const unsigned int COMM_SIZE;
@@ -357,6 +384,10 @@ extern const unsigned int RECONNECT_INTERVAL_IN_MS;
 extern const bool FULL_DATASET_MINE;
 extern const bool OPENCL_GPU_MINE;
 extern const bool REMOTE_MINE;
+extern const unsigned int CPU_MINE_THREADS;
+extern const unsigned int ETHASH_PREGEN_BLOCKS_AHEAD;
+extern const unsigned int POW_VERIFY_THREADS;
+extern const unsigned int POW_VERIFY_BATCH_SIZE;
 extern const bool REMOTE_MINE_EXTRA_DATA;
 extern const std::string MINING_PROXY_URL;
 extern const unsigned int MINING_PROXY_TIMEOUT_IN_MS;
@@ -514,6 +545,7 @@ extern const unsigned int METRIC_ZILLIQA_READER_TIMEOUT_MS;
 extern const std::string METRIC_ZILLIQA_SCHEMA;
 extern const std::string METRIC_ZILLIQA_SCHEMA_VERSION;
 extern std::string METRIC_ZILLIQA_MASK;
+extern const std::string METRIC_ZILLIQA_LOGGED_TIMERS;
 extern const std::string TRACE_ZILLIQA_MASK;
 extern const std::string TRACE_ZILLIQA_PROVIDER;
 extern const std::string TRACE_ZILLIQA_HOSTNAME;
@@ -15,18 +15,329 @@
  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
  */
 
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <set>
 #include <string>
 
+#include <leveldb/filter_policy.h>
+#include <boost/algorithm/string.hpp>
+
 #include "LevelDB.h"
 #include "common/Constants.h"
 #include "depends/common/Common.h"
 #include "depends/common/CommonData.h"
 #include "depends/common/FixedHash.h"
+#include "libMetrics/Api.h"
 #include "libUtils/DataConversion.h"
 #include "libUtils/Logger.h"
 
 using namespace std;
 
+namespace {
+
+/// Forwards to the block cache shared by all databases, counting the lookups
+/// of one database
+class CountingCache : public leveldb::Cache {
+ public:
+  CountingCache(leveldb::Cache* shared,
+                std::shared_ptr<LevelDBCacheStats> stats)
+      : m_shared(shared), m_stats(std::move(stats)) {}
+
+  Handle* Insert(const leveldb::Slice& key, void* value, size_t charge,
+                 void (*deleter)(const leveldb::Slice& key,
+                                 void* value)) override {
+    return m_shared->Insert(key, value, charge, deleter);
+  }
+
+  Handle* Lookup(const leveldb::Slice& key) override {
+    auto* handle = m_shared->Lookup(key);
+    (handle ? m_stats->hits : m_stats->misses)
+        .fetch_add(1, std::memory_order_relaxed);
+    return handle;
+  }
+
+  void Release(Handle* handle) override { m_shared->Release(handle); }
+
+  void* Value(Handle* handle) override { return m_shared->Value(handle); }
+
+  void Erase(const leveldb::Slice& key) override { m_shared->Erase(key); }
+
+  uint64_t NewId() override { return m_shared->NewId(); }
+
+  void Prune() override { m_shared->Prune(); }
+
+  size_t TotalCharge() const override { return m_shared->TotalCharge(); }
+
+ private:
+  leveldb::Cache* m_shared;
+  std::shared_ptr<LevelDBCacheStats> m_stats;
+};
+
+leveldb::Cache* SharedBlockCache() {
+  static std::unique_ptr<leveldb::Cache> cache(
+      LEVELDB_BLOCK_CACHE_MB > 0
+          ? leveldb::NewLRUCache(static_cast<size_t>(LEVELDB_BLOCK_CACHE_MB) *
+                                 1024 * 1024)
+          : nullptr);
+  return cache.get();
+}
+
+const leveldb::FilterPolicy* SharedBloomFilter() {
+  static std::unique_ptr<const leveldb::FilterPolicy> policy(
+      LEVELDB_BLOOM_FILTER_BITS_PER_KEY > 0
+          ? leveldb::NewBloomFilterPolicy(LEVELDB_BLOOM_FILTER_BITS_PER_KEY)
+          : nullptr);
+  return policy.get();
+}
+
+/// Reports the block cache lookups of every open database
+class LevelDBMetrics {
+ public:
+  static LevelDBMetrics& GetInstance() {
+    static LevelDBMetrics metrics;
+    return metrics;
+  }
+
+  void Register(const string& label,
+                const std::shared_ptr<LevelDBCacheStats>& stats) {
+    std::lock_guard<std::mutex> g(m_mutex);
+    m_stats[label] = stats;
+  }
+
+ private:
+  LevelDBMetrics() {
+    m_gauge.SetCallback([this](auto&& result) {
+      if (!m_gauge.Enabled()) {
+        return;
+      }
+      std::lock_guard<std::mutex> g(m_mutex);
+      for (auto it = m_stats.begin(); it != m_stats.end();) {
+        auto stats = it->second.lock();
+        if (!stats) {
+          it = m_stats.erase(it);
+          continue;
+        }
+        result.Set(stats->hits.load(),
+                   {{"db", it->first}, {"counter", "Hits"}});
+        result.Set(stats->misses.load(),
+                   {{"db", it->first}, {"counter", "Misses"}});
+        ++it;
+      }
+      if (auto* cache = SharedBlockCache()) {
+        result.Set(cache->TotalCharge(), {{"counter", "BlockCacheBytes"}});
+      }
+    });
+  }
+
+  std::mutex m_mutex;
+  std::map<string, std::weak_ptr<LevelDBCacheStats>> m_stats;
+  Z_I64GAUGE m_gauge{Z_FL::DATABASE, "leveldb.block_cache",
+                     "LevelDB block cache lookups per database", "lookups",
+                     true};
+};
+
+/// Databases keyed by block number that use binary keys, see
+/// LevelDB::BlockNumKey (VCBlocks is keyed by hash and not affected)
+const std::set<string> BINARY_BLOCK_NUM_KEY_DBS{"dsBlocks", "txBlocks",
+                                                "blockLinks", "stateDelta"};
+
+/// Decimal keys never contain a zero byte, so the prefix tells the encodings
+/// apart and makes every binary key sort before the decimal ones
+constexpr char BLOCK_NUM_KEY_PREFIX = '\0';
+constexpr size_t BLOCK_NUM_KEY_SIZE = 1 + sizeof(uint64_t);
+
+std::set<string> ParseDBNames(const string& names) {
+  std::set<string> result;
+  boost::split(result, names, boost::is_any_of(", "),
+               boost::token_compress_on);
+  result.erase("");
+  return result;
+}
+
+/// Strips the "_<n>" suffix of rotated databases such as txBodies_1
+string BaseDBName(const string& dbName) {
+  const auto pos = dbName.rfind('_');
+  if (pos == string::npos || pos == 0 || pos + 1 == dbName.size() ||
+      dbName.find_first_not_of("0123456789", pos + 1) != string::npos) {
+    return dbName;
+  }
+  return dbName.substr(0, pos);
+}
+
+}  // namespace
+
+string LevelDB::BlockNumKey(uint64_t blockNum) {
+  string key(BLOCK_NUM_KEY_SIZE, BLOCK_NUM_KEY_PREFIX);
+  for (size_t i = BLOCK_NUM_KEY_SIZE - 1; i > 0; --i) {
+    key[i] = static_cast<char>(blockNum & 0xff);
+    blockNum >>= 8;
+  }
+  return key;
+}
+
+bool LevelDB::ParseBlockNumKey(const leveldb::Slice& key, uint64_t& blockNum) {
+  if (key.empty()) {
+    return false;
+  }
+
+  if (key[0] == BLOCK_NUM_KEY_PREFIX) {
+    if (key.size() != BLOCK_NUM_KEY_SIZE) {
+      return false;
+    }
+    blockNum = 0;
+    for (size_t i = 1; i < BLOCK_NUM_KEY_SIZE; ++i) {
+      blockNum = (blockNum << 8) | static_cast<uint8_t>(key[i]);
+    }
+    return true;
+  }
+
+  uint64_t num = 0;
+  for (size_t i = 0; i < key.size(); ++i) {
+    if (key[i] < '0' || key[i] > '9' ||
+        num > (std::numeric_limits<uint64_t>::max() - 9) / 10) {
+      return false;
+    }
+    num = num * 10 + (key[i] - '0');
+  }
+  blockNum = num;
+  return true;
+}
+
+bool LevelDB::GetLastBlockNum(uint64_t& blockNum) const {
+  const char binaryKeysEnd = BLOCK_NUM_KEY_PREFIX + 1;
+  bool found = false;
+  blockNum = 0;
+
+  std::unique_ptr<leveldb::Iterator> it{
+      m_db->NewIterator(leveldb::ReadOptions())};
+
+  // Decimal keys are not ordered numerically, so they have to be scanned
+  uint64_t num = 0;
+  for (it->Seek(leveldb::Slice(&binaryKeysEnd, 1)); it->Valid(); it->Next()) {
+    if (ParseBlockNumKey(it->key(), num) && (!found || num > blockNum)) {
+      blockNum = num;
+      found = true;
+    }
+  }
+
+  // The last binary key is the highest binary block number
+  it->Seek(leveldb::Slice(&binaryKeysEnd, 1));
+  if (it->Valid()) {
+    it->Prev();
+  } else {
+    it->SeekToLast();
+  }
+  if (it->Valid() && it->key().size() == BLOCK_NUM_KEY_SIZE &&
+      ParseBlockNumKey(it->key(), num) && (!found || num > blockNum)) {
+    blockNum = num;
+    found = true;
+  }
+
+  return found;
+}
+
+uint64_t LevelDB::MigrateBlockNumKeys(uint64_t maxKeys,
+                                      unsigned int batchSize) {
+  const char binaryKeysEnd = BLOCK_NUM_KEY_PREFIX + 1;
+  uint64_t migrated = 0;
+
+  std::unique_ptr<leveldb::Iterator> it{
+      m_db->NewIterator(leveldb::ReadOptions())};
+  it->Seek(leveldb::Slice(&binaryKeysEnd, 1));
+
+  while (it->Valid() && migrated < maxKeys) {
+    ldb::WriteBatch batch;
+    unsigned int count = 0;
+    for (; it->Valid() && count < batchSize && migrated + count < maxKeys;
+         it->Next()) {
+      uint64_t blockNum = 0;
+      if (!ParseBlockNumKey(it->key(), blockNum)) {
+        continue;
+      }
+      // Both keys change in the same batch, so an interrupted migration
+      // leaves every block readable through the dual read
+      batch.Put(BlockNumKey(blockNum), it->value());
+      batch.Delete(it->key());
+      ++count;
+    }
+
+    if (count == 0) {
+      break;
+    }
+
+    leveldb::Status s = m_db->Write(leveldb::WriteOptions(), &batch);
+    if (!s.ok()) {
+      LOG_GENERAL(WARNING, "[MigrateBlockNumKeys] Status: " << s.ToString());
+      break;
+    }
+    migrated += count;
+  }
+
+  return migrated;
+}
+
+leveldb::Status LevelDB::GetBlockNum(
+    const boost::multiprecision::uint256_t& blockNum, string& value) const {
+  if (m_binaryBlockNumKeys) {
+    leveldb::Status s =
+        m_db->Get(leveldb::ReadOptions(),
+                  BlockNumKey(blockNum.convert_to<uint64_t>()), &value);
+    if (!s.IsNotFound()) {
+      return s;
+    }
+  }
+  return m_db->Get(leveldb::ReadOptions(), blockNum.convert_to<string>(),
+                   &value);
+}
+
+LevelDBProfile LevelDB::GetProfile(const string& dbName) {
+  static const auto pointLookupDBs = ParseDBNames(LEVELDB_POINT_LOOKUP_DBS);
+  static const auto sequentialWriteDBs =
+      ParseDBNames(LEVELDB_SEQUENTIAL_WRITE_DBS);
+
+  for (const auto& name : {dbName, BaseDBName(dbName)}) {
+    if (pointLookupDBs.count(name) > 0) {
+      return LevelDBProfile::POINT_LOOKUP;
+    }
+    if (sequentialWriteDBs.count(name) > 0) {
+      return LevelDBProfile::SEQUENTIAL_WRITE;
+    }
+  }
+  return LevelDBProfile::DEFAULT;
+}
+
+void LevelDB::ApplyProfile() {
+  m_options.max_open_files = 256;
+  m_options.create_if_missing = true;
+
+  const auto profile = GetProfile(m_dbName);
+  const size_t writeBufferMB = profile == LevelDBProfile::SEQUENTIAL_WRITE
+                                   ? LEVELDB_SEQUENTIAL_WRITE_BUFFER_MB
+                                   : LEVELDB_WRITE_BUFFER_MB;
+  if (writeBufferMB > 0) {
+    m_options.write_buffer_size = writeBufferMB * 1024 * 1024;
+  }
+
+  // Tables written without a filter stay readable, so enabling it is safe
+  if (profile == LevelDBProfile::POINT_LOOKUP) {
+    m_options.filter_policy = SharedBloomFilter();
+  }
+
+  // Block cache ids are unique across tables, so databases can share it
+  if (auto* shared = SharedBlockCache()) {
+    m_cacheStats = std::make_shared<LevelDBCacheStats>();
+    m_blockCache = std::make_shared<CountingCache>(shared, m_cacheStats);
+    m_options.block_cache = m_blockCache.get();
+    LevelDBMetrics::GetInstance().Register(
+        m_subdirectory.empty() ? m_dbName : m_subdirectory + "/" + m_dbName,
+        m_cacheStats);
+  }
+}
+
 void LevelDB::log_error(leveldb::Status status) const {
   if (!status.IsNotFound()) {
     LOG_GENERAL(WARNING, "LevelDB " << m_dbName << " status is not OK - "
@@ -38,6 +349,7 @@ LevelDB::LevelDB(const string& dbName, const string& path,
                  const string& subdirectory) {
   this->m_subdirectory = subdirectory;
   this->m_dbName = dbName;
+  this->m_binaryBlockNumKeys = BINARY_BLOCK_NUM_KEY_DBS.count(dbName) > 0;
   this->m_db = NULL;
 
   if (!(std::filesystem::exists(path))) {
@@ -45,8 +357,7 @@ LevelDB::LevelDB(const string& dbName, const string& path,
     return;
   }
 
-  m_options.max_open_files = 256;
-  m_options.create_if_missing = true;
+  ApplyProfile();
 
   leveldb::DB* db;
   leveldb::Status status;
@@ -76,9 +387,9 @@ LevelDB::LevelDB(const std::string& dbName, const std::string& subdirectory,
                  bool diagnostic) {
   this->m_subdirectory = subdirectory;
   this->m_dbName = dbName;
+  this->m_binaryBlockNumKeys = BINARY_BLOCK_NUM_KEY_DBS.count(dbName) > 0;
 
-  m_options.max_open_files = 256;
-  m_options.create_if_missing = true;
+  ApplyProfile();
 
   leveldb::DB* db;
   leveldb::Status status;
@@ -119,6 +430,26 @@ void LevelDB::Reopen() {
   m_db.reset(db);
 }
 
+void LevelDB::FlushMemTable() {
+  // CompactRange always compacts the memtable first. No table file overlaps
+  // the empty key range, so nothing else is rewritten.
+  const leveldb::Slice empty;
+  m_db->CompactRange(&empty, &empty);
+}
+
+uint64_t LevelDB::GetManifestSize() const {
+  std::ifstream current(m_open_db_path + "/CURRENT");
+  string manifest;
+  if (!std::getline(current, manifest) || manifest.empty()) {
+    return 0;
+  }
+
+  std::error_code ec;
+  const auto size =
+      std::filesystem::file_size(m_open_db_path + "/" + manifest, ec);
+  return ec ? 0 : size;
+}
+
 leveldb::Slice toSlice(boost::multiprecision::uint256_t num) {
   dev::FixedHash<32> h;
   dev::zbytesRef ref(h.data(), 32);
@@ -161,8 +492,7 @@ string LevelDB::Lookup(const vector<unsigned char>& key) const {
 
 string LevelDB::Lookup(const boost::multiprecision::uint256_t& blockNum) const {
   string value;
-  leveldb::Status s =
-      m_db->Get(leveldb::ReadOptions(), blockNum.convert_to<string>(), &value);
+  leveldb::Status s = GetBlockNum(blockNum, value);
 
   if (!s.ok()) {
     log_error(s);
@@ -175,8 +505,7 @@ string LevelDB::Lookup(const boost::multiprecision::uint256_t& blockNum) const {
 string LevelDB::Lookup(const boost::multiprecision::uint256_t& blockNum,
                        bool& found) const {
   string value;
-  leveldb::Status s =
-      m_db->Get(leveldb::ReadOptions(), blockNum.convert_to<string>(), &value);
+  leveldb::Status s = GetBlockNum(blockNum, value);
 
   if (!s.ok()) {
     log_error(s);
@@ -242,23 +571,29 @@ int LevelDB::Insert(const vector<unsigned char>& key,
 
 int LevelDB::Insert(const boost::multiprecision::uint256_t& blockNum,
                     const vector<unsigned char>& body) {
-  leveldb::Status s = m_db->Put(
-      leveldb::WriteOptions(), leveldb::Slice(blockNum.convert_to<string>()),
+  return PutBlockNum(
+      blockNum,
       leveldb::Slice(vector_ref<const unsigned char>(&body[0], body.size())));
-
-  if (!s.ok()) {
-    LOG_GENERAL(WARNING, "[Insert] Status: " << s.ToString());
-    return -1;
-  }
-
-  return 0;
 }
 
 int LevelDB::Insert(const boost::multiprecision::uint256_t& blockNum,
                     const std::string& body) {
-  leveldb::Status s = m_db->Put(leveldb::WriteOptions(),
-                                leveldb::Slice(blockNum.convert_to<string>()),
-                                leveldb::Slice(body.c_str(), body.size()));
+  return PutBlockNum(blockNum, leveldb::Slice(body.c_str(), body.size()));
+}
+
+int LevelDB::PutBlockNum(const boost::multiprecision::uint256_t& blockNum,
+                         const leveldb::Slice& value) {
+  leveldb::Status s;
+  if (m_binaryBlockNumKeys) {
+    // Drop a decimal key left from before the migration along with it
+    ldb::WriteBatch batch;
+    batch.Put(BlockNumKey(blockNum.convert_to<uint64_t>()), value);
+    batch.Delete(blockNum.convert_to<string>());
+    s = m_db->Write(leveldb::WriteOptions(), &batch);
+  } else {
+    s = m_db->Put(leveldb::WriteOptions(),
+                  leveldb::Slice(blockNum.convert_to<string>()), value);
+  }
 
   if (!s.ok()) {
     LOG_GENERAL(WARNING, "[Insert] Status: " << s.ToString());
@@ -425,8 +760,12 @@ int LevelDB::DeleteKey(const dev::h256& key) {
 }
 
 int LevelDB::DeleteKey(const boost::multiprecision::uint256_t& blockNum) {
-  leveldb::Status s = m_db->Delete(leveldb::WriteOptions(),
-                                   ldb::Slice(blockNum.convert_to<string>()));
+  ldb::WriteBatch batch;
+  batch.Delete(blockNum.convert_to<string>());
+  if (m_binaryBlockNumKeys) {
+    batch.Delete(BlockNumKey(blockNum.convert_to<uint64_t>()));
+  }
+  leveldb::Status s = m_db->Write(leveldb::WriteOptions(), &batch);
   if (!s.ok()) {
     LOG_GENERAL(WARNING, "[DeleteDB] Status: " << s.ToString());
     return -1;
@@ -476,14 +815,10 @@ bool LevelDB::ResetDB() {
 bool LevelDB::RefreshDB() {
   m_db.reset();
 
-  leveldb::Options options;
-  options.max_open_files = 256;
-  options.create_if_missing = true;
-
   leveldb::DB* db;
 
   leveldb::Status status = leveldb::DB::Open(
-      options, STORAGE_PATH + PERSISTENCE_PATH + "/" + this->m_dbName, &db);
+      m_options, STORAGE_PATH + PERSISTENCE_PATH + "/" + this->m_dbName, &db);
   if (!status.ok()) {
     // throw exception();
     LOG_GENERAL(WARNING, "LevelDB " << m_dbName << " status is not OK - "
@@ -520,14 +855,10 @@ bool LevelDB::ResetDBForNormalNode() {
     std::filesystem::remove_all(STORAGE_PATH + PERSISTENCE_PATH + "/" +
                                 this->m_dbName);
 
-    leveldb::Options options;
-    options.max_open_files = 256;
-    options.create_if_missing = true;
-
     leveldb::DB* db;
 
     leveldb::Status status = leveldb::DB::Open(
-        options, STORAGE_PATH + PERSISTENCE_PATH + "/" + this->m_dbName, &db);
+        m_options, STORAGE_PATH + PERSISTENCE_PATH + "/" + this->m_dbName, &db);
     if (!status.ok()) {
       // throw exception();
       LOG_GENERAL(WARNING, "LevelDB " << m_dbName << " status is not OK - "
@@ -559,14 +890,10 @@ bool LevelDB::ResetDBForLookupNode() {
     std::filesystem::remove_all(STORAGE_PATH + PERSISTENCE_PATH + "/" +
                                 this->m_dbName);
 
-    leveldb::Options options;
-    options.max_open_files = 256;
-    options.create_if_missing = true;
-
     leveldb::DB* db;
 
     leveldb::Status status = leveldb::DB::Open(
-        options, STORAGE_PATH + PERSISTENCE_PATH + "/" + this->m_dbName, &db);
+        m_options, STORAGE_PATH + PERSISTENCE_PATH + "/" + this->m_dbName, &db);
     if (!status.ok()) {
       // throw exception();
       LOG_GENERAL(WARNING, "LevelDB " << m_dbName << " status is not OK - "
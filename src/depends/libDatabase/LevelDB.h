@@ -19,11 +19,13 @@
 #ifndef __LEVELDB_H__
 #define __LEVELDB_H__
 
+#include <atomic>
 #include <memory>
 #include <string>
 #include <unordered_map>
 #include <vector>
 
+#include <leveldb/cache.h>
 #include <leveldb/db.h>
 
 #include "depends/common/Common.h"
@@ -32,6 +34,24 @@
 
 leveldb::Slice toSlice(boost::multiprecision::uint256_t num);
 
+/// Tuning profile of a database, selected by name from constants.xml
+enum class LevelDBProfile
+{
+    /// Default options
+    DEFAULT,
+    /// Random point reads by hash, uses a bloom filter
+    POINT_LOOKUP,
+    /// Mostly sequential writes by block number, uses a larger write buffer
+    SEQUENTIAL_WRITE
+};
+
+/// Block cache lookups of a database in the shared block cache
+struct LevelDBCacheStats
+{
+    std::atomic<uint64_t> hits{0};
+    std::atomic<uint64_t> misses{0};
+};
+
 /// Utility class for providing database-type storage.
 class LevelDB
 {
@@ -39,14 +59,32 @@ class LevelDB
 
     std::string m_subdirectory;
 
+    /// Must outlive m_db
+    std::shared_ptr<LevelDBCacheStats> m_cacheStats;
+    std::shared_ptr<leveldb::Cache> m_blockCache;
+
     std::shared_ptr<leveldb::DB> m_db;
 
     leveldb::Options m_options;
 
     std::string m_open_db_path;
 
+    /// Block numbers are stored as fixed-width big-endian keys
+    bool m_binaryBlockNumKeys = false;
+
     void log_error(leveldb::Status status) const;
 
+    /// Reads a block number key in either encoding, binary first
+    leveldb::Status GetBlockNum(const boost::multiprecision::uint256_t & blockNum,
+                                std::string & value) const;
+
+    /// Writes a block number key in the encoding used by this db
+    int PutBlockNum(const boost::multiprecision::uint256_t & blockNum,
+                    const leveldb::Slice & value);
+
+    /// Sets m_options according to the profile of the database
+    void ApplyProfile();
+
 public:
 
     /// Constructor.
@@ -60,9 +98,37 @@ public:
         m_db->CompactRange(NULL, NULL);
     }
 
+    /// Returns the tuning profile configured for the database name
+    static LevelDBProfile GetProfile(const std::string& dbName);
+
+    /// Returns the fixed-width big-endian key of a block number, which sorts
+    /// before any decimal key and in numeric order with other binary keys
+    static std::string BlockNumKey(uint64_t blockNum);
+
+    /// Parses a block number key in either the binary or the decimal encoding
+    static bool ParseBlockNumKey(const leveldb::Slice & key, uint64_t & blockNum);
+
+    /// Returns true if block numbers are written as binary keys in this db
+    bool HasBinaryBlockNumKeys() const { return m_binaryBlockNumKeys; }
+
+    /// Finds the highest block number key, seeking to the tail of the binary
+    /// keys and scanning only the decimal keys that are not migrated yet
+    bool GetLastBlockNum(uint64_t & blockNum) const;
+
+    /// Rewrites up to maxKeys decimal block number keys as binary keys, each
+    /// batch atomically, and returns the number of keys migrated
+    uint64_t MigrateBlockNumKeys(uint64_t maxKeys, unsigned int batchSize = 1000);
+
     /// Reopen the leveldb object to trigger compact and cleaning of LOG/MANIFEST files
     void Reopen();
 
+    /// Writes the memtable into a table file so that the write-ahead log is
+    /// dropped, while keeping the db open along with its table and block caches
+    void FlushMemTable();
+
+    /// Size in bytes of the current MANIFEST file, which is only rewritten on open
+    uint64_t GetManifestSize() const;
+
     /// Returns the reference to the leveldb database instance.
     std::shared_ptr<leveldb::DB> GetDB();
 
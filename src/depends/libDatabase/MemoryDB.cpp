@@ -105,12 +105,16 @@ namespace dev
     bool MemoryDB::kill(h256 const& _h)
     {
 // #if DEV_GUARDED_DB
-        // ReadGuard l(x_this);
-        shared_lock<shared_timed_mutex> lock(x_this);
+        // Writes the reference count, so it must exclude concurrent readers.
+        unique_lock<shared_timed_mutex> lock(x_this);
 // #endif
-        if (m_main->count(_h))
+        auto it = m_main->find(_h);
+        if (it != m_main->end())
         {
-            (*m_main)[_h].second = 0;
+            // Drop one reference only; the node stays live while another
+            // path in the trie still points at it.
+            if (it->second.second > 0)
+                it->second.second--;
             return true;
         } else {
             //m_main[_h] = {"", 0};
@@ -28,17 +28,32 @@ namespace dev
 {
 	h256 const EmptyTrie = sha3(rlp(""));
 
+	constexpr uint64_t MANIFEST_REOPEN_THRESHOLD = 64 * 1024 * 1024;
+
 	void OverlayDB::ResetDB()
 	{
 		m_levelDB.ResetDB();
 		clear();
+		if (m_nodeCache)
+			m_nodeCache->Clear();
 	}
 
 	bool OverlayDB::RefreshDB()
 	{
+		if (m_nodeCache)
+			m_nodeCache->Clear();
 		return m_levelDB.RefreshDB();
 	}
 
+	void OverlayDB::deleteNodes(std::vector<h256> const& _hashes)
+	{
+		// Erased once gone from disk, so that a concurrent lookup can't cache
+		// them again after the erase
+		m_levelDB.BatchDelete(_hashes);
+		if (m_nodeCache)
+			m_nodeCache->Erase(_hashes);
+	}
+
 	bool OverlayDB::commit(bool keepHistory, std::vector<h256>& toPurge, unordered_set<h256>& inserted)
 	{
 	// #if DEV_GUARDED_DB
@@ -50,7 +65,7 @@ namespace dev
 			/// delete removed nodes in both mem and disk
 			purge(toPurge, false);
 			if (!keepHistory) {
-				m_levelDB.BatchDelete(toPurge);
+				deleteNodes(toPurge);
 			}
 
 			/// add newly created nodes in disk
@@ -58,8 +73,13 @@ namespace dev
 				LOG_GENERAL(WARNING, "BatchInsert failed");
 				return false;
 			}
-			/// clean temp files in leveldb
-			m_levelDB.Reopen();
+			/// drop the write-ahead log without losing the caches of the db
+			m_levelDB.FlushMemTable();
+			/// the MANIFEST only shrinks on open, reopen once it has grown large
+			if (m_levelDB.GetManifestSize() > MANIFEST_REOPEN_THRESHOLD) {
+				LOG_GENERAL(INFO, "Reopen " << m_levelDB.GetDBName() << " to rewrite its MANIFEST");
+				m_levelDB.Reopen();
+			}
 		}
 			
 	// #if DEV_GUARDED_DB
@@ -109,10 +129,21 @@ namespace dev
 	std::string OverlayDB::lookup(h256 const& _h) const
 	{
 		std::string ret = MemoryDB::lookup(_h);
-	
-		if (ret.empty())
-			ret = m_levelDB.Lookup(_h);
-	
+
+		if (!ret.empty())
+			return ret;
+
+		if (!m_nodeCache)
+			return m_levelDB.Lookup(_h);
+
+		if (m_nodeCache->Get(_h, ret))
+			return ret;
+
+		const uint64_t eraseEpoch = m_nodeCache->GetEraseEpoch(_h);
+		ret = m_levelDB.Lookup(_h);
+		if (!ret.empty())
+			m_nodeCache->Put(_h, ret, eraseEpoch);
+
 		return ret;
 	}
 
@@ -121,6 +152,10 @@ namespace dev
 		if (MemoryDB::exists(_h))
 			return true;
 
+		std::string ret;
+		if (m_nodeCache && m_nodeCache->Get(_h, ret))
+			return true;
+
 		return m_levelDB.Exists(_h);
 	}
 
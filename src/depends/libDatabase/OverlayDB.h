@@ -26,6 +26,7 @@
 #include "depends/common/RLP.h"
 #include "LevelDB.h"
 #include "MemoryDB.h"
+#include "TrieNodeCache.h"
 
 namespace dev
 {
@@ -36,7 +37,12 @@ namespace dev
 	class OverlayDB: public MemoryDB
 	{
 	public:
-		explicit OverlayDB(const std::string & dbName): m_levelDB(dbName) {}
+		/// nodeCacheBytes > 0 keeps the nodes read from disk in a TrieNodeCache
+		explicit OverlayDB(const std::string & dbName, size_t nodeCacheBytes = 0): m_levelDB(dbName)
+		{
+			if (nodeCacheBytes > 0)
+				m_nodeCache = std::make_unique<TrieNodeCache>(dbName, nodeCacheBytes);
+		}
 		~OverlayDB() = default;
 
 		void ResetDB();
@@ -54,7 +60,13 @@ namespace dev
 	protected:
 		// using MemoryDB::clear;
 
+		/// Deletes nodes from disk and from the node cache
+		void deleteNodes(std::vector<h256> const& _hashes);
+
 		LevelDB m_levelDB;
+
+		/// Retained across commits, nodes are only erased once deleted from disk
+		std::unique_ptr<TrieNodeCache> m_nodeCache;
 	};
 }
 
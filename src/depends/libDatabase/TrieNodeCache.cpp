@@ -0,0 +1,119 @@
+/*
+ * Copyright (C) 2023 Zilliqa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "TrieNodeCache.h"
+
+namespace dev {
+
+TrieNodeCache::TrieNodeCache(const std::string& dbName, size_t capacityBytes)
+    : m_dbName(dbName), m_shardCapacityBytes(capacityBytes / NUM_SHARDS) {
+  m_stats.SetCallback([this](auto&& result) {
+    if (!m_stats.Enabled()) {
+      return;
+    }
+    size_t entries = 0;
+    size_t sizeBytes = 0;
+    for (auto& shard : m_shards) {
+      std::lock_guard<std::mutex> g(shard.m_mutex);
+      entries += shard.m_lru.size();
+      sizeBytes += shard.m_sizeBytes;
+    }
+    result.Set(m_hits.load(), {{"db", m_dbName}, {"counter", "Hits"}});
+    result.Set(m_misses.load(), {{"db", m_dbName}, {"counter", "Misses"}});
+    result.Set(entries, {{"db", m_dbName}, {"counter", "Entries"}});
+    result.Set(sizeBytes, {{"db", m_dbName}, {"counter", "SizeBytes"}});
+  });
+}
+
+bool TrieNodeCache::Get(const h256& hash, std::string& value) {
+  auto& shard = GetShard(hash);
+  {
+    std::lock_guard<std::mutex> g(shard.m_mutex);
+    auto it = shard.m_index.find(hash);
+    if (it != shard.m_index.end()) {
+      shard.m_lru.splice(shard.m_lru.begin(), shard.m_lru, it->second);
+      value = it->second->second;
+      m_hits.fetch_add(1, std::memory_order_relaxed);
+      return true;
+    }
+  }
+  m_misses.fetch_add(1, std::memory_order_relaxed);
+  return false;
+}
+
+uint64_t TrieNodeCache::GetEraseEpoch(const h256& hash) {
+  auto& shard = GetShard(hash);
+  std::lock_guard<std::mutex> g(shard.m_mutex);
+  return shard.m_eraseEpoch;
+}
+
+void TrieNodeCache::Put(const h256& hash, const std::string& value,
+                        uint64_t eraseEpoch) {
+  const size_t sizeBytes = EntrySize(value);
+  if (value.empty() || sizeBytes > m_shardCapacityBytes) {
+    return;
+  }
+
+  auto& shard = GetShard(hash);
+  std::lock_guard<std::mutex> g(shard.m_mutex);
+  if (shard.m_eraseEpoch != eraseEpoch ||
+      shard.m_index.find(hash) != shard.m_index.end()) {
+    return;
+  }
+
+  shard.m_lru.emplace_front(hash, value);
+  shard.m_index.emplace(hash, shard.m_lru.begin());
+  shard.m_sizeBytes += sizeBytes;
+
+  while (shard.m_sizeBytes > m_shardCapacityBytes) {
+    const auto& victim = shard.m_lru.back();
+    shard.m_sizeBytes -= EntrySize(victim.second);
+    shard.m_index.erase(victim.first);
+    shard.m_lru.pop_back();
+  }
+}
+
+void TrieNodeCache::Erase(const h256& hash) {
+  auto& shard = GetShard(hash);
+  std::lock_guard<std::mutex> g(shard.m_mutex);
+  shard.m_eraseEpoch++;
+  auto it = shard.m_index.find(hash);
+  if (it == shard.m_index.end()) {
+    return;
+  }
+  shard.m_sizeBytes -= EntrySize(it->second->second);
+  shard.m_lru.erase(it->second);
+  shard.m_index.erase(it);
+}
+
+void TrieNodeCache::Erase(const std::vector<h256>& hashes) {
+  for (const auto& hash : hashes) {
+    Erase(hash);
+  }
+}
+
+void TrieNodeCache::Clear() {
+  for (auto& shard : m_shards) {
+    std::lock_guard<std::mutex> g(shard.m_mutex);
+    shard.m_lru.clear();
+    shard.m_index.clear();
+    shard.m_sizeBytes = 0;
+    shard.m_eraseEpoch++;
+  }
+}
+
+}  // namespace dev
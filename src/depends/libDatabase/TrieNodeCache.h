@@ -0,0 +1,97 @@
+/*
+ * Copyright (C) 2023 Zilliqa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef __TRIENODECACHE_H__
+#define __TRIENODECACHE_H__
+
+#include <array>
+#include <atomic>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "depends/common/FixedHash.h"
+#include "libMetrics/Api.h"
+
+namespace dev {
+
+/// Size-bounded LRU cache of trie nodes read from disk, keyed by node hash.
+/// Nodes are content-addressed so an entry never goes stale, it only has to
+/// be erased when the node is deleted from disk. The cache is split into
+/// shards with their own lock so that concurrent readers rarely contend.
+///
+/// Every erase advances the erase epoch of its shard. A reader takes the
+/// epoch before reading a node from disk and passes it to Put, which drops
+/// the node if it was erased meanwhile, so a node read just before it was
+/// deleted from disk isn't cached again.
+class TrieNodeCache {
+ public:
+  TrieNodeCache(const std::string& dbName, size_t capacityBytes);
+
+  /// Copies the cached node into value, returns false on a miss
+  bool Get(const h256& hash, std::string& value);
+
+  uint64_t GetEraseEpoch(const h256& hash);
+
+  /// Caches the node unless its shard had an erase since eraseEpoch
+  void Put(const h256& hash, const std::string& value, uint64_t eraseEpoch);
+
+  void Erase(const h256& hash);
+  void Erase(const std::vector<h256>& hashes);
+
+  void Clear();
+
+  uint64_t GetHits() const { return m_hits; }
+  uint64_t GetMisses() const { return m_misses; }
+
+ private:
+  static constexpr size_t NUM_SHARDS = 16;
+
+  struct Shard {
+    using LruList = std::list<std::pair<h256, std::string>>;
+
+    std::mutex m_mutex;
+    LruList m_lru;
+    std::unordered_map<h256, LruList::iterator> m_index;
+    size_t m_sizeBytes = 0;
+    uint64_t m_eraseEpoch = 0;
+  };
+
+  Shard& GetShard(const h256& hash) {
+    return m_shards[hash[0] % NUM_SHARDS];
+  }
+
+  static size_t EntrySize(const std::string& value) {
+    return h256::size + value.size();
+  }
+
+  const std::string m_dbName;
+  const size_t m_shardCapacityBytes;
+  std::array<Shard, NUM_SHARDS> m_shards;
+
+  std::atomic<uint64_t> m_hits{0};
+  std::atomic<uint64_t> m_misses{0};
+
+  Z_I64GAUGE m_stats{Z_FL::DATABASE, "trie.node_cache.stats",
+                     "Trie node cache statistics", "units", true};
+};
+
+}  // namespace dev
+
+#endif  // __TRIENODECACHE_H__
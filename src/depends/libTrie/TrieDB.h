@@ -19,8 +19,14 @@
 #ifndef __TRIEDB_H__
 #define __TRIEDB_H__
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <future>
 #include <map>
 #include <memory>
+#include <thread>
+#include <vector>
 
 #include "TrieCommon.h"
 #include "libUtils/Logger.h"
@@ -128,6 +134,15 @@ class GenericTrieDB {
 
   void insert(zbytesConstRef _key, zbytesConstRef _value);
 
+  /// Inserts all the key/value pairs and yields the same root as inserting
+  /// them one by one in the given order. The pairs are sorted by key so that
+  /// the upper branch nodes are rewritten only once and the disjoint subtries
+  /// below them are updated concurrently on up to _maxThreads threads (0
+  /// means one per hardware thread). Below that split depth the keys are
+  /// still merged one at a time, so those nodes are rewritten per key.
+  void insertBatch(std::vector<std::pair<zbytes, zbytes>> const& _kvs,
+                   unsigned _maxThreads = 0);
+
   void remove(zbytes const& _key) { remove(&_key); }
   void remove(zbytesConstRef _key);
 
@@ -279,6 +294,20 @@ class GenericTrieDB {
   zbytes mergeAt(RLP const& _replace, h256 const& _replaceHash, NibbleSlice _k,
                  zbytesConstRef _v, bool _inLine = false);
 
+  using BatchIter =
+      typename std::vector<std::pair<zbytes, zbytes> const*>::const_iterator;
+
+  // Subtries are only handed to another thread below this depth and when
+  // they hold enough keys to be worth the thread.
+  static constexpr unsigned c_maxParallelDepth = 3;
+  static constexpr size_t c_minParallelBatch = 64;
+
+  zbytes mergeBatchAt(RLP const& _orig, h256 const& _origHash, bool _inLine,
+                      BatchIter _begin, BatchIter _end, unsigned _offset,
+                      std::atomic<int>& _freeThreads);
+  zbytes mergeBatchAtAux(RLP const& _orig, BatchIter _begin, BatchIter _end,
+                         unsigned _offset, std::atomic<int>& _freeThreads);
+
   bool deleteAtAux(RLPStream& _out, RLP const& _replace, NibbleSlice _key);
   zbytes deleteAt(RLP const& _replace, NibbleSlice _k);
 
@@ -841,6 +870,132 @@ void GenericTrieDB<DB>::insert(zbytesConstRef _key, zbytesConstRef _value) {
   m_root = forceInsertNode(&b);
 }
 
+template <class DB>
+void GenericTrieDB<DB>::insertBatch(
+    std::vector<std::pair<zbytes, zbytes>> const& _kvs, unsigned _maxThreads) {
+  if (_kvs.empty()) return;
+
+  // Stable so that a repeated key keeps its last value, as with insert().
+  std::vector<std::pair<zbytes, zbytes> const*> sorted;
+  sorted.reserve(_kvs.size());
+  for (auto const& kv : _kvs) sorted.push_back(&kv);
+  std::stable_sort(sorted.begin(), sorted.end(),
+                   [](auto const* _a, auto const* _b) {
+                     return _a->first < _b->first;
+                   });
+
+  if (_maxThreads == 0) _maxThreads = std::thread::hardware_concurrency();
+  // The calling thread does work too.
+  std::atomic<int> freeThreads{static_cast<int>(_maxThreads) - 1};
+
+  std::string rootValue = node(m_root);
+
+  ZIL_FATAL_ASSERT(!rootValue.empty());
+
+  zbytes b = mergeBatchAt(RLP(rootValue), m_root, false, sorted.begin(),
+                          sorted.end(), 0, freeThreads);
+
+  // See insert().
+  if (rootValue.size() < 32) forceKillNode(m_root);
+  m_root = forceInsertNode(&b);
+}
+
+template <class DB>
+zbytes GenericTrieDB<DB>::mergeBatchAt(RLP const& _orig,
+                                       h256 const& _origHash, bool _inLine,
+                                       BatchIter _begin, BatchIter _end,
+                                       unsigned _offset,
+                                       std::atomic<int>& _freeThreads) {
+  auto keyAt = [_offset](auto const* _kv) {
+    return NibbleSlice(&_kv->first).mid(_offset);
+  };
+
+  bool split = _orig.isList() && _orig.itemCount() == 17 &&
+               _offset < c_maxParallelDepth &&
+               static_cast<size_t>(_end - _begin) >= c_minParallelBatch;
+  for (auto it = _begin; split && it != _end; ++it)
+    split = keyAt(*it).size() > 0;
+
+  if (!split) {
+    // Merge the keys one after the other into the node. Only the original
+    // node is in the DB, the intermediate ones exist only in this loop.
+    zbytes cur = _orig.data().toBytes();
+    bool inLine = _inLine;
+    for (auto it = _begin; it != _end; ++it) {
+      cur = mergeAt(RLP(cur), _origHash, keyAt(*it), &(*it)->second, inLine);
+      inLine = true;
+    }
+    return cur;
+  }
+
+  if (!_inLine) killNode(_orig, _origHash);
+
+  // Keys are sorted, so the ones below each child are contiguous.
+  std::array<zbytes, 16> children;
+  std::array<bool, 16> touched{};
+  std::vector<std::future<void>> tasks;
+  for (auto it = _begin; it != _end;) {
+    zbyte n = keyAt(*it)[0];
+    auto next = it;
+    while (next != _end && keyAt(*next)[0] == n) ++next;
+
+    touched[n] = true;
+    auto work = [this, &_orig, &children, &_freeThreads, n, it, next,
+                 _offset]() {
+      children[n] = mergeBatchAtAux(_orig[n], it, next, _offset + 1,
+                                    _freeThreads);
+    };
+    bool spawn = static_cast<size_t>(next - it) >= c_minParallelBatch;
+    if (spawn && _freeThreads.fetch_sub(1) <= 0) {
+      _freeThreads.fetch_add(1);
+      spawn = false;
+    }
+    if (spawn) {
+      tasks.push_back(std::async(std::launch::async, [work, &_freeThreads]() {
+        work();
+        _freeThreads.fetch_add(1);
+      }));
+    } else {
+      work();
+    }
+    it = next;
+  }
+  for (auto& task : tasks) task.get();
+
+  RLPStream r(17);
+  for (zbyte i = 0; i < 17; ++i)
+    if (i < 16 && touched[i])
+      r.appendRaw(children[i]);
+    else
+      r.append(_orig[i]);
+  return r.out();
+}
+
+template <class DB>
+zbytes GenericTrieDB<DB>::mergeBatchAtAux(RLP const& _orig, BatchIter _begin,
+                                          BatchIter _end, unsigned _offset,
+                                          std::atomic<int>& _freeThreads) {
+  // As mergeAtAux(), but returns the streamed child reference.
+  RLP r = _orig;
+  std::string s;
+  h256 h;
+  bool isRemovable = false;
+  if (!r.isList() && !r.isEmpty()) {
+    h = _orig.toHash<h256>();
+    s = node(h);
+    r = RLP(s);
+
+    ZIL_FATAL_ASSERT(!r.isNull());
+
+    isRemovable = true;
+  }
+  zbytes b = mergeBatchAt(r, h, !isRemovable, _begin, _end, _offset,
+                          _freeThreads);
+  RLPStream out;
+  streamNode(out, b);
+  return out.out();
+}
+
 template <class DB>
 std::string GenericTrieDB<DB>::at(zbytesConstRef _key) const {
   return atAux(RLP(node(m_root)), _key);
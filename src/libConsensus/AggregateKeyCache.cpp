@@ -0,0 +1,192 @@
+/*
+ * Copyright (C) 2023 Zilliqa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "AggregateKeyCache.h"
+
+#include <algorithm>
+
+#include <MultiSig.h>
+#include "common/Constants.h"
+#include "libCrypto/Sha2.h"
+#include "libUtils/Logger.h"
+
+using namespace std;
+
+namespace {
+
+// Prefixes of a compressed point with an even and an odd y coordinate
+constexpr uint8_t EVEN_Y_PREFIX = 0x02;
+constexpr uint8_t ODD_Y_PREFIX = 0x03;
+
+}  // namespace
+
+AggregateKeyCache& AggregateKeyCache::GetInstance() {
+  static AggregateKeyCache cache;
+  return cache;
+}
+
+AggregateKeyCache::AggregateKeyCache() {
+  m_stats.SetCallback([this](auto&& result) {
+    if (!m_stats.Enabled()) {
+      return;
+    }
+    size_t entries = 0;
+    {
+      lock_guard<mutex> g(m_mutex);
+      for (const auto& committee : m_committees) {
+        entries += committee.m_bitmapKeys.size();
+      }
+    }
+    result.Set(m_hits.load(), {{"counter", "Hits"}});
+    result.Set(m_misses.load(), {{"counter", "Misses"}});
+    result.Set(entries, {{"counter", "Entries"}});
+  });
+}
+
+shared_ptr<const PubKey> AggregateKeyCache::GetAggregatedKey(
+    const vector<const PubKey*>& committee, const vector<bool>& bitmap) {
+  if (committee.empty() || committee.size() != bitmap.size()) {
+    LOG_GENERAL(WARNING, "Committee size " << committee.size()
+                                           << " != bitmap size "
+                                           << bitmap.size());
+    return nullptr;
+  }
+
+  const auto numPresent = count(bitmap.begin(), bitmap.end(), true);
+  if (numPresent == 0) {
+    return nullptr;
+  }
+
+  const zbytes committeeHash = HashCommittee(committee);
+  shared_ptr<const PubKey> aggregatedKey;
+  {
+    lock_guard<mutex> g(m_mutex);
+    auto it = find_if(m_committees.begin(), m_committees.end(),
+                      [&committeeHash](const CommitteeKeys& keys) {
+                        return keys.m_committeeHash == committeeHash;
+                      });
+    if (it != m_committees.end()) {
+      m_committees.splice(m_committees.begin(), m_committees, it);
+      auto keyIt = it->m_bitmapKeys.find(bitmap);
+      if (keyIt != it->m_bitmapKeys.end()) {
+        m_hits.fetch_add(1, memory_order_relaxed);
+        return keyIt->second;
+      }
+      aggregatedKey = it->m_aggregatedKey;
+    }
+  }
+  m_misses.fetch_add(1, memory_order_relaxed);
+
+  // The curve arithmetic is done without holding the lock
+  shared_ptr<const PubKey> key;
+  const auto numAbsent = bitmap.size() - numPresent;
+  if (!aggregatedKey) {
+    // First bitmap seen for this committee, e.g. while syncing blocks signed
+    // by successive committees. Aggregating the absent keys separately makes
+    // the full aggregate cost a single extra addition.
+    key = Aggregate(committee, bitmap, true);
+    if (!key) {
+      return nullptr;
+    }
+    if (numAbsent == 0) {
+      aggregatedKey = key;
+    } else if (auto absentKey = Aggregate(committee, bitmap, false)) {
+      aggregatedKey = MultiSig::AggregatePubKeys({*key, *absentKey});
+    }
+    if (!aggregatedKey) {
+      return key;
+    }
+  } else if (numAbsent == 0) {
+    key = aggregatedKey;
+  } else if (numAbsent < static_cast<size_t>(numPresent)) {
+    if (auto absentKey = Aggregate(committee, bitmap, false)) {
+      key = Subtract(*aggregatedKey, *absentKey);
+    }
+  }
+  if (!key) {
+    key = Aggregate(committee, bitmap, true);
+    if (!key) {
+      return nullptr;
+    }
+  }
+
+  lock_guard<mutex> g(m_mutex);
+  auto it = find_if(m_committees.begin(), m_committees.end(),
+                    [&committeeHash](const CommitteeKeys& keys) {
+                      return keys.m_committeeHash == committeeHash;
+                    });
+  if (it == m_committees.end()) {
+    m_committees.push_front({committeeHash, aggregatedKey, {}});
+    if (m_committees.size() > MAX_COMMITTEES) {
+      m_committees.pop_back();
+    }
+    it = m_committees.begin();
+  }
+  if (it->m_bitmapKeys.size() >= MAX_BITMAPS_PER_COMMITTEE) {
+    it->m_bitmapKeys.clear();
+  }
+  it->m_bitmapKeys.emplace(bitmap, key);
+  return key;
+}
+
+void AggregateKeyCache::Clear() {
+  lock_guard<mutex> g(m_mutex);
+  m_committees.clear();
+}
+
+zbytes AggregateKeyCache::HashCommittee(
+    const vector<const PubKey*>& committee) {
+  zbytes serialized;
+  serialized.reserve(committee.size() * PUB_KEY_SIZE);
+  for (const auto& key : committee) {
+    key->Serialize(serialized, serialized.size());
+  }
+
+  return SHA256Calculator::FromBytes(serialized);
+}
+
+shared_ptr<const PubKey> AggregateKeyCache::Aggregate(
+    const vector<const PubKey*>& committee, const vector<bool>& bitmap,
+    bool present) {
+  vector<PubKey> keys;
+  for (size_t i = 0; i < committee.size(); i++) {
+    if (bitmap[i] == present) {
+      keys.emplace_back(*committee[i]);
+    }
+  }
+  return MultiSig::AggregatePubKeys(keys);
+}
+
+shared_ptr<const PubKey> AggregateKeyCache::Subtract(
+    const PubKey& minuend, const PubKey& subtrahend) {
+  // The negation of a point only differs in the parity of its y coordinate,
+  // which a compressed point encodes in its prefix
+  zbytes negated;
+  subtrahend.Serialize(negated, 0);
+  if (negated.size() != PUB_KEY_SIZE ||
+      (negated[0] != EVEN_Y_PREFIX && negated[0] != ODD_Y_PREFIX)) {
+    return nullptr;
+  }
+  negated[0] = (negated[0] == EVEN_Y_PREFIX) ? ODD_Y_PREFIX : EVEN_Y_PREFIX;
+
+  try {
+    return MultiSig::AggregatePubKeys({minuend, PubKey(negated, 0)});
+  } catch (const exception& e) {
+    LOG_GENERAL(WARNING, "Failed to negate aggregated key: " << e.what());
+    return nullptr;
+  }
+}
@@ -0,0 +1,92 @@
+/*
+ * Copyright (C) 2023 Zilliqa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef ZILLIQA_SRC_LIBCONSENSUS_AGGREGATEKEYCACHE_H_
+#define ZILLIQA_SRC_LIBCONSENSUS_AGGREGATEKEYCACHE_H_
+
+#include <atomic>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <tuple>
+#include <vector>
+
+#include <Schnorr.h>
+#include "common/BaseType.h"
+#include "libMetrics/Api.h"
+
+/// Caches the aggregated public keys used to verify co-signatures, by
+/// committee and co-signature bitmap. The aggregate of the whole committee
+/// is computed once per committee, and the key of a bitmap is derived from
+/// it by subtracting the members absent from the bitmap, which are the
+/// minority in a valid co-signature.
+class AggregateKeyCache {
+ public:
+  static AggregateKeyCache& GetInstance();
+
+  /// Returns the aggregate of the keys of the committee members set in the
+  /// bitmap, nullptr if it can't be computed. The committee is a container
+  /// of PairOfNode or ShardMember.
+  template <class Container>
+  std::shared_ptr<const PubKey> GetAggregatedKey(
+      const Container& committee, const std::vector<bool>& bitmap) {
+    std::vector<const PubKey*> keys;
+    keys.reserve(committee.size());
+    for (const auto& member : committee) {
+      keys.emplace_back(&std::get<PubKey>(member));
+    }
+    return GetAggregatedKey(keys, bitmap);
+  }
+
+  std::shared_ptr<const PubKey> GetAggregatedKey(
+      const std::vector<const PubKey*>& committee,
+      const std::vector<bool>& bitmap);
+
+  void Clear();
+
+ private:
+  AggregateKeyCache();
+
+  static constexpr size_t MAX_COMMITTEES = 4;
+  static constexpr size_t MAX_BITMAPS_PER_COMMITTEE = 1024;
+
+  struct CommitteeKeys {
+    zbytes m_committeeHash;
+    std::shared_ptr<const PubKey> m_aggregatedKey;
+    std::map<std::vector<bool>, std::shared_ptr<const PubKey>> m_bitmapKeys;
+  };
+
+  static zbytes HashCommittee(const std::vector<const PubKey*>& committee);
+  static std::shared_ptr<const PubKey> Aggregate(
+      const std::vector<const PubKey*>& committee,
+      const std::vector<bool>& bitmap, bool present);
+  static std::shared_ptr<const PubKey> Subtract(const PubKey& minuend,
+                                                const PubKey& subtrahend);
+
+  std::mutex m_mutex;
+  // Most recently used committee first
+  std::list<CommitteeKeys> m_committees;
+
+  std::atomic<uint64_t> m_hits{0};
+  std::atomic<uint64_t> m_misses{0};
+
+  Z_I64GAUGE m_stats{Z_FL::BLOCKS, "consensus.aggregate_key_cache.stats",
+                     "Aggregated public key cache statistics", "calls", true};
+};
+
+#endif  // ZILLIQA_SRC_LIBCONSENSUS_AGGREGATEKEYCACHE_H_
@@ -22,6 +22,8 @@
 #include "common/Messages.h"
 #include "libMessage/Messenger.h"
 #include "libMetrics/Api.h"
+#include "libMetrics/EpochTimeline.h"
+#include "libMetrics/ScopedTimer.h"
 #include "libMetrics/TracedIds.h"
 #include "libNetwork/P2P.h"
 #include "libUtils/BitVector.h"
@@ -180,6 +182,7 @@ bool ConsensusBackup::ProcessMessageAnnounce(const zbytes& announcement,
     // =====================
     m_state = COMMIT_DONE;
     zil::local::variables.SetConsensusState(int(m_state));
+    EpochTimeline::GetInstance().Begin(EpochPhase::CONSENSUS_ROUND_1);
 
     // Unicast to the leader
     // =====================
@@ -228,7 +231,7 @@ bool ConsensusBackup::GenerateCommitFailureMessage(zbytes& commitFailure,
 
 bool ConsensusBackup::GenerateCommitMessage(zbytes& commit,
                                             unsigned int offset) {
-  LOG_MARKER();
+  SCOPED_TIMER();
 
   // Generate new commit
   // ===================
@@ -262,7 +265,7 @@ bool ConsensusBackup::ProcessMessageChallengeCore(
     const zbytes& challenge, unsigned int offset, Action action,
     ConsensusMessageType returnmsgtype, State nextstate,
     std::string_view spanName) {
-  LOG_MARKER();
+  SCOPED_TIMER();
 
   // Initial checks
   // ==============
@@ -362,7 +365,7 @@ bool ConsensusBackup::ProcessMessageChallengeCore(
 
 bool ConsensusBackup::ProcessMessageChallenge(const zbytes& challenge,
                                               unsigned int offset) {
-  LOG_MARKER();
+  SCOPED_TIMER();
   return ProcessMessageChallengeCore(challenge, offset, PROCESS_CHALLENGE,
                                      RESPONSE, RESPONSE_DONE, "Challenge");
 }
@@ -370,7 +373,7 @@ bool ConsensusBackup::ProcessMessageChallenge(const zbytes& challenge,
 bool ConsensusBackup::GenerateResponseMessage(
     zbytes& response, unsigned int offset,
     const vector<ResponseSubsetInfo>& subsetInfo) {
-  LOG_MARKER();
+  SCOPED_TIMER();
 
   // Assemble response message body
   // ==============================
@@ -389,7 +392,7 @@ bool ConsensusBackup::GenerateResponseMessage(
 bool ConsensusBackup::ProcessMessageCollectiveSigCore(
     const zbytes& collectivesig, unsigned int offset, Action action,
     State nextstate, std::string_view spanName) {
-  LOG_MARKER();
+  SCOPED_TIMER();
 
   // Initial checks
   // ==============
@@ -472,6 +475,8 @@ bool ConsensusBackup::ProcessMessageCollectiveSigCore(
 
       m_state = nextstate;
       zil::local::variables.SetConsensusState(int(m_state));
+      EpochTimeline::GetInstance().End(EpochPhase::CONSENSUS_ROUND_1);
+      EpochTimeline::GetInstance().Begin(EpochPhase::CONSENSUS_ROUND_2);
 
       // Save the collective sig over the first round
       m_CS1 = m_collectiveSig;
@@ -495,6 +500,7 @@ bool ConsensusBackup::ProcessMessageCollectiveSigCore(
 
     m_state = nextstate;
     zil::local::variables.SetConsensusState(int(m_state));
+    EpochTimeline::GetInstance().End(EpochPhase::CONSENSUS_ROUND_2);
   }
 
   return result;
@@ -502,7 +508,7 @@ bool ConsensusBackup::ProcessMessageCollectiveSigCore(
 
 bool ConsensusBackup::ProcessMessageCollectiveSig(const zbytes& collectivesig,
                                                   unsigned int offset) {
-  LOG_MARKER();
+  SCOPED_TIMER();
   bool collectiveSigResult = ProcessMessageCollectiveSigCore(
       collectivesig, offset, PROCESS_COLLECTIVESIG, FINALCOMMIT_DONE,
       "CollectiveSig");
@@ -511,7 +517,7 @@ bool ConsensusBackup::ProcessMessageCollectiveSig(const zbytes& collectivesig,
 
 bool ConsensusBackup::ProcessMessageFinalChallenge(const zbytes& challenge,
                                                    unsigned int offset) {
-  LOG_MARKER();
+  SCOPED_TIMER();
   return ProcessMessageChallengeCore(challenge, offset, PROCESS_FINALCHALLENGE,
                                      FINALRESPONSE, FINALRESPONSE_DONE,
                                      "FinalChallenge");
@@ -519,7 +525,7 @@ bool ConsensusBackup::ProcessMessageFinalChallenge(const zbytes& challenge,
 
 bool ConsensusBackup::ProcessMessageFinalCollectiveSig(
     const zbytes& finalcollectivesig, unsigned int offset) {
-  LOG_MARKER();
+  SCOPED_TIMER();
   return ProcessMessageCollectiveSigCore(finalcollectivesig, offset,
                                          PROCESS_FINALCOLLECTIVESIG, DONE,
                                          "FinalCollectiveSig");
@@ -563,7 +569,7 @@ ConsensusBackup::~ConsensusBackup() {}
 
 bool ConsensusBackup::ProcessMessage(const zbytes& message, unsigned int offset,
                                      [[gnu::unused]] const Peer& from) {
-  LOG_MARKER();
+  SCOPED_TIMER();
 
   // Incoming message format (from offset): [1-byte consensus message type]
   // [consensus message]
@@ -16,6 +16,10 @@
  */
 
 #include "ConsensusCommon.h"
+
+#include <future>
+#include <thread>
+
 #include "common/Constants.h"
 #include "common/Messages.h"
 #pragma GCC diagnostic push
@@ -23,6 +27,7 @@
 #include "libMessage/Messenger.h"
 #include "libMessage/ZilliqaMessage.pb.h"
 #pragma GCC diagnostic pop
+#include "libMetrics/ScopedTimer.h"
 #include "libUtils/BitVector.h"
 #include "libUtils/Logger.h"
 
@@ -88,7 +93,7 @@ ConsensusCommon::~ConsensusCommon() {}
 
 Signature ConsensusCommon::SignMessage(const zbytes& msg, unsigned int offset,
                                        unsigned int size) {
-  LOG_MARKER();
+  SCOPED_TIMER();
 
   Signature signature;
   bool result = Schnorr::Sign(msg, offset, size, m_myPrivKey,
@@ -103,7 +108,7 @@ bool ConsensusCommon::VerifyMessage(const zbytes& msg, unsigned int offset,
                                     unsigned int size,
                                     const Signature& toverify,
                                     uint16_t peer_id) {
-  LOG_MARKER();
+  SCOPED_TIMER();
   bool result = Schnorr::Verify(msg, offset, size, toverify,
                                 GetCommitteeMember(peer_id).first);
 
@@ -117,7 +122,7 @@ bool ConsensusCommon::VerifyMessage(const zbytes& msg, unsigned int offset,
 }
 
 PubKey ConsensusCommon::AggregateKeys(const vector<bool>& peer_map) {
-  LOG_MARKER();
+  SCOPED_TIMER();
 
   vector<PubKey> keys;
   DequeOfNode::const_iterator j = m_committee.begin();
@@ -136,7 +141,7 @@ PubKey ConsensusCommon::AggregateKeys(const vector<bool>& peer_map) {
 
 CommitPoint ConsensusCommon::AggregateCommits(
     const vector<CommitPoint>& commits) {
-  LOG_MARKER();
+  SCOPED_TIMER();
 
   shared_ptr<CommitPoint> aggregated_commit =
       MultiSig::AggregateCommits(commits);
@@ -149,7 +154,7 @@ CommitPoint ConsensusCommon::AggregateCommits(
 
 Response ConsensusCommon::AggregateResponses(
     const vector<Response>& responses) {
-  LOG_MARKER();
+  SCOPED_TIMER();
 
   shared_ptr<Response> aggregated_response =
       MultiSig::AggregateResponses(responses);
@@ -162,7 +167,7 @@ Response ConsensusCommon::AggregateResponses(
 
 Signature ConsensusCommon::AggregateSign(const Challenge& challenge,
                                          const Response& aggregated_response) {
-  LOG_MARKER();
+  SCOPED_TIMER();
 
   shared_ptr<Signature> result =
       MultiSig::AggregateSign(challenge, aggregated_response);
@@ -176,7 +181,7 @@ Signature ConsensusCommon::AggregateSign(const Challenge& challenge,
 Challenge ConsensusCommon::GetChallenge(const zbytes& msg,
                                         const CommitPoint& aggregated_commit,
                                         const PubKey& aggregated_key) {
-  LOG_MARKER();
+  SCOPED_TIMER();
 
   return Challenge(aggregated_commit, aggregated_key, msg);
 }
@@ -341,6 +346,59 @@ unsigned int ConsensusCommon::NumForConsensus(unsigned int shardSize) {
   return ceil(shardSize * TOLERANCE_FRACTION);
 }
 
+bool ConsensusCommon::VerifyAggregatedResponses(
+    const vector<Response>& responses, const Challenge& challenge,
+    const PubKey& aggregatedKey, const vector<CommitPoint>& commits) {
+  // Every response satisfies s_i * G + c * P_i = Q_i, so their sum satisfies
+  // the same equation with the aggregated key and commit
+  shared_ptr<Response> aggregatedResponse =
+      MultiSig::AggregateResponses(responses);
+  shared_ptr<CommitPoint> aggregatedCommit =
+      MultiSig::AggregateCommits(commits);
+  if (aggregatedResponse == nullptr || aggregatedCommit == nullptr) {
+    LOG_GENERAL(WARNING, "Aggregation failed");
+    return false;
+  }
+
+  return MultiSig::VerifyResponse(*aggregatedResponse, challenge,
+                                  aggregatedKey, *aggregatedCommit);
+}
+
+vector<size_t> ConsensusCommon::FindInvalidResponses(
+    const vector<Response>& responses, const Challenge& challenge,
+    const vector<PubKey>& keys, const vector<CommitPoint>& commits) {
+  if (responses.empty()) {
+    return {};
+  }
+
+  // vector<bool> packs its elements, so each thread writes bytes instead
+  vector<uint8_t> valid(responses.size(), false);
+  const unsigned int numThreads =
+      min<size_t>(max(1u, thread::hardware_concurrency()), responses.size());
+  const size_t chunkSize = (responses.size() + numThreads - 1) / numThreads;
+  vector<future<void>> futures;
+  for (size_t begin = 0; begin < responses.size(); begin += chunkSize) {
+    const size_t end = min(begin + chunkSize, responses.size());
+    futures.emplace_back(async(launch::async, [&, begin, end]() {
+      for (size_t i = begin; i < end; ++i) {
+        valid.at(i) = MultiSig::VerifyResponse(responses.at(i), challenge,
+                                               keys.at(i), commits.at(i));
+      }
+    }));
+  }
+  for (auto& f : futures) {
+    f.get();
+  }
+
+  vector<size_t> invalid;
+  for (size_t i = 0; i < valid.size(); ++i) {
+    if (!valid.at(i)) {
+      invalid.emplace_back(i);
+    }
+  }
+  return invalid;
+}
+
 bool ConsensusCommon::CanProcessMessage(const zbytes& message,
                                         unsigned int offset) {
   if (message.size() <= offset) {
@@ -252,6 +252,18 @@ class ConsensusCommon {
   /// Returns the fraction of the shard required to achieve consensus
   static unsigned int NumForConsensus(unsigned int shardSize);
 
+  /// Checks the sum of the responses against the aggregated key and commit
+  /// of their signers. Passes whenever every response is valid.
+  static bool VerifyAggregatedResponses(
+      const std::vector<Response>& responses, const Challenge& challenge,
+      const PubKey& aggregatedKey, const std::vector<CommitPoint>& commits);
+
+  /// Verifies each response against the key and commit of its signer, in
+  /// parallel, and returns the indices of the invalid ones
+  static std::vector<size_t> FindInvalidResponses(
+      const std::vector<Response>& responses, const Challenge& challenge,
+      const std::vector<PubKey>& keys, const std::vector<CommitPoint>& commits);
+
   /// Checks whether the message can be processed now
   bool CanProcessMessage(const zbytes& message, unsigned int offset);
 
@@ -22,6 +22,8 @@
 #include "common/Messages.h"
 #include "libMessage/Messenger.h"
 #include "libMetrics/Api.h"
+#include "libMetrics/EpochTimeline.h"
+#include "libMetrics/ScopedTimer.h"
 #include "libMetrics/TracedIds.h"
 #include "libNetwork/Guard.h"
 #include "libNetwork/P2P.h"
@@ -41,6 +43,9 @@ namespace local {
 class LeaderVariables {
   int consensusState = -1;
   int consensusError = 0;
+  int64_t responsePhaseMs = 0;
+  int aggregateResponseFailures = 0;
+  int invalidResponses = 0;
 
  public:
   std::unique_ptr<Z_I64GAUGE> temp;
@@ -55,6 +60,17 @@ class LeaderVariables {
     consensusError += count;
   }
 
+  void SetResponsePhaseMs(int64_t ms) {
+    Init();
+    responsePhaseMs = ms;
+  }
+
+  void AddAggregateResponseFailure(int invalidCount) {
+    Init();
+    aggregateResponseFailures++;
+    invalidResponses += invalidCount;
+  }
+
   void Init() {
     if (!temp) {
       temp = std::make_unique<Z_I64GAUGE>(
@@ -64,6 +80,10 @@ class LeaderVariables {
       temp->SetCallback([this](auto&& result) {
         result.Set(consensusState, {{"counter", "ConsensusState"}});
         result.Set(consensusError, {{"counter", "ConsensusError"}});
+        result.Set(responsePhaseMs, {{"counter", "ResponsePhaseMs"}});
+        result.Set(aggregateResponseFailures,
+                   {{"counter", "AggregateResponseFailures"}});
+        result.Set(invalidResponses, {{"counter", "InvalidResponses"}});
       });
     }
   }
@@ -308,6 +328,7 @@ bool ConsensusLeader::StartConsensusSubsets() {
     subset.responseMap.at(m_myID) = true;
     subset.responseCounter = 1;
   }
+  m_challengeSentTime = std::chrono::steady_clock::now();
 
   // Multicast challenge to everyone who belongs to at least one of the subsets
   deque<Peer> peerInfo;
@@ -376,6 +397,12 @@ void ConsensusLeader::SubsetEnded(uint16_t subsetID) {
     // Set overall state to that of subset i.e. COLLECTIVESIG_DONE OR DONE
     m_state = subset.state;
     zil::local::variables.SetConsensusState(int(m_state));
+    if (m_state == COLLECTIVESIG_DONE) {
+      EpochTimeline::GetInstance().End(EpochPhase::CONSENSUS_ROUND_1);
+      EpochTimeline::GetInstance().Begin(EpochPhase::CONSENSUS_ROUND_2);
+    } else {
+      EpochTimeline::GetInstance().End(EpochPhase::CONSENSUS_ROUND_2);
+    }
   } else if (--m_numSubsetsRunning == 0) {
     // All subsets have ended and not one reached consensus!
     LOG_GENERAL(
@@ -397,7 +424,7 @@ bool ConsensusLeader::ProcessMessageCommitCore(
     [[gnu::unused]] ConsensusMessageType returnmsgtype,
     [[gnu::unused]] State nextstate, const Peer& from,
     std::string_view spanName) {
-  LOG_MARKER();
+  SCOPED_TIMER();
 
   lock_guard<mutex> g(m_mutex);
 
@@ -647,7 +674,7 @@ bool ConsensusLeader::ProcessMessageResponseCore(
     const zbytes& response, unsigned int offset, Action action,
     ConsensusMessageType returnmsgtype, State nextstate, const Peer& from,
     std::string_view spanName) {
-  LOG_MARKER();
+  SCOPED_TIMER();
   // Initial checks
   // ==============
 
@@ -727,7 +754,10 @@ bool ConsensusLeader::ProcessMessageResponseCore(
       continue;
     }
 
-    if (!MultiSig::VerifyResponse(subsetInfo.at(subsetID).response,
+    // In optimistic mode the response is only verified as part of the
+    // aggregated response once the subset has enough of them
+    if (!CONSENSUS_OPTIMISTIC_RESPONSE_VERIFY &&
+        !MultiSig::VerifyResponse(subsetInfo.at(subsetID).response,
                                   subset.challenge,
                                   GetCommitteeMember(backupID).first,
                                   subset.commitPointMap.at(backupID))) {
@@ -778,6 +808,23 @@ bool ConsensusLeader::ProcessMessageResponseCore(
     if (subset.responseCounter == m_numForConsensus) {
       LOG_GENERAL(INFO, "[Subset " << subsetID << "] Sufficient responses");
 
+      if (CONSENSUS_OPTIMISTIC_RESPONSE_VERIFY &&
+          !VerifyAggregatedResponse(subsetID)) {
+        const auto invalidCount = RemoveInvalidResponses(subsetID);
+        LOG_GENERAL(WARNING, "[Subset " << subsetID << "] Removed "
+                                        << invalidCount
+                                        << " invalid responses");
+        zil::local::variables.AddAggregateResponseFailure(invalidCount);
+        if (subset.responseCounter < m_numForConsensus) {
+          continue;
+        }
+      }
+
+      zil::local::variables.SetResponsePhaseMs(
+          std::chrono::duration_cast<std::chrono::milliseconds>(
+              std::chrono::steady_clock::now() - m_challengeSentTime)
+              .count());
+
       zbytes collectivesig = {m_classByte, m_insByte,
                               static_cast<uint8_t>(returnmsgtype)};
       if (!GenerateCollectiveSigMessage(
@@ -898,6 +945,63 @@ bool ConsensusLeader::ProcessMessageResponse(const zbytes& response,
                                     "Response");
 }
 
+bool ConsensusLeader::VerifyAggregatedResponse(uint16_t subsetID) {
+  SCOPED_TIMER();
+
+  const ConsensusSubset& subset = m_consensusSubsets.at(subsetID);
+
+  vector<CommitPoint> commits;
+  for (unsigned int i = 0; i < subset.responseMap.size(); ++i) {
+    if (subset.responseMap.at(i)) {
+      commits.emplace_back(subset.commitPointMap.at(i));
+    }
+  }
+
+  return VerifyAggregatedResponses(subset.responseData, subset.challenge,
+                                   AggregateKeys(subset.responseMap), commits);
+}
+
+unsigned int ConsensusLeader::RemoveInvalidResponses(uint16_t subsetID) {
+  SCOPED_TIMER();
+
+  ConsensusSubset& subset = m_consensusSubsets.at(subsetID);
+
+  vector<uint16_t> responders;
+  vector<Response> responses;
+  vector<PubKey> keys;
+  vector<CommitPoint> commits;
+  for (unsigned int i = 0; i < subset.responseMap.size(); ++i) {
+    if (subset.responseMap.at(i) && i != m_myID) {
+      responders.emplace_back(i);
+      responses.emplace_back(subset.responseDataMap.at(i));
+      keys.emplace_back(GetCommitteeMember(i).first);
+      commits.emplace_back(subset.commitPointMap.at(i));
+    }
+  }
+
+  const auto invalid =
+      FindInvalidResponses(responses, subset.challenge, keys, commits);
+  for (const auto i : invalid) {
+    const auto backupID = responders.at(i);
+    LOG_GENERAL(WARNING, "[Subset " << subsetID << "] [Backup " << backupID
+                                    << "] Invalid response");
+    subset.responseMap.at(backupID) = false;
+    subset.responseDataMap.at(backupID) = Response();
+  }
+
+  if (!invalid.empty()) {
+    subset.responseData.clear();
+    for (unsigned int i = 0; i < subset.responseMap.size(); ++i) {
+      if (subset.responseMap.at(i)) {
+        subset.responseData.emplace_back(subset.responseDataMap.at(i));
+      }
+    }
+    subset.responseCounter = subset.responseData.size();
+  }
+
+  return invalid.size();
+}
+
 bool ConsensusLeader::GenerateCollectiveSigMessage(zbytes& collectivesig,
                                                    unsigned int offset,
                                                    uint16_t subsetID) {
@@ -1099,6 +1203,7 @@ bool ConsensusLeader::StartConsensus(
 
   m_state = ANNOUNCE_DONE;
   m_commitFailureCounter = 0;
+  EpochTimeline::GetInstance().Begin(EpochPhase::CONSENSUS_ROUND_1);
 
   // Multicast to all nodes in the committee
   // =======================================
@@ -1156,7 +1261,7 @@ bool ConsensusLeader::StartConsensus(
 
 bool ConsensusLeader::ProcessMessage(const zbytes& message, unsigned int offset,
                                      const Peer& from) {
-  LOG_MARKER();
+  SCOPED_TIMER();
 
   // Incoming message format (from offset): [1-byte consensus message type]
   // [consensus message]
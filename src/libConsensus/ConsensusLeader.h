@@ -18,6 +18,7 @@
 #ifndef ZILLIQA_SRC_LIBCONSENSUS_CONSENSUSLEADER_H_
 #define ZILLIQA_SRC_LIBCONSENSUS_CONSENSUSLEADER_H_
 
+#include <chrono>
 #include <condition_variable>
 
 #include "ConsensusCommon.h"
@@ -88,6 +89,7 @@ class ConsensusLeader : public ConsensusCommon {
   };
   std::vector<ConsensusSubset> m_consensusSubsets;
   unsigned int m_numSubsetsRunning;
+  std::chrono::steady_clock::time_point m_challengeSentTime;
 
   NodeCommitFailureHandlerFunc m_nodeCommitFailureHandlerFunc;
   ShardCommitFailureHandlerFunc m_shardCommitFailureHandlerFunc;
@@ -120,6 +122,10 @@ class ConsensusLeader : public ConsensusCommon {
                               const Peer& from);
   bool GenerateCollectiveSigMessage(zbytes& collectivesig, unsigned int offset,
                                     uint16_t subsetID);
+  bool VerifyAggregatedResponse(uint16_t subsetID);
+  /// Verifies the responses of the subset one by one, removes the invalid
+  /// ones and returns how many were removed
+  unsigned int RemoveInvalidResponses(uint16_t subsetID);
   bool ProcessMessageFinalCommit(const zbytes& finalcommit, unsigned int offset,
                                  const Peer& from);
   bool ProcessMessageFinalResponse(const zbytes& finalresponse,
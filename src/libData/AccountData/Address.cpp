@@ -69,3 +69,22 @@ AddressConversionCode ToBase16Addr(const string& addr, Address& retAddr) {
 
   return ToAddressStructure(addr, retAddr);
 }
+
+zbytes GetStateTrieKey(const Address& address, unsigned int version) {
+  if (version == BINARY_ADDRESS_KEYS) {
+    return address.asBytes();
+  }
+  return DataConversion::StringToCharArray(address.hex());
+}
+
+Address GetAddressFromStateTrieKey(dev::zbytesConstRef key) {
+  if (key.size() == Address::size) {
+    return Address(key);
+  }
+  zbytes addr;
+  if (key.size() != HEX_ADDR_SIZE ||
+      !DataConversion::HexStrToUint8Vec(key.toString(), addr)) {
+    return NullAddress;
+  }
+  return Address(addr);
+}
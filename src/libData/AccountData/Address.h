@@ -37,4 +37,11 @@ enum class AddressConversionCode {
 
 AddressConversionCode ToBase16Addr(const std::string& addr, Address& retAddr);
 
+/// Returns the account state trie key of an address in the given key format
+zbytes GetStateTrieKey(const Address& address,
+                       unsigned int version = STATE_TRIE_KEY_VERSION);
+
+/// Parses an account state trie key in either key format
+Address GetAddressFromStateTrieKey(dev::zbytesConstRef key);
+
 #endif  // ZILLIQA_SRC_LIBDATA_ACCOUNTDATA_ADDRESS_H_
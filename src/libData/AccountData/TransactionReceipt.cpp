@@ -23,11 +23,16 @@
 using namespace std;
 using namespace boost::multiprecision;
 
-TransactionReceipt::TransactionReceipt() {
-  update();
-  m_errorObj[to_string(m_edge)] = Json::arrayValue;
+namespace {
+
+bool GetSuccessFromJson(const Json::Value& obj) {
+  return obj.isObject() && obj["success"].isBool() && obj["success"].asBool();
 }
 
+}  // namespace
+
+TransactionReceipt::TransactionReceipt() {}
+
 bool TransactionReceipt::Serialize(zbytes& dst, unsigned int offset) const {
   if (!Messenger::SetTransactionReceipt(dst, offset, *this)) {
     LOG_GENERAL(WARNING, "Messenger::SetTransactionReceipt failed.");
@@ -43,17 +48,20 @@ bool TransactionReceipt::Deserialize(const zbytes& src, unsigned int offset) {
     return false;
   }
 
-  if (!JSONUtils::GetInstance().convertStrtoJson(m_tranReceiptStr,
-                                                 m_tranReceiptObj)) {
+  Json::Value obj;
+  if (!JSONUtils::GetInstance().convertStrtoJson(m_tranReceiptStr, obj)) {
     LOG_GENERAL(WARNING, "Error with convert receipt string to json object");
     return false;
   }
 
   try {
+    m_tranReceiptObj = std::move(obj);
+    m_building = true;
     update();
   } catch (const std::exception& e) {
     LOG_GENERAL(WARNING, "Error with TransactionReceipt::Deserialize."
                              << ' ' << e.what());
+    ReleaseJsonValue();
     return false;
   }
   return true;
@@ -65,78 +73,100 @@ bool TransactionReceipt::Deserialize(const string& src, unsigned int offset) {
     return false;
   }
 
-  if (!JSONUtils::GetInstance().convertStrtoJson(m_tranReceiptStr,
-                                                 m_tranReceiptObj)) {
+  Json::Value obj;
+  if (!JSONUtils::GetInstance().convertStrtoJson(m_tranReceiptStr, obj)) {
     LOG_GENERAL(WARNING, "Error with convert receipt string to json object");
     return false;
   }
 
   try {
+    m_tranReceiptObj = std::move(obj);
+    m_building = true;
     update();
   } catch (const std::exception& e) {
     LOG_GENERAL(WARNING, "Error with TransactionReceipt::Deserialize."
                              << ' ' << e.what());
+    ReleaseJsonValue();
     return false;
   }
   return true;
 }
 
-void TransactionReceipt::SetResult(const bool& result) {
-  if (result) {
-    m_tranReceiptObj["success"] = true;
-  } else {
-    m_tranReceiptObj["success"] = false;
+Json::Value& TransactionReceipt::GetMutableJsonValue() {
+  if (!m_building) {
+    m_tranReceiptObj = Json::nullValue;
+    if (!m_nullJson) {
+      JSONUtils::GetInstance().convertStrtoJson(m_tranReceiptStr,
+                                                m_tranReceiptObj);
+    }
+    m_building = true;
   }
+  return m_tranReceiptObj;
+}
+
+void TransactionReceipt::ReleaseJsonValue() {
+  m_tranReceiptObj = Json::nullValue;
+  m_building = false;
+}
+
+void TransactionReceipt::SetResult(const bool& result) {
+  m_success = result;
+  GetMutableJsonValue()["success"] = result;
 }
 
 void TransactionReceipt::AddEdge() {
   LOG_MARKER();
+  GetMutableJsonValue();
   m_edge++;
-  m_errorObj[to_string(m_edge)] = Json::arrayValue;
 }
 
 void TransactionReceipt::AddError(const unsigned int& errCode) {
   LOG_GENERAL(INFO, "AddError: " << errCode);
-  m_errorObj[to_string(m_edge)].append(errCode);
+  GetMutableJsonValue();
+  m_errors[m_edge].emplace_back(errCode);
 }
 
 void TransactionReceipt::AddException(const Json::Value& jsonException) {
+  auto& receiptObj = GetMutableJsonValue();
   for (const auto& _e : jsonException) {
     Json::Value obj;
     obj["message"] = _e["error_message"];
     obj["line"] = _e["start_location"]["line"];
-    m_tranReceiptObj["exceptions"].append(obj);
+    receiptObj["exceptions"].append(obj);
   }
 }
 
 void TransactionReceipt::SetCumGas(const uint64_t& cumGas) {
   m_cumGas = cumGas;
-  m_tranReceiptObj["cumulative_gas"] = to_string(m_cumGas);
+  GetMutableJsonValue()["cumulative_gas"] = to_string(m_cumGas);
 }
 
 void TransactionReceipt::SetEpochNum(const uint64_t& epochNum) {
-  m_tranReceiptObj["epoch_num"] = to_string(epochNum);
+  GetMutableJsonValue()["epoch_num"] = to_string(epochNum);
 }
 
 void TransactionReceipt::SetString(const std::string& tranReceiptStr) {
-  if (!JSONUtils::GetInstance().convertStrtoJson(tranReceiptStr,
-                                                 m_tranReceiptObj)) {
+  Json::Value obj;
+  if (!JSONUtils::GetInstance().convertStrtoJson(tranReceiptStr, obj)) {
     LOG_GENERAL(WARNING, "Error with convert receipt string to json object");
     return;
   }
   m_tranReceiptStr = tranReceiptStr;
+  m_nullJson = false;
+  m_success = GetSuccessFromJson(obj);
+  ReleaseJsonValue();
 }
 
 void TransactionReceipt::AddLogEntry(const LogEntry& entry) {
-  m_tranReceiptObj["event_logs"].append(entry.GetJsonObject());
+  GetMutableJsonValue()["event_logs"].append(entry.GetJsonObject());
 }
 
 void TransactionReceipt::AddJsonEntry(const Json::Value& obj) {
-  m_tranReceiptObj["event_logs"] = obj;
+  GetMutableJsonValue()["event_logs"] = obj;
 }
 
 void TransactionReceipt::AppendJsonEntry(const Json::Value& obj) {
-  m_tranReceiptObj["event_logs"].append(obj);
+  GetMutableJsonValue()["event_logs"].append(obj);
 }
 
 void TransactionReceipt::AddTransition(const Address& addr,
@@ -146,59 +176,79 @@ void TransactionReceipt::AddTransition(const Address& addr,
   _json["addr"] = "0x" + addr.hex();
   _json["msg"] = transition;
   _json["depth"] = tree_depth;
-  m_tranReceiptObj["transitions"].append(_json);
+  GetMutableJsonValue()["transitions"].append(_json);
 }
 
 void TransactionReceipt::AddAccepted(bool accepted) {
-  m_tranReceiptObj["accepted"] = accepted;
+  GetMutableJsonValue()["accepted"] = accepted;
 }
 
 bool TransactionReceipt::AddAcceptedForLastTransition(bool accepted) {
   LOG_MARKER();
-  if (m_tranReceiptObj["transitions"].empty()) {
+  auto& receiptObj = GetMutableJsonValue();
+  if (receiptObj["transitions"].empty()) {
     return false;
   }
-  m_tranReceiptObj["transitions"][(m_tranReceiptObj["transitions"].size() - 1)]
-                  ["accepted"] = accepted;
+  receiptObj["transitions"][(receiptObj["transitions"].size() - 1)]
+            ["accepted"] = accepted;
   return true;
 }
 
 void TransactionReceipt::RemoveAllTransitions() {
-  m_tranReceiptObj.removeMember("transitions");
+  GetMutableJsonValue().removeMember("transitions");
 }
 
 void TransactionReceipt::CleanEntry() {
-  m_tranReceiptObj.removeMember("event_logs");
+  GetMutableJsonValue().removeMember("event_logs");
 }
 
 void TransactionReceipt::clear() {
-  m_tranReceiptStr.clear();
-  m_tranReceiptObj.clear();
-  m_errorObj.clear();
+  // Clearing a tree leaves it null only if it was null
+  m_nullJson = m_building ? m_tranReceiptObj.isNull() : m_nullJson;
+  m_tranReceiptStr = "{}";
+  m_errors.clear();
   m_edge = 0;
-  update();
+  m_success = false;
+  ReleaseJsonValue();
 }
 
 void TransactionReceipt::InstallError() {
   Json::Value errorObj;
-  for (const auto& e : m_errorObj.getMemberNames()) {
-    if (!m_errorObj[e].empty()) {
-      errorObj[e] = m_errorObj[e];
+  for (const auto& [edge, errCodes] : m_errors) {
+    for (const auto& errCode : errCodes) {
+      errorObj[to_string(edge)].append(errCode);
     }
   }
   if (!errorObj.empty()) {
-    m_tranReceiptObj["errors"] = errorObj;
+    GetMutableJsonValue()["errors"] = errorObj;
+  }
+}
+
+Json::Value TransactionReceipt::GetJsonValue() const {
+  if (m_building) {
+    return m_tranReceiptObj;
+  }
+  Json::Value obj;
+  if (!m_nullJson) {
+    JSONUtils::GetInstance().convertStrtoJson(m_tranReceiptStr, obj);
   }
+  return obj;
 }
 
 void TransactionReceipt::update() {
-  if (m_tranReceiptObj == Json::nullValue) {
-    m_tranReceiptStr = "{}";
+  if (!m_building) {
     return;
   }
-  InstallError();
-  m_tranReceiptStr =
-      JSONUtils::GetInstance().convertJsontoStr(m_tranReceiptObj);
+  m_nullJson = (m_tranReceiptObj == Json::nullValue);
+  if (m_nullJson) {
+    m_tranReceiptStr = "{}";
+  } else {
+    InstallError();
+    m_tranReceiptStr =
+        JSONUtils::GetInstance().convertJsontoStr(m_tranReceiptObj);
+    m_success = GetSuccessFromJson(m_tranReceiptObj);
+  }
+  ReleaseJsonValue();
 }
 
 /// Implements the Serialize function inherited from Serializable.
@@ -18,7 +18,9 @@
 #ifndef ZILLIQA_SRC_LIBDATA_ACCOUNTDATA_TRANSACTIONRECEIPT_H_
 #define ZILLIQA_SRC_LIBDATA_ACCOUNTDATA_TRANSACTIONRECEIPT_H_
 
+#include <map>
 #include <unordered_map>
+#include <vector>
 
 #include "LogEntry.h"
 #include "Transaction.h"
@@ -91,12 +93,25 @@ constexpr std::array<std::string_view, static_cast<uint8_t>(MAX_LEN)>
 
 }  // namespace TransactionReceiptStr
 
+/// The receipt is kept in its serialized JSON form, which is what is hashed,
+/// stored and sent to other nodes. The JSON tree is only held while the
+/// receipt is being built, from the first change until update(), so that the
+/// receipts of a processed block don't keep a tree each in memory.
 class TransactionReceipt : public SerializableDataBlock {
   Json::Value m_tranReceiptObj = Json::nullValue;
-  std::string m_tranReceiptStr;
+  std::string m_tranReceiptStr = "{}";
+  // Whether m_tranReceiptStr was rendered from a null tree, which is built
+  // on again as a null tree rather than an empty object
+  bool m_nullJson = true;
   uint64_t m_cumGas = 0;
+  bool m_success = false;
   unsigned int m_edge = 0;
-  Json::Value m_errorObj;
+  // Error codes by edge
+  std::map<unsigned int, std::vector<unsigned int>> m_errors;
+  bool m_building = false;
+
+  Json::Value& GetMutableJsonValue();
+  void ReleaseJsonValue();
 
  public:
   TransactionReceipt();
@@ -122,8 +137,11 @@ class TransactionReceipt : public SerializableDataBlock {
   const std::string& GetString() const { return m_tranReceiptStr; }
   void SetString(const std::string& tranReceiptStr);
   const uint64_t& GetCumGas() const { return m_cumGas; }
+  bool GetSuccess() const { return m_success; }
   void clear();
-  const Json::Value& GetJsonValue() const { return m_tranReceiptObj; }
+  /// Renders the receipt as JSON, only meant for the RPC and websocket
+  /// servers, use the getters above elsewhere
+  Json::Value GetJsonValue() const;
   void update();
 };
 
@@ -16,6 +16,7 @@
  */
 
 #include <leveldb/db.h>
+#include <future>
 #include <regex>
 
 #include "libData/AccountStore/AccountStore.h"
@@ -94,7 +95,7 @@ Z_I64METRIC &GetCallCounter() {
 }  // namespace zil
 
 AccountStore::AccountStore()
-    : m_db("state"),
+    : m_db("state", static_cast<size_t>(TRIE_NODE_CACHE_MB) * 1024 * 1024),
       m_state(&m_db),
       m_accountStoreTemp(*this),
       m_scillaIPCServerConnector(SCILLA_IPC_SOCKET_PATH) {
@@ -193,7 +194,7 @@ Account *AccountStore::GetAccount(const Address &address, bool resetRoot) {
           auto t_state = m_state;
           t_state.setRoot(m_prevRoot);
           rawAccountBase =
-              t_state.at(DataConversion::StringToCharArray(address.hex()));
+              t_state.at(GetStateTrieKey(address));
         } catch (std::exception &e) {
           LOG_GENERAL(WARNING, "setRoot for " << m_prevRoot.hex() << " failed, "
                                               << e.what());
@@ -201,8 +202,7 @@ Account *AccountStore::GetAccount(const Address &address, bool resetRoot) {
         }
       }
     } else {
-      rawAccountBase =
-          m_state.at(DataConversion::StringToCharArray(address.hex()));
+      rawAccountBase = m_state.at(GetStateTrieKey(address));
     }
   }
   if (rawAccountBase.empty()) {
@@ -393,6 +393,13 @@ bool AccountStore::MoveRootToDisk(const dev::h256 &root) {
     LOG_GENERAL(INFO, "FAIL: Put state root failed " << root.hex());
     return false;
   }
+  const auto keyVersion =
+      DataConversion::StringToCharArray(to_string(STATE_TRIE_KEY_VERSION));
+  if (!BlockStorage::GetBlockStorage().PutMetadata(STATE_TRIE_KEY_VERSION_USED,
+                                                   keyVersion)) {
+    LOG_GENERAL(INFO, "FAIL: Put state trie key version failed");
+    return false;
+  }
   return true;
 }
 
@@ -488,6 +495,11 @@ bool AccountStore::IsPurgeRunning() {
           ContractStorage::GetContractStorage().IsPurgeRunning());
 }
 
+void AccountStore::SetPurgePaused(bool paused) {
+  m_state.db()->SetPurgePaused(paused);
+  ContractStorage::GetContractStorage().SetPurgePaused(paused);
+}
+
 bool AccountStore::RetrieveFromDisk() {
   InitSoft();
 
@@ -513,23 +525,56 @@ bool AccountStore::RetrieveFromDisk() {
   }
 
   try {
-    dev::h256 root(rootBytes);
-    LOG_GENERAL(INFO, "StateRootHash:" << root.hex());
-    lock_guard<mutex> g(m_mutexTrie);
-    if (root != dev::h256()) {
-      try {
-        m_state.setRoot(root);
-        m_prevRoot = m_state.root();
-      } catch (...) {
-        LOG_GENERAL(WARNING, "setRoot for " << m_prevRoot.hex() << " failed");
-        return false;
-      }
-    }
+    return SetRootFromDisk(dev::h256(rootBytes));
   } catch (const boost::exception &e) {
     LOG_GENERAL(WARNING, "Error with AccountStore::RetrieveFromDisk. "
                              << boost::diagnostic_information(e));
     return false;
   }
+}
+
+bool AccountStore::RetrieveFromDisk(const dev::h256 &root) {
+  InitSoft();
+
+  unique_lock<shared_timed_mutex> g(m_mutexPrimary, defer_lock);
+  unique_lock<mutex> g2(m_mutexDB, defer_lock);
+  lock(g, g2);
+
+  return SetRootFromDisk(root);
+}
+
+bool AccountStore::SetRootFromDisk(const dev::h256 &root) {
+  // Databases written before the version was recorded use hex keys
+  unsigned int keyVersion = HEX_ADDRESS_KEYS;
+  zbytes versionBytes;
+  if (BlockStorage::GetBlockStorage().GetMetadata(STATE_TRIE_KEY_VERSION_USED,
+                                                  versionBytes, true)) {
+    try {
+      keyVersion = stoul(DataConversion::CharArrayToString(versionBytes));
+    } catch (...) {
+      LOG_GENERAL(WARNING, "Invalid state trie key version on disk");
+      return false;
+    }
+  }
+  if (keyVersion != STATE_TRIE_KEY_VERSION) {
+    LOG_GENERAL(WARNING, "State trie on disk uses key version "
+                             << keyVersion << " but STATE_TRIE_KEY_VERSION is "
+                             << STATE_TRIE_KEY_VERSION
+                             << ", migrate it with rebuildState first");
+    return false;
+  }
+
+  LOG_GENERAL(INFO, "StateRootHash:" << root.hex());
+  lock_guard<mutex> g(m_mutexTrie);
+  if (root != dev::h256()) {
+    try {
+      m_state.setRoot(root);
+      m_prevRoot = m_state.root();
+    } catch (...) {
+      LOG_GENERAL(WARNING, "setRoot for " << root.hex() << " failed");
+      return false;
+    }
+  }
   return true;
 }
 
@@ -763,8 +808,14 @@ bool AccountStore::GetProof(const Address &address, const dev::h256 &rootHash,
       }
     }
 
-    rawAccountBase = t_state.getProof(
-        DataConversion::StringToCharArray(address.hex()), nodes);
+    rawAccountBase = t_state.getProof(GetStateTrieKey(address), nodes);
+
+    // Roots from before the key migration still use hex keys
+    if (rawAccountBase.empty() && STATE_TRIE_KEY_VERSION != HEX_ADDRESS_KEYS) {
+      nodes.clear();
+      rawAccountBase = t_state.getProof(
+          GetStateTrieKey(address, HEX_ADDRESS_KEYS), nodes);
+    }
   }
 
   if (rawAccountBase.empty()) {
@@ -796,7 +847,7 @@ bool AccountStore::UpdateStateTrie(const Address &address,
   }
 
   std::lock_guard<std::mutex> g(m_mutexTrie);
-  m_state.insert(DataConversion::StringToCharArray(address.hex()), rawBytes);
+  m_state.insert(GetStateTrieKey(address), rawBytes);
 
   return true;
 }
@@ -805,7 +856,7 @@ bool AccountStore::RemoveFromTrie(const Address &address) {
   // LOG_MARKER();
   std::lock_guard<std::mutex> g(m_mutexTrie);
 
-  m_state.remove(DataConversion::StringToCharArray(address.hex()));
+  m_state.remove(GetStateTrieKey(address));
 
   return true;
 }
@@ -832,18 +883,52 @@ bool AccountStore::UpdateStateTrieAll() {
       return false;
     }
   }
+  auto tpStart = r_timer_start();
+
+  // Serialize the accounts in parallel, then merge them into the trie in one
+  // pass, which gives the same root as inserting them one by one.
+  std::vector<const std::pair<const Address, Account> *> entries;
+  entries.reserve(m_addressToAccount->size());
   for (auto const &entry : *(this->m_addressToAccount)) {
-    zbytes rawBytes;
-    if (!entry.second.SerializeBase(rawBytes, 0)) {
-      LOG_GENERAL(WARNING, "Messenger::SetAccountBase failed");
-      return false;
+    entries.push_back(&entry);
+  }
+  std::vector<std::pair<zbytes, zbytes>> kvs(entries.size());
+
+  const size_t numThreads = std::max<size_t>(
+      1, std::min<size_t>(std::thread::hardware_concurrency(),
+                          entries.size() / 256));
+  const size_t chunkSize = (entries.size() + numThreads - 1) / numThreads;
+  auto serializeRange = [&entries, &kvs](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+      kvs[i].first = GetStateTrieKey(entries[i]->first);
+      if (!entries[i]->second.SerializeBase(kvs[i].second, 0)) {
+        LOG_GENERAL(WARNING, "Messenger::SetAccountBase failed");
+        return false;
+      }
     }
-    m_state.insert(DataConversion::StringToCharArray(entry.first.hex()),
-                   rawBytes);
+    return true;
+  };
+  std::vector<std::future<bool>> tasks;
+  for (size_t begin = chunkSize; begin < entries.size(); begin += chunkSize) {
+    tasks.push_back(std::async(std::launch::async, serializeRange, begin,
+                               std::min(begin + chunkSize, entries.size())));
+  }
+  bool serialized = serializeRange(0, std::min(chunkSize, entries.size()));
+  for (auto &task : tasks) {
+    serialized = task.get() && serialized;
+  }
+  if (!serialized) {
+    return false;
   }
 
+  m_state.insertBatch(kvs);
+
   m_prevRoot = m_state.root();
 
+  LOG_GENERAL(INFO, "Updated state trie with " << kvs.size() << " accounts in "
+                                               << r_timer_end(tpStart)
+                                               << " us");
+
   return true;
 }
 
@@ -81,6 +81,10 @@ class AccountStore : public AccountStoreBase {
   /// Store the trie root to leveldb
   bool MoveRootToDisk(const dev::h256& root);
 
+  /// Point the trie at a root of the state on disk, with m_mutexPrimary and
+  /// m_mutexDB held
+  bool SetRootFromDisk(const dev::h256& root);
+
   // From AccountStoreTrie
   bool UpdateStateTrie(const Address& address, const Account& account);
   bool RemoveFromTrie(const Address& address);
@@ -126,6 +130,10 @@ class AccountStore : public AccountStoreBase {
   /// repopulate the in-memory data structures from persistent storage
   bool RetrieveFromDisk();
 
+  /// repopulate the in-memory data structures from the state at a root of
+  /// the state trie on disk, leaving the stored latest root untouched
+  bool RetrieveFromDisk(const dev::h256& root);
+
   /// From AccountStoreTrie
   Account* GetAccount(const Address& address) override;
   Account* GetAccount(const Address& address, bool resetRoot);
@@ -226,6 +234,8 @@ class AccountStore : public AccountStoreBase {
 
   bool IsPurgeRunning();
 
+  void SetPurgePaused(bool paused);
+
   std::shared_timed_mutex& GetPrimaryMutex() { return m_mutexPrimary; }
 
   bool EvmProcessMessageTemp(EvmProcessContext& params,
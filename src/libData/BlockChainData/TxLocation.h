@@ -0,0 +1,34 @@
+/*
+ * Copyright (C) 2019 Zilliqa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef ZILLIQA_SRC_LIBDATA_BLOCKCHAINDATA_TXLOCATION_H_
+#define ZILLIQA_SRC_LIBDATA_BLOCKCHAINDATA_TXLOCATION_H_
+
+#include <cstdint>
+#include <optional>
+
+/// Stores the position of a committed transaction within its Tx block
+struct TxLocation {
+  uint64_t m_blockNum{};
+  uint32_t m_mbIndex{};      // index into TxBlock::GetMicroBlockInfos()
+  uint32_t m_txIndexInMb{};  // index into MicroBlock::GetTranHashes()
+  // Index across all microblocks of the Tx block. Unset if some preceding
+  // microblock was not yet stored when the transaction was committed.
+  std::optional<uint64_t> m_txIndexInBlock;
+};
+
+#endif  // ZILLIQA_SRC_LIBDATA_BLOCKCHAINDATA_TXLOCATION_H_
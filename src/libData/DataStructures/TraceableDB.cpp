@@ -16,36 +16,93 @@
  */
 
 #include "libData/DataStructures/TraceableDB.h"
+#include "libMetrics/ScopedTimer.h"
 #include "libUtils/DetachedFunction.h"
 
 using namespace std;
 
+namespace {
+
+const string RESURRECTED_KEY_PREFIX = "resurrected_";
+
+string PurgeKey(uint64_t dsBlockNum) {
+  std::stringstream keystream;
+  keystream.fill('0');
+  keystream.width(BLOCK_NUMERIC_DIGITS);
+  keystream << std::to_string(dsBlockNum);
+  return keystream.str();
+}
+
+}  // namespace
+
+TraceableDB::TraceableDB(const std::string& dbName, size_t nodeCacheBytes)
+    : dev::OverlayDB(dbName, nodeCacheBytes), m_purgeDB(dbName + "_purge") {
+  m_purgeStats.SetCallback([this, dbName](auto&& result) {
+    if (!m_purgeStats.Enabled()) {
+      return;
+    }
+    result.Set(m_purgedNodes.load(), {{"db", dbName}, {"counter", "Purged"}});
+    result.Set(m_numPendingEpochs.load(),
+               {{"db", dbName}, {"counter", "PendingEpochs"}});
+    result.Set(m_oldestPendingEpoch.load(),
+               {{"db", dbName}, {"counter", "OldestPendingEpoch"}});
+    result.Set(GetPurgeLag(), {{"db", dbName}, {"counter", "LagEpochs"}});
+    result.Set(m_purgePaused ? 1 : 0, {{"db", dbName}, {"counter", "Paused"}});
+  });
+}
+
+TraceableDB::~TraceableDB() {
+  {
+    lock_guard<mutex> g(m_mutexPurgeWorker);
+    m_stopPurgeWorker = true;
+  }
+  m_cvPurgeWorker.notify_all();
+  m_cvPurgeProgress.notify_all();
+  if (m_purgeWorker.joinable()) {
+    m_purgeWorker.join();
+  }
+}
+
 bool TraceableDB::commit(const uint64_t& dsBlockNum) {
+  const bool keepHistory = KEEP_HISTORICAL_STATE && LOOKUP_NODE_MODE;
+
+  lock_guard<mutex> g(m_mutexPurge);
+
+  std::vector<dev::h256> resurrected;
+  if (keepHistory && dsBlockNum) {
+    LoadPurgeState();
+    resurrected = FindResurrected();
+  }
+
   std::vector<dev::h256> toPurge;
   unordered_set<dev::h256> inserted;
-  if (!OverlayDB::commit(KEEP_HISTORICAL_STATE && LOOKUP_NODE_MODE, toPurge,
-                         inserted)) {
+  if (!OverlayDB::commit(keepHistory, toPurge, inserted)) {
     LOG_GENERAL(WARNING, "OverlayDB::commit failed");
     return false;
   }
 
-  if (!(KEEP_HISTORICAL_STATE && LOOKUP_NODE_MODE) || !dsBlockNum) {
+  if (!keepHistory || !dsBlockNum) {
     // memory mgmt
     dev::h256s().swap(toPurge);
     return true;
   }
 
-  // adding into purge pool
-  if (!AddPendingPurge(dsBlockNum, toPurge)) {
-    LOG_GENERAL(WARNING, "AddToPurge failed");
+  if (dsBlockNum > m_latestDSBlockNum) {
+    m_latestDSBlockNum = dsBlockNum;
+  }
+
+  if (!AddResurrected(dsBlockNum, resurrected)) {
+    LOG_GENERAL(WARNING, "AddResurrected failed");
     return false;
   }
 
-  // execute purge for expired keys
-  if (!ExecutePurge(dsBlockNum, inserted)) {
-    LOG_GENERAL(WARNING, "ExecutePurging failed");
+  // adding into purge pool, the expired keys are purged by the purge worker
+  if (!AddPendingPurge(dsBlockNum, toPurge)) {
+    LOG_GENERAL(WARNING, "AddToPurge failed");
     return false;
   }
+  UpdatePurgeProgress();
+  StartPurgeWorker();
 
   // memory mgmt
   dev::h256s().swap(toPurge);
@@ -53,24 +110,72 @@ bool TraceableDB::commit(const uint64_t& dsBlockNum) {
   return true;
 }
 
+std::vector<dev::h256> TraceableDB::FindResurrected() const {
+  // Only the nodes about to be written that are still pending purge have
+  // been resurrected
+  std::vector<dev::h256> resurrected;
+  if (m_pendingNodes.empty()) {
+    return resurrected;
+  }
+  shared_lock<shared_timed_mutex> lock(x_this);
+  for (const auto& i : *m_main) {
+    if (i.second.second && m_pendingNodes.count(i.first) > 0) {
+      resurrected.emplace_back(i.first);
+    }
+  }
+  return resurrected;
+}
+
+bool TraceableDB::AddResurrected(const uint64_t& dsBlockNum,
+                                 const std::vector<dev::h256>& resurrected) {
+  if (m_pendingEpochs.empty()) {
+    return true;
+  }
+
+  const string epoch = to_string(dsBlockNum);
+  for (const auto& hash : resurrected) {
+    m_resurrected[hash] = dsBlockNum;
+    if (m_purgeDB.Insert(leveldb::Slice(RESURRECTED_KEY_PREFIX + hash.hex()),
+                         leveldb::Slice(epoch)) != 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
 bool TraceableDB::AddPendingPurge(const uint64_t& dsBlockNum,
                                   const std::vector<dev::h256>& toPurge) {
-  LOG_MARKER();
+  SCOPED_TIMER();
   if (toPurge.empty()) {
     return true;
   }
 
-  dev::RLPStream s(toPurge.size());
+  // Every final block of the DS epoch commits, keep what the earlier ones
+  // have left for purging
+  const string key = PurgeKey(dsBlockNum);
+  std::vector<dev::h256> pending;
+  if (m_pendingEpochs.count(dsBlockNum)) {
+    const string value = m_purgeDB.Lookup(key);
+    if (!value.empty()) {
+      pending = dev::RLP(value).toVector<dev::h256>();
+    }
+  }
+
+  dev::RLPStream s(pending.size() + toPurge.size());
+  for (const auto& it : pending) {
+    s.append(it);
+  }
   for (const auto& it : toPurge) {
     s.append(it);
   }
 
-  std::stringstream keystream;
-  keystream.fill('0');
-  keystream.width(BLOCK_NUMERIC_DIGITS);
-  keystream << std::to_string(dsBlockNum);
-
-  bool res = m_purgeDB.Insert(keystream.str(), s.out());
+  bool res = m_purgeDB.Insert(key, s.out());
+  if (res == 0) {
+    m_pendingEpochs.emplace(dsBlockNum);
+    for (const auto& it : toPurge) {
+      ++m_pendingNodes[it];
+    }
+  }
 
   // memory mgmt
   s.clear();
@@ -78,86 +183,201 @@ bool TraceableDB::AddPendingPurge(const uint64_t& dsBlockNum,
   return res == 0;
 }
 
-bool TraceableDB::ExecutePurge(const uint64_t& dsBlockNum,
-                               const unordered_set<dev::h256>& inserted,
-                               bool purgeAll) {
-  LOG_MARKER();
+void TraceableDB::LoadPurgeState() {
+  if (m_purgeStateLoaded) {
+    return;
+  }
 
+  m_pendingEpochs.clear();
+  m_resurrected.clear();
+  m_pendingNodes.clear();
   std::unique_ptr<leveldb::Iterator> iter(
       m_purgeDB.GetDB()->NewIterator(leveldb::ReadOptions()));
-  iter->SeekToFirst();
-  for (; iter->Valid(); iter->Next()) {
-    if (purgeAll && m_stopSignal) {
+  for (iter->SeekToFirst(); iter->Valid(); iter->Next()) {
+    const string key = iter->key().ToString();
+    try {
+      if (key.rfind(RESURRECTED_KEY_PREFIX, 0) == 0) {
+        m_resurrected[dev::h256(key.substr(RESURRECTED_KEY_PREFIX.size()))] =
+            stoull(iter->value().ToString());
+      } else {
+        m_pendingEpochs.emplace(stoull(key));
+        const string value = iter->value().ToString();
+        if (!value.empty()) {
+          for (const auto& hash : dev::RLP(value).toVector<dev::h256>()) {
+            ++m_pendingNodes[hash];
+          }
+        }
+      }
+    } catch (...) {
+      LOG_GENERAL(INFO, "Unexpected key in purge db: " << key);
+    }
+  }
+  m_purgeStateLoaded = true;
+  UpdatePurgeProgress();
+}
+
+void TraceableDB::ReleasePendingNode(const dev::h256& hash) {
+  auto it = m_pendingNodes.find(hash);
+  if (it != m_pendingNodes.end() && --it->second == 0) {
+    m_pendingNodes.erase(it);
+  }
+}
+
+void TraceableDB::UpdatePurgeProgress() {
+  m_numPendingEpochs = m_pendingEpochs.size();
+  m_oldestPendingEpoch =
+      m_pendingEpochs.empty() ? 0 : *m_pendingEpochs.begin();
+}
+
+uint64_t TraceableDB::GetPurgeLag() const {
+  if (m_numPendingEpochs == 0 ||
+      m_oldestPendingEpoch + NUM_DS_EPOCHS_STATE_HISTORY >=
+          m_latestDSBlockNum) {
+    return 0;
+  }
+  return m_latestDSBlockNum - NUM_DS_EPOCHS_STATE_HISTORY -
+         m_oldestPendingEpoch;
+}
+
+size_t TraceableDB::ExecutePurge(size_t maxNodes, bool purgeAll) {
+  lock_guard<mutex> g(m_mutexPurge);
+  LoadPurgeState();
+
+  size_t processed = 0;
+  while (processed < maxNodes && !m_pendingEpochs.empty()) {
+    if (m_stopSignal) {
       LOG_GENERAL(WARNING, "m_stopSignal = true");
       break;
     }
-    uint64_t t_dsBlockNum;
-    try {
-      t_dsBlockNum = stoull(iter->key().ToString());
-    } catch (...) {
-      LOG_GENERAL(INFO, "key is not numeric: " << iter->key().ToString());
-      return false;
+
+    // If purgeAll = true, the age of the epoch is inconsequential
+    const uint64_t t_dsBlockNum = *m_pendingEpochs.begin();
+    if (!purgeAll &&
+        t_dsBlockNum + NUM_DS_EPOCHS_STATE_HISTORY >= m_latestDSBlockNum) {
+      break;
+    }
+
+    const string key = PurgeKey(t_dsBlockNum);
+    std::vector<dev::h256> toPurge;
+    const string value = m_purgeDB.Lookup(key);
+    if (!value.empty()) {
+      toPurge = dev::RLP(value).toVector<dev::h256>();
     }
 
-    // If purgeAll = true, dsBlockNum is inconsequential
-    dev::RLP rlp(iter->value());
-    std::vector<dev::h256> toPurge(rlp);
-    bool updated = false;
-    for (auto it = toPurge.begin(); it != toPurge.end();) {
-      if (inserted.find(*it) != inserted.end()) {
-        LOG_GENERAL(INFO, "Do not purge : " << it->hex());
-        it = toPurge.erase(it);
-        updated = true;
+    const size_t count = min(toPurge.size(), maxNodes - processed);
+    std::vector<dev::h256> toDelete;
+    toDelete.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+      ReleasePendingNode(toPurge[i]);
+      auto it = m_resurrected.find(toPurge[i]);
+      if (it != m_resurrected.end() && it->second >= t_dsBlockNum) {
+        LOG_GENERAL(INFO, "Do not purge : " << toPurge[i].hex());
+        continue;
+      }
+      toDelete.emplace_back(toPurge[i]);
+    }
+    deleteNodes(toDelete);
+    m_purgedNodes += toDelete.size();
+    processed += count;
+
+    if (count < toPurge.size()) {
+      // Leave the rest of the epoch for the next round
+      dev::RLPStream s(toPurge.size() - count);
+      for (auto it = toPurge.begin() + count; it != toPurge.end(); ++it) {
+        s.append(*it);
+      }
+      m_purgeDB.Insert(key, s.out());
+      break;
+    }
+
+    m_purgeDB.DeleteKey(key);
+    m_pendingEpochs.erase(m_pendingEpochs.begin());
+    LOG_GENERAL(INFO, "Purged entries for t_dsBlockNum = " << t_dsBlockNum);
+
+    // Markers only protect the nodes of epochs up to their own
+    for (auto it = m_resurrected.begin(); it != m_resurrected.end();) {
+      if (m_pendingEpochs.empty() || it->second < *m_pendingEpochs.begin()) {
+        m_purgeDB.DeleteKey(RESURRECTED_KEY_PREFIX + it->first.hex());
+        it = m_resurrected.erase(it);
       } else {
         ++it;
       }
     }
-    if ((t_dsBlockNum + NUM_DS_EPOCHS_STATE_HISTORY < dsBlockNum) || purgeAll) {
-      m_levelDB.BatchDelete(toPurge);
-      m_purgeDB.DeleteKey(iter->key().ToString());
-      // compact/cleanup for this key immediately.
-      leveldb::Slice k(iter->key());
-      m_purgeDB.GetDB()->CompactRange(&k, &k);
-      LOG_GENERAL(INFO, "Purged entries for t_dsBlockNum = " << t_dsBlockNum);
-    } else {
-      if (updated) {
-        dev::RLPStream s(toPurge.size());
-
-        for (const auto& i : toPurge) {
-          s.append(i);
-        }
-        // Replace the blocknum with new purge hashes
-        m_purgeDB.Insert(iter->key().ToString(), s.out());
+  }
+  UpdatePurgeProgress();
 
-        // memory mgmt
-        s.clear();
-      }
+  return processed;
+}
+
+void TraceableDB::StartPurgeWorker() {
+  lock_guard<mutex> g(m_mutexPurgeWorker);
+  if (m_purgeWorker.joinable() || m_stopPurgeWorker) {
+    return;
+  }
+  m_purgeWorker = std::thread(&TraceableDB::RunPurgeWorker, this);
+}
+
+void TraceableDB::RunPurgeWorker() {
+  unique_lock<mutex> lock(m_mutexPurgeWorker);
+  while (!m_stopPurgeWorker) {
+    m_cvPurgeWorker.wait_for(lock,
+                             chrono::milliseconds(PURGE_TICK_INTERVAL_MS));
+    if (m_stopPurgeWorker || m_purgePaused || m_stopSignal) {
+      continue;
     }
-    // memory mgmt
-    dev::h256s().swap(toPurge);
+    bool expected = false;
+    if (!m_purgeRunning.compare_exchange_strong(expected, true)) {
+      continue;
+    }
+    lock.unlock();
+    ExecutePurge(PURGE_MAX_NODES_PER_TICK);
+    m_purgeRunning = false;
+    lock.lock();
+    m_cvPurgeProgress.notify_all();
   }
+}
 
-  return true;
+bool TraceableDB::WaitForPurge(chrono::milliseconds timeout) {
+  unique_lock<mutex> lock(m_mutexPurgeWorker);
+  return m_cvPurgeProgress.wait_for(lock, timeout, [this]() {
+    return GetPurgeLag() == 0 || m_stopPurgeWorker;
+  }) && GetPurgeLag() == 0;
+}
+
+void TraceableDB::ResetDB() {
+  lock_guard<mutex> g(m_mutexPurge);
+  OverlayDB::ResetDB();
+  m_purgeDB.ResetDB();
+  m_purgeStateLoaded = false;
 }
 
 bool TraceableDB::RefreshDB() {
-  return m_levelDB.RefreshDB() && m_purgeDB.RefreshDB();
+  lock_guard<mutex> g(m_mutexPurge);
+  m_purgeStateLoaded = false;
+  m_stopSignal = false;
+  return OverlayDB::RefreshDB() && m_purgeDB.RefreshDB();
 }
 
 void TraceableDB::DetachedExecutePurge() {
   LOG_MARKER();
 
   auto detached_func = [this]() -> void {
-    if (!m_purgeRunning) {
-      unordered_set<dev::h256> inserted;
-      m_stopSignal = false;
-      m_purgeRunning = true;
-      ExecutePurge(0, inserted, true);
-      m_purgeRunning = false;
-      m_stopSignal = false;
-    } else {
+    bool expected = false;
+    if (!m_purgeRunning.compare_exchange_strong(expected, true)) {
       LOG_GENERAL(INFO, "DetachedExecutePurge already running");
+      return;
     }
+    m_stopSignal = false;
+    while (!m_stopSignal) {
+      if (!m_purgePaused &&
+          ExecutePurge(PURGE_MAX_NODES_PER_TICK, true) <
+              PURGE_MAX_NODES_PER_TICK) {
+        break;
+      }
+      this_thread::sleep_for(chrono::milliseconds(PURGE_TICK_INTERVAL_MS));
+    }
+    m_purgeRunning = false;
+    m_stopSignal = false;
   };
   DetachedFunction(1, detached_func);
-}
\ No newline at end of file
+}
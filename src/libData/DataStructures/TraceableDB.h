@@ -18,28 +18,78 @@
 #ifndef ZILLIQA_SRC_LIBDATA_DATASTRUCTURES_TRACEABLEDB_H_
 #define ZILLIQA_SRC_LIBDATA_DATASTRUCTURES_TRACEABLEDB_H_
 
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <unordered_map>
+
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wunused-parameter"
 #include "depends/libDatabase/OverlayDB.h"
 #pragma GCC diagnostic pop
+#include "libMetrics/Api.h"
 
+/// OverlayDB that keeps the trie nodes of the last NUM_DS_EPOCHS_STATE_HISTORY
+/// DS epochs on lookups with KEEP_HISTORICAL_STATE. The nodes a commit makes
+/// unreachable are recorded per DS epoch in the _purge db, and a background
+/// worker deletes the expired ones a bounded number of nodes at a time.
 class TraceableDB : public dev::OverlayDB {
  public:
-  explicit TraceableDB(const std::string& dbName)
-      : dev::OverlayDB(dbName), m_purgeDB(dbName + "_purge") {}
-  ~TraceableDB() = default;
+  explicit TraceableDB(const std::string& dbName, size_t nodeCacheBytes = 0);
+  ~TraceableDB();
   bool commit(const uint64_t& dsBlockNum);
 
  private:
   LevelDB m_purgeDB;
   std::atomic<bool> m_stopSignal{false};
   std::atomic<bool> m_purgeRunning{false};
+  std::atomic<bool> m_purgePaused{false};
+
+  // Guards the _purge db and the purge state below, a commit waits for at
+  // most one purge step
+  std::mutex m_mutexPurge;
+  bool m_purgeStateLoaded = false;
+  // DS epochs that still have nodes pending purge, oldest first
+  std::set<uint64_t> m_pendingEpochs;
+  // Pending nodes written again by a later commit, with the DS epoch of that
+  // commit. They must not be deleted by the purge of an earlier epoch.
+  std::unordered_map<dev::h256, uint64_t> m_resurrected;
+  // Number of pending epochs listing each node, so that a commit can find the
+  // resurrected nodes without reading the disk
+  std::unordered_map<dev::h256, size_t> m_pendingNodes;
+
+  std::atomic<uint64_t> m_latestDSBlockNum{0};
+  std::atomic<uint64_t> m_purgedNodes{0};
+  std::atomic<uint64_t> m_oldestPendingEpoch{0};
+  std::atomic<uint64_t> m_numPendingEpochs{0};
+
+  std::thread m_purgeWorker;
+  std::mutex m_mutexPurgeWorker;
+  std::condition_variable m_cvPurgeWorker;
+  // Signalled by the worker after each purge step
+  std::condition_variable m_cvPurgeProgress;
+  bool m_stopPurgeWorker = false;
+
+  Z_I64GAUGE m_purgeStats{Z_FL::DATABASE, "trie.purge.stats",
+                          "Historical state purge progress", "units", true};
 
   bool AddPendingPurge(const uint64_t& dsBlockNum,
                        const std::vector<dev::h256>& toPurge);
-  bool ExecutePurge(const uint64_t& dsBlockNum,
-                    const std::unordered_set<dev::h256>& inserted,
-                    bool purgeAll = false);
+  bool AddResurrected(const uint64_t& dsBlockNum,
+                      const std::vector<dev::h256>& resurrected);
+  std::vector<dev::h256> FindResurrected() const;
+  void LoadPurgeState();
+  void ReleasePendingNode(const dev::h256& hash);
+  void UpdatePurgeProgress();
+
+  /// Deletes the nodes of expired epochs (of all epochs if purgeAll) until
+  /// maxNodes entries have been processed, returns the number processed
+  size_t ExecutePurge(size_t maxNodes, bool purgeAll = false);
+
+  void StartPurgeWorker();
+  void RunPurgeWorker();
 
  public:
   void DetachedExecutePurge();
@@ -48,6 +98,17 @@ class TraceableDB : public dev::OverlayDB {
 
   bool IsPurgeRunning() { return m_purgeRunning; }
 
+  /// Holds back the purge, e.g. while the lookup is syncing
+  void SetPurgePaused(bool paused) { m_purgePaused = paused; }
+
+  /// Number of DS epochs whose expired nodes are still waiting to be purged
+  uint64_t GetPurgeLag() const;
+
+  /// Waits until the worker has purged all expired epochs, returns false if
+  /// that did not happen within timeout
+  bool WaitForPurge(std::chrono::milliseconds timeout);
+
+  void ResetDB();
   bool RefreshDB();
 };
 
@@ -28,6 +28,7 @@
 #include "libCrypto/Sha2.h"
 #include "libMediator/Mediator.h"
 #include "libMessage/Messenger.h"
+#include "libMetrics/EpochTimeline.h"
 #include "libNetwork/Blacklist.h"
 #include "libNetwork/Guard.h"
 #include "libNetwork/P2P.h"
@@ -605,6 +606,7 @@ void DirectoryService::ProcessDSBlockConsensusWhenDone() {
   }
 
   LOG_EPOCH(INFO, m_mediator.m_currentEpochNum, "DSBlock consensus DONE");
+  EpochTimeline::GetInstance().End(EpochPhase::DS_CONSENSUS);
 
   lock_guard<mutex> g(m_mediator.m_node->m_mutexDSBlock);
 
@@ -27,6 +27,7 @@
 #include "libCrypto/Sha2.h"
 #include "libMediator/Mediator.h"
 #include "libMessage/Messenger.h"
+#include "libMetrics/EpochTimeline.h"
 #include "libNetwork/Blacklist.h"
 #include "libNetwork/Guard.h"
 #include "libNode/Node.h"
@@ -1457,6 +1458,9 @@ void DirectoryService::RunConsensusOnDSBlock() {
 
   LOG_MARKER();
 
+  // Submissions received before the window expired are still counted
+  WaitForPoWVerification();
+
   LOG_EPOCH(INFO, m_mediator.m_currentEpochNum,
             "Number of PoW recvd: " << m_allPoWs.size() << ", DS PoW recvd: "
                                     << m_allDSPoWs.size());
@@ -1472,6 +1476,8 @@ void DirectoryService::RunConsensusOnDSBlock() {
     SetState(DSBLOCK_CONSENSUS_PREP);
   }
 
+  EpochTimeline::GetInstance().Begin(EpochPhase::DS_CONSENSUS);
+
   // Record the performance of the coinbase rewardees to get the co-sigs
   // before the variable is cleared.
   SaveDSPerformance();
@@ -90,9 +90,22 @@ DirectoryService::DirectoryService(Mediator& mediator) : m_mediator(mediator) {
   m_viewChangeCounter = 0;
   m_forceMulticast = false;
   zil::local::variables.SetIsLeader(int(m_mode));
+  if (!LOOKUP_NODE_MODE) {
+    m_powVerifyThread =
+        std::thread(&DirectoryService::RunPoWVerification, this);
+  }
 }
 
-DirectoryService::~DirectoryService() {}
+DirectoryService::~DirectoryService() {
+  {
+    lock_guard<mutex> g(m_mutexPowVerifyQueue);
+    m_stopPowVerify = true;
+  }
+  cv_powVerifyQueue.notify_all();
+  if (m_powVerifyThread.joinable()) {
+    m_powVerifyThread.join();
+  }
+}
 
 void DirectoryService::StartSynchronization(bool clean) {
   if (LOOKUP_NODE_MODE) {
@@ -18,6 +18,11 @@
 #ifndef ZILLIQA_SRC_LIBDIRECTORYSERVICE_DIRECTORYSERVICE_H_
 #define ZILLIQA_SRC_LIBDIRECTORYSERVICE_DIRECTORYSERVICE_H_
 
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <thread>
+
 #include "libBlockchain/Block.h"
 #include "libConsensus/Consensus.h"
 #include "libData/MiningData/DSPowSolution.h"
@@ -235,6 +240,21 @@ class DirectoryService : public Executable {
   std::vector<DSPowSolution> m_powSolutions;
   std::mutex m_mutexPowSolution;
 
+  // pow submissions waiting to be verified in a batch by m_powVerifyThread
+  struct QueuedPoWSubmission {
+    DSPowSolution m_soln;
+    // Received in a packet from another DS member, so not resent in ours
+    bool m_fromPacket;
+    std::chrono::steady_clock::time_point m_queuedAt;
+  };
+  std::deque<QueuedPoWSubmission> m_powVerifyQueue;
+  size_t m_powVerifyInFlight = 0;
+  std::mutex m_mutexPowVerifyQueue;
+  std::condition_variable cv_powVerifyQueue;
+  std::condition_variable cv_powVerifyQueueDrained;
+  bool m_stopPowVerify = false;
+  std::thread m_powVerifyThread;
+
   const uint32_t RESHUFFLE_INTERVAL = 500;
 
   // Message handlers
@@ -250,7 +270,16 @@ class DirectoryService : public Executable {
       const zbytes& message, unsigned int offset, const Peer& from,
       [[gnu::unused]] const unsigned char& startByte,
       std::shared_ptr<zil::p2p::P2PServerConnection>);
-  bool VerifyPoWSubmission(const DSPowSolution& sol);
+  void QueuePoWSubmission(const DSPowSolution& sol, bool fromPacket);
+  void RunPoWVerification();
+  /// Waits until the queued pow submissions have been verified
+  bool WaitForPoWVerification();
+  std::vector<bool> VerifyPoWSubmissions(
+      const std::vector<DSPowSolution>& sols);
+  /// Checks everything but the pow itself, verifyPoW is false if the
+  /// submission is accepted without verifying it
+  bool CheckPoWSubmission(const DSPowSolution& sol, bool& verifyPoW);
+  void AddVerifiedPoWSubmission(const DSPowSolution& sol);
 
   bool ProcessDSBlockConsensus(const zbytes& message, unsigned int offset,
                                const Peer& from,
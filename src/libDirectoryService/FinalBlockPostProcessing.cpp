@@ -26,6 +26,7 @@
 #include "libData/AccountStore/AccountStore.h"
 #include "libMediator/Mediator.h"
 #include "libMessage/Messenger.h"
+#include "libMetrics/EpochTimeline.h"
 #include "libNetwork/Blacklist.h"
 #include "libNetwork/Guard.h"
 #include "libNode/Node.h"
@@ -180,6 +181,7 @@ void DirectoryService::ProcessFinalBlockConsensusWhenDone() {
             "Final block consensus DONE, committee size: "
                 << m_mediator.m_DSCommittee->size()
                 << ", shard size: " << std::size(m_shards));
+  EpochTimeline::GetInstance().End(EpochPhase::FINALBLOCK_CONSENSUS);
 
   if (m_mode == PRIMARY_DS) {
     LOG_STATE(
@@ -224,6 +226,8 @@ void DirectoryService::ProcessFinalBlockConsensusWhenDone() {
     ScillaClient::GetInstance().RestartScillaClient();
 
     auto writeStateToDisk = [this]() -> void {
+      EpochPhaseScope commitPhase(EpochPhase::STATE_COMMIT,
+                                  m_mediator.m_currentEpochNum);
       if (!AccountStore::GetInstance().MoveUpdatesToDisk(
               m_mediator.m_dsBlockChain.GetLastBlock()
                   .GetHeader()
@@ -302,12 +306,17 @@ void DirectoryService::ProcessFinalBlockConsensusWhenDone() {
   LOG_GENERAL(INFO,
               "Consensus is done, sending final block to others, ds_state: "
                   << GetStateString());
-  DataSender::GetInstance().SendDataToOthers(
-      *m_finalBlock, *m_mediator.m_DSCommittee,
-      t_shards.empty() ? m_shards : t_shards, t_microBlocks,
-      m_mediator.m_lookup->GetLookupNodes(),
-      m_mediator.m_txBlockChain.GetLastBlock().GetBlockHash(), m_consensusMyID,
-      composeFinalBlockMessageForSender, m_forceMulticast.load());
+  {
+    // The final block message carries the state delta
+    EpochPhaseScope distributionPhase(EpochPhase::STATE_DELTA_DISTRIBUTION);
+    DataSender::GetInstance().SendDataToOthers(
+        *m_finalBlock, *m_mediator.m_DSCommittee,
+        t_shards.empty() ? m_shards : t_shards, t_microBlocks,
+        m_mediator.m_lookup->GetLookupNodes(),
+        m_mediator.m_txBlockChain.GetLastBlock().GetBlockHash(),
+        m_consensusMyID, composeFinalBlockMessageForSender,
+        m_forceMulticast.load());
+  }
 
   LOG_STATE(
       "[FLBLK]["
@@ -26,6 +26,7 @@
 #include "libData/AccountStore/AccountStore.h"
 #include "libMediator/Mediator.h"
 #include "libMessage/Messenger.h"
+#include "libMetrics/EpochTimeline.h"
 #include "libNetwork/P2P.h"
 #include "libNode/Node.h"
 #include "libUtils/DataConversion.h"
@@ -1347,6 +1348,7 @@ void DirectoryService::RunConsensusOnFinalBlock(bool afterRecover) {
       return;
     }
 
+    EpochTimeline::GetInstance().Begin(EpochPhase::FINALBLOCK_CONSENSUS);
     m_mediator.m_node->m_txn_distribute_window_open = true;
 
     // If we're running consensus for the same epoch again (after view change)
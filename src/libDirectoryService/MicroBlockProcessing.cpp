@@ -19,6 +19,7 @@
 #include <thread>
 
 #include "DirectoryService.h"
+#include "libConsensus/AggregateKeyCache.h"
 #include "libCrypto/Sha2.h"
 #include "libData/AccountStore/AccountStore.h"
 #include "libMediator/Mediator.h"
@@ -35,9 +36,6 @@ bool DirectoryService::VerifyMicroBlockCoSignature(
   LOG_MARKER();
 
   const vector<bool>& B2 = microBlock.GetB2();
-  vector<PubKey> keys;
-  unsigned int index = 0;
-  unsigned int count = 0;
 
   if (m_mediator.m_DSCommittee->size() != B2.size()) {
     LOG_GENERAL(WARNING, "Mismatch: Shard(DS) size = "
@@ -46,20 +44,15 @@ bool DirectoryService::VerifyMicroBlockCoSignature(
     return false;
   }
 
-  for (const auto& ds : *m_mediator.m_DSCommittee) {
-    if (B2.at(index)) {
-      keys.emplace_back(ds.first);
-      count++;
-    }
-    index++;
-  }
-
+  const unsigned int count = std::count(B2.begin(), B2.end(), true);
   if (count != ConsensusCommon::NumForConsensus(B2.size())) {
     LOG_GENERAL(WARNING, "Cosig was not generated by enough nodes");
     return false;
   }
 
-  shared_ptr<PubKey> aggregatedKey = MultiSig::AggregatePubKeys(keys);
+  shared_ptr<const PubKey> aggregatedKey =
+      AggregateKeyCache::GetInstance().GetAggregatedKey(
+          *m_mediator.m_DSCommittee, B2);
   if (aggregatedKey == nullptr) {
     LOG_GENERAL(WARNING, "Aggregated key generation failed");
     return false;
@@ -76,8 +69,12 @@ bool DirectoryService::VerifyMicroBlockCoSignature(
   if (!MultiSig::MultiSigVerify(message, 0, message.size(), microBlock.GetCS2(),
                                 *aggregatedKey)) {
     LOG_GENERAL(WARNING, "Cosig verification failed");
-    for (auto& kv : keys) {
-      LOG_GENERAL(WARNING, kv);
+    unsigned int index = 0;
+    for (auto const& kv : *m_mediator.m_DSCommittee) {
+      if (B2.at(index)) {
+        LOG_GENERAL(WARNING, kv.first);
+      }
+      index++;
     }
     return false;
   }
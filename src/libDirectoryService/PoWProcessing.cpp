@@ -24,6 +24,7 @@
 #include "common/Messages.h"
 #include "common/Serializable.h"
 #include "libMediator/Mediator.h"
+#include "libMetrics/Api.h"
 #include "libMessage/Messenger.h"
 #include "libNetwork/Guard.h"
 #include "libNetwork/P2P.h"
@@ -32,12 +33,70 @@
 #include "libUtils/DetachedFunction.h"
 #include "libUtils/Logger.h"
 
+namespace zil {
+namespace local {
+
+class PoWVerifyVariables {
+  std::atomic<uint64_t> queueSize{};
+  std::atomic<uint64_t> lastBatchSize{};
+  std::atomic<uint64_t> lastBatchMs{};
+  std::atomic<uint64_t> lastQueueLatencyMs{};
+  std::atomic<uint64_t> verified{};
+  std::atomic<uint64_t> rejected{};
+
+ public:
+  std::unique_ptr<Z_I64GAUGE> temp;
+
+  void SetQueueSize(uint64_t size) {
+    Init();
+    queueSize = size;
+  }
+
+  void SetBatch(uint64_t size, uint64_t ms, uint64_t queueLatencyMs) {
+    Init();
+    lastBatchSize = size;
+    lastBatchMs = ms;
+    lastQueueLatencyMs = queueLatencyMs;
+  }
+
+  void AddResults(uint64_t verifiedCount, uint64_t rejectedCount) {
+    Init();
+    verified += verifiedCount;
+    rejected += rejectedCount;
+  }
+
+  void Init() {
+    if (!temp) {
+      temp = std::make_unique<Z_I64GAUGE>(Z_FL::BLOCKS, "ds.powverify.gauge",
+                                          "DS PoW submission verification",
+                                          "calls", true);
+
+      temp->SetCallback([this](auto&& result) {
+        result.Set(queueSize.load(), {{"counter", "QueueSize"}});
+        result.Set(lastBatchSize.load(), {{"counter", "LastBatchSize"}});
+        result.Set(lastBatchMs.load(), {{"counter", "LastBatchMs"}});
+        result.Set(lastQueueLatencyMs.load(),
+                   {{"counter", "LastQueueLatencyMs"}});
+        result.Set(verified.load(), {{"counter", "Verified"}});
+        result.Set(rejected.load(), {{"counter", "Rejected"}});
+      });
+    }
+  }
+};
+
+static PoWVerifyVariables variables{};
+
+}  // namespace local
+}  // namespace zil
+
 using namespace std;
 using namespace boost::multiprecision;
 
 bool DirectoryService::SendPoWPacketSubmissionToOtherDSComm() {
   LOG_MARKER();
 
+  WaitForPoWVerification();
+
   zbytes powpacketmessage = {MessageType::DIRECTORY,
                              DSInstructionType::POWPACKETSUBMISSION};
 
@@ -119,7 +178,7 @@ bool DirectoryService::ProcessPoWPacketSubmission(
       LOG_GENERAL(INFO, "Too late");
       break;
     }
-    VerifyPoWSubmission(sol);
+    QueuePoWSubmission(sol, true);
   }
 
   return true;
@@ -238,33 +297,126 @@ bool DirectoryService::ProcessPoWSubmission(
                         lookupId, gasPrice,
                         std::make_pair(govProposalId, govVoteValue), signature);
 
-  if (VerifyPoWSubmission(powSoln)) {
-    std::unique_lock<std::mutex> lk(m_mutexPowSolution);
-    auto submittedNumber =
-        std::count_if(m_powSolutions.begin(), m_powSolutions.end(),
-                      [&submitterKey](const DSPowSolution& soln) {
-                        return submitterKey == soln.GetSubmitterKey();
-                      });
-    if (submittedNumber >= POW_SUBMISSION_LIMIT) {
-      LOG_EPOCH(WARNING, m_mediator.m_currentEpochNum,
-                "Node " << submitterKey
-                        << " submitted pow count already reach limit");
-      return false;
+  QueuePoWSubmission(powSoln, false);
+
+  return true;
+}
+
+void DirectoryService::QueuePoWSubmission(const DSPowSolution& sol,
+                                          bool fromPacket) {
+  size_t queueSize;
+  {
+    lock_guard<mutex> g(m_mutexPowVerifyQueue);
+    m_powVerifyQueue.push_back(
+        QueuedPoWSubmission{sol, fromPacket, chrono::steady_clock::now()});
+    queueSize = m_powVerifyQueue.size();
+  }
+  cv_powVerifyQueue.notify_one();
+  zil::local::variables.SetQueueSize(queueSize);
+}
+
+void DirectoryService::RunPoWVerification() {
+  while (true) {
+    vector<QueuedPoWSubmission> batch;
+    size_t queueSize;
+    {
+      unique_lock<mutex> lk(m_mutexPowVerifyQueue);
+      cv_powVerifyQueue.wait(lk, [this] {
+        return m_stopPowVerify || !m_powVerifyQueue.empty();
+      });
+      if (m_stopPowVerify) {
+        return;
+      }
+
+      const size_t batchSize =
+          min<size_t>(max(1u, POW_VERIFY_BATCH_SIZE), m_powVerifyQueue.size());
+      move(m_powVerifyQueue.begin(), m_powVerifyQueue.begin() + batchSize,
+           back_inserter(batch));
+      m_powVerifyQueue.erase(m_powVerifyQueue.begin(),
+                             m_powVerifyQueue.begin() + batchSize);
+      m_powVerifyInFlight = batch.size();
+      queueSize = m_powVerifyQueue.size();
+    }
+    zil::local::variables.SetQueueSize(queueSize);
+
+    const auto start = chrono::steady_clock::now();
+    auto elapsedMs = [](chrono::steady_clock::time_point from) {
+      return chrono::duration_cast<chrono::milliseconds>(
+                 chrono::steady_clock::now() - from)
+          .count();
+    };
+    // The batch is taken in arrival order, so its first entry waited longest
+    const auto queueLatencyMs = elapsedMs(batch.front().m_queuedAt);
+
+    vector<DSPowSolution> sols;
+    sols.reserve(batch.size());
+    for (const auto& queued : batch) {
+      sols.emplace_back(queued.m_soln);
     }
-    m_powSolutions.emplace_back(powSoln);
+    const auto results = VerifyPoWSubmissions(sols);
+
+    uint64_t verifiedCount = 0;
+    for (size_t i = 0; i < batch.size(); ++i) {
+      if (!results[i]) {
+        continue;
+      }
+      ++verifiedCount;
+      if (batch[i].m_fromPacket) {
+        continue;
+      }
+
+      const auto& submitterKey = sols[i].GetSubmitterKey();
+      lock_guard<mutex> g(m_mutexPowSolution);
+      auto submittedNumber =
+          count_if(m_powSolutions.begin(), m_powSolutions.end(),
+                   [&submitterKey](const DSPowSolution& soln) {
+                     return submitterKey == soln.GetSubmitterKey();
+                   });
+      if (submittedNumber >= POW_SUBMISSION_LIMIT) {
+        LOG_EPOCH(WARNING, m_mediator.m_currentEpochNum,
+                  "Node " << submitterKey
+                          << " submitted pow count already reach limit");
+        continue;
+      }
+      m_powSolutions.emplace_back(sols[i]);
+    }
+
+    zil::local::variables.SetBatch(batch.size(), elapsedMs(start),
+                                   queueLatencyMs);
+    zil::local::variables.AddResults(verifiedCount,
+                                     batch.size() - verifiedCount);
+
+    {
+      lock_guard<mutex> g(m_mutexPowVerifyQueue);
+      m_powVerifyInFlight = 0;
+    }
+    cv_powVerifyQueueDrained.notify_all();
   }
+}
 
+bool DirectoryService::WaitForPoWVerification() {
+  unique_lock<mutex> lk(m_mutexPowVerifyQueue);
+  if (!cv_powVerifyQueueDrained.wait_for(
+          lk, chrono::seconds(POW_SUBMISSION_TIMEOUT), [this] {
+            return m_powVerifyQueue.empty() && m_powVerifyInFlight == 0;
+          })) {
+    LOG_GENERAL(WARNING, "Timed out waiting for "
+                             << m_powVerifyQueue.size() + m_powVerifyInFlight
+                             << " queued pow submissions");
+    return false;
+  }
   return true;
 }
 
-bool DirectoryService::VerifyPoWSubmission(const DSPowSolution& sol) {
+vector<bool> DirectoryService::VerifyPoWSubmissions(
+    const vector<DSPowSolution>& sols) {
   LOG_MARKER();
 
   if (LOOKUP_NODE_MODE) {
     LOG_GENERAL(WARNING,
-                "DirectoryService::VerifyPoWSubmission not expected to be "
+                "DirectoryService::VerifyPoWSubmissions not expected to be "
                 "called from LookUp node.");
-    return true;
+    return vector<bool>(sols.size(), true);
   }
 
   if (m_state == FINALBLOCK_CONSENSUS) {
@@ -279,6 +431,69 @@ bool DirectoryService::VerifyPoWSubmission(const DSPowSolution& sol) {
     LOG_EPOCH(INFO, m_mediator.m_currentEpochNum, "State transition completed");
   }
 
+  vector<bool> results(sols.size(), false);
+  vector<PoWVerifyRequest> requests;
+  vector<size_t> requestIndexes;
+  for (size_t i = 0; i < sols.size(); ++i) {
+    bool verifyPoW = false;
+    if (!CheckPoWSubmission(sols[i], verifyPoW)) {
+      continue;
+    }
+    if (!verifyPoW) {
+      results[i] = true;
+      continue;
+    }
+
+    const auto& sol = sols[i];
+    requests.emplace_back(PoWVerifyRequest{
+        sol.GetBlockNumber(), sol.GetDifficultyLevel(),
+        POW::GenHeaderHash(m_mediator.m_dsBlockRand, m_mediator.m_txBlockRand,
+                           sol.GetSubmitterPeer(), sol.GetSubmitterKey(),
+                           sol.GetLookupId(), sol.GetGasPrice(),
+                           sol.GetExtraData()),
+        sol.GetNonce(), sol.GetResultingHash(), sol.GetMixHash()});
+    requestIndexes.emplace_back(i);
+  }
+
+  const auto verified = POW::GetInstance().PoWVerifyBatch(requests);
+
+  for (size_t r = 0; r < requests.size(); ++r) {
+    const auto& sol = sols[requestIndexes[r]];
+    if (verified[r]) {
+      // Do another check on the state before accessing m_allPoWs
+      // Accept slightly late entries as we need to multicast the DSBLOCK to
+      // everyone if ((m_state != POW_SUBMISSION) && (m_state !=
+      // DSBLOCK_CONSENSUS_PREP))
+      if (CheckState(VERIFYPOW)) {
+        // Earlier submissions of the same batch may have used up the limit
+        if (CheckPoWSubmissionExceedsLimitsForNode(sol.GetSubmitterKey())) {
+          LOG_GENERAL(WARNING, "Max PoW sent");
+          continue;
+        }
+        AddVerifiedPoWSubmission(sol);
+      }
+      results[requestIndexes[r]] = true;
+    } else {
+      string rand1Str, rand2Str;
+      DataConversion::charArrToHexStr(m_mediator.m_dsBlockRand, rand1Str);
+      DataConversion::charArrToHexStr(m_mediator.m_txBlockRand, rand2Str);
+      LOG_GENERAL(INFO, "[Invalid PoW] Block: "
+                            << sol.GetBlockNumber() << " Diff: "
+                            << to_string(sol.GetDifficultyLevel())
+                            << " Nonce: " << sol.GetNonce()
+                            << " IP: " << sol.GetSubmitterPeer()
+                            << " Rand1: " << rand1Str
+                            << " Rand2: " << rand2Str);
+    }
+  }
+
+  return results;
+}
+
+bool DirectoryService::CheckPoWSubmission(const DSPowSolution& sol,
+                                          bool& verifyPoW) {
+  verifyPoW = false;
+
   if (!CheckState(PROCESS_POWSUBMISSION)) {
     return false;
   }
@@ -287,12 +502,6 @@ bool DirectoryService::VerifyPoWSubmission(const DSPowSolution& sol) {
   uint64_t blockNumber = sol.GetBlockNumber();
   Peer submitterPeer = sol.GetSubmitterPeer();
   PubKey submitterPubKey = sol.GetSubmitterKey();
-  uint64_t nonce = sol.GetNonce();
-  const string& resultingHash = sol.GetResultingHash();
-  const string& mixHash = sol.GetMixHash();
-  const zbytes& extraData = sol.GetExtraData();
-  uint32_t lookupId = sol.GetLookupId();
-  const uint128_t& gasPrice = sol.GetGasPrice();
   const uint32_t& govProposalId = sol.GetGovProposalId();
   const uint32_t& govVoteValue = sol.GetGovVoteValue();
 
@@ -328,10 +537,6 @@ bool DirectoryService::VerifyPoWSubmission(const DSPowSolution& sol) {
     return false;
   }
 
-  // Define the PoW parameters
-  array<unsigned char, 32> rand1 = m_mediator.m_dsBlockRand;
-  array<unsigned char, 32> rand2 = m_mediator.m_txBlockRand;
-
   LOG_GENERAL(INFO, "Block = " << blockNumber);
   uint8_t expectedDSDiff = DS_POW_DIFFICULTY;
   uint8_t expectedDiff = POW_DIFFICULTY;
@@ -383,74 +588,54 @@ bool DirectoryService::VerifyPoWSubmission(const DSPowSolution& sol) {
     }
   }
 
-  // m_timespec = r_timer_start();
-
-  auto headerHash =
-      POW::GenHeaderHash(rand1, rand2, submitterPeer, submitterPubKey, lookupId,
-                         gasPrice, extraData);
-  bool result = POW::GetInstance().PoWVerify(
-      blockNumber, difficultyLevel, headerHash, nonce, resultingHash, mixHash);
-
-  // LOG_GENERAL(INFO, "[POWSTAT] " << r_timer_end(m_timespec));
-
-  if (result) {
-    // Do another check on the state before accessing m_allPoWs
-    // Accept slightly late entries as we need to multicast the DSBLOCK to
-    // everyone if ((m_state != POW_SUBMISSION) && (m_state !=
-    // DSBLOCK_CONSENSUS_PREP))
-    if (CheckState(VERIFYPOW)) {
-      // LOG_GENERAL(INFO, "Verified OK");
-      lock(m_mutexAllPOW, m_mutexAllPoWConns);
-      lock_guard<mutex> g(m_mutexAllPOW, adopt_lock);
-      lock_guard<mutex> g2(m_mutexAllPoWConns, adopt_lock);
-
-      array<uint8_t, 32> resultingHashArr{}, mixHashArr{};
-      DataConversion::HexStrToStdArray(resultingHash, resultingHashArr);
-      DataConversion::HexStrToStdArray(mixHash, mixHashArr);
-      PoWSolution soln(nonce, resultingHashArr, mixHashArr, lookupId, gasPrice,
-                       std::make_pair(govProposalId, govVoteValue), extraData);
-
-      m_allPoWConns.emplace(submitterPubKey, submitterPeer);
-      if (m_allPoWs.find(submitterPubKey) == m_allPoWs.end()) {
-        m_allPoWs[submitterPubKey] = soln;
-      } else if (m_allPoWs[submitterPubKey].m_result > soln.m_result) {
-        // string harderSolnStr, oldSolnStr;
-        // DataConversion::charArrToHexStr(soln.result, harderSolnStr);
-        // DataConversion::charArrToHexStr(m_allPoWs[submitterPubKey].result,
-        // oldSolnStr);
-        LOG_GENERAL(INFO, "Replaced");
-        m_allPoWs[submitterPubKey] = soln;
-      } else if (m_allPoWs[submitterPubKey].m_result == soln.m_result) {
-        LOG_GENERAL(INFO, "Duplicated");
-        return true;
-      }
+  verifyPoW = true;
+  return true;
+}
 
-      uint8_t expectedDSDiff = DS_POW_DIFFICULTY;
-      if (blockNumber > 1) {
-        expectedDSDiff = m_mediator.m_dsBlockChain.GetLastBlock()
-                             .GetHeader()
-                             .GetDSDifficulty();
-      }
+void DirectoryService::AddVerifiedPoWSubmission(const DSPowSolution& sol) {
+  const PubKey& submitterPubKey = sol.GetSubmitterKey();
+
+  lock(m_mutexAllPOW, m_mutexAllPoWConns);
+  lock_guard<mutex> g(m_mutexAllPOW, adopt_lock);
+  lock_guard<mutex> g2(m_mutexAllPoWConns, adopt_lock);
+
+  array<uint8_t, 32> resultingHashArr{}, mixHashArr{};
+  DataConversion::HexStrToStdArray(sol.GetResultingHash(), resultingHashArr);
+  DataConversion::HexStrToStdArray(sol.GetMixHash(), mixHashArr);
+  PoWSolution soln(
+      sol.GetNonce(), resultingHashArr, mixHashArr, sol.GetLookupId(),
+      sol.GetGasPrice(),
+      std::make_pair(sol.GetGovProposalId(), sol.GetGovVoteValue()),
+      sol.GetExtraData());
+
+  m_allPoWConns.emplace(submitterPubKey, sol.GetSubmitterPeer());
+  if (m_allPoWs.find(submitterPubKey) == m_allPoWs.end()) {
+    m_allPoWs[submitterPubKey] = soln;
+  } else if (m_allPoWs[submitterPubKey].m_result > soln.m_result) {
+    // string harderSolnStr, oldSolnStr;
+    // DataConversion::charArrToHexStr(soln.result, harderSolnStr);
+    // DataConversion::charArrToHexStr(m_allPoWs[submitterPubKey].result,
+    // oldSolnStr);
+    LOG_GENERAL(INFO, "Replaced");
+    m_allPoWs[submitterPubKey] = soln;
+  } else if (m_allPoWs[submitterPubKey].m_result == soln.m_result) {
+    LOG_GENERAL(INFO, "Duplicated");
+    return;
+  }
 
-      // Push the same solution into the DS PoW list if it qualifies
-      if (difficultyLevel >= expectedDSDiff) {
-        AddDSPoWs(submitterPubKey, soln);
-      }
+  uint8_t expectedDSDiff = DS_POW_DIFFICULTY;
+  if (sol.GetBlockNumber() > 1) {
+    expectedDSDiff = m_mediator.m_dsBlockChain.GetLastBlock()
+                         .GetHeader()
+                         .GetDSDifficulty();
+  }
 
-      UpdatePoWSubmissionCounterforNode(submitterPubKey);
-    }
-  } else {
-    string rand1Str, rand2Str;
-    DataConversion::charArrToHexStr(rand1, rand1Str);
-    DataConversion::charArrToHexStr(rand2, rand2Str);
-    LOG_GENERAL(INFO, "[Invalid PoW] Block: "
-                          << blockNumber
-                          << " Diff: " << to_string(difficultyLevel)
-                          << " Nonce: " << nonce << " IP: " << submitterPeer
-                          << " Rand1: " << rand1Str << " Rand2: " << rand2Str);
+  // Push the same solution into the DS PoW list if it qualifies
+  if (sol.GetDifficultyLevel() >= expectedDSDiff) {
+    AddDSPoWs(submitterPubKey, soln);
   }
 
-  return result;
+  UpdatePoWSubmissionCounterforNode(submitterPubKey);
 }
 
 bool DirectoryService::CheckSolnFromNonDSCommittee(
@@ -23,6 +23,7 @@
 #include "common/Constants.h"
 #include "common/Messages.h"
 #include "common/Serializable.h"
+#include "libConsensus/AggregateKeyCache.h"
 #include "libMediator/Mediator.h"
 #include "libMessage/Messenger.h"
 #include "libNetwork/Guard.h"
@@ -79,18 +80,10 @@ void DirectoryService::ProcessViewChangeConsensusWhenDone() {
   LOG_EPOCH(INFO, m_mediator.m_currentEpochNum, "View change consensus DONE");
   m_pendingVCBlock->SetCoSignatures(ConsensusObjectToCoSig(*m_consensusObject));
 
-  unsigned int index = 0;
-
-  vector<PubKey> keys;
-  for (auto const& kv : *m_mediator.m_DSCommittee) {
-    if (m_pendingVCBlock->GetB2().at(index)) {
-      keys.emplace_back(kv.first);
-    }
-    index++;
-  }
-
   // Verify cosig against vcblock
-  shared_ptr<PubKey> aggregatedKey = MultiSig::AggregatePubKeys(keys);
+  shared_ptr<const PubKey> aggregatedKey =
+      AggregateKeyCache::GetInstance().GetAggregatedKey(
+          *m_mediator.m_DSCommittee, m_pendingVCBlock->GetB2());
   if (aggregatedKey == nullptr) {
     LOG_GENERAL(WARNING, "Aggregated key generation failed");
     return;
@@ -106,8 +99,12 @@ void DirectoryService::ProcessViewChangeConsensusWhenDone() {
   if (!MultiSig::MultiSigVerify(message, 0, message.size(),
                                 m_pendingVCBlock->GetCS2(), *aggregatedKey)) {
     LOG_GENERAL(WARNING, "cosig verification fail");
-    for (auto& kv : keys) {
-      LOG_GENERAL(WARNING, kv);
+    unsigned int index = 0;
+    for (auto const& kv : *m_mediator.m_DSCommittee) {
+      if (m_pendingVCBlock->GetB2().at(index)) {
+        LOG_GENERAL(WARNING, kv.first);
+      }
+      index++;
     }
     return;
   }
@@ -588,9 +588,9 @@ Json::Value GetLogsFromReceipt(const TransactionReceipt &receipt) {
 
 std::pair<Json::Value, Json::Value> GetErrorsAndExceptionsFromReceipt(
     const TransactionReceipt &receipt) {
-  const auto errors = receipt.GetJsonValue().get("errors", Json::arrayValue);
-  const auto exceptions =
-      receipt.GetJsonValue().get("exceptions", Json::arrayValue);
+  const auto receiptJson = receipt.GetJsonValue();
+  const auto errors = receiptJson.get("errors", Json::arrayValue);
+  const auto exceptions = receiptJson.get("exceptions", Json::arrayValue);
   return {errors, exceptions};
 }
 
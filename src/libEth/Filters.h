@@ -98,7 +98,7 @@ class APICacheUpdate {
 
   virtual void AddCommittedTransaction(uint64_t epoch, uint32_t shard,
                                        const TxnHash &hash,
-                                       const Json::Value &receipt) = 0;
+                                       const std::string &receipt) = 0;
 };
 
 class APICache {
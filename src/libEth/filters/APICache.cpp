@@ -67,7 +67,7 @@ class APICacheImpl : public APICache, public APICacheUpdate, public TxCache {
 
   void AddCommittedTransaction(uint64_t epoch, uint32_t shard,
                                const TxnHash& hash,
-                               const Json::Value& receipt) override {
+                               const std::string& receipt) override {
     auto hash_normalized = NormalizeHexString(hash);
     m_blocksCache.AddCommittedTransaction(epoch, shard, hash_normalized,
                                           receipt);
@@ -96,7 +96,8 @@ class APICacheImpl : public APICache, public APICacheUpdate, public TxCache {
 
     m_subscriptions.OnNewHead(meta.blockHash);
     for (const auto& event : meta.meta) {
-      m_subscriptions.OnEventLog(event.address, event.topics, event.response);
+      m_subscriptions.OnEventLog(event.address, event.topics,
+                                 BlocksCache::CreateEventResponse(meta, event));
     }
 
     auto earliest = epoch > TXMETADATADEPTH ? epoch - TXMETADATADEPTH : 1;
@@ -21,6 +21,7 @@
 
 #include "FiltersUtils.h"
 #include "libEth/Eth.h"
+#include "libUtils/JsonUtils.h"
 #include "libUtils/Logger.h"
 
 namespace evmproj {
@@ -79,9 +80,15 @@ void BlocksCache::StartEpoch(uint64_t epoch, BlockHash block_hash,
 
 void BlocksCache::AddCommittedTransaction(uint64_t epoch, uint32_t shard,
                                           const TxnHash &hash,
-                                          const Json::Value &receipt) {
+                                          const std::string &receipt) {
   EpochNumber n = static_cast<EpochNumber>(epoch);
 
+  // Parsed outside the lock, only the event logs are kept
+  Json::Value receiptJson;
+  if (!JSONUtils::GetInstance().convertStrtoJson(receipt, receiptJson)) {
+    LOG_GENERAL(WARNING, "Cannot parse receipt of " << hash);
+  }
+
   UniqueLock lock(m_mutex);
 
   auto it = m_epochsInProcess.find(n);
@@ -107,7 +114,7 @@ void BlocksCache::AddCommittedTransaction(uint64_t epoch, uint32_t shard,
   std::string error;
   bool found = false;
 
-  auto logs = ExtractArrayFromJsonObj(receipt, "event_logs", error);
+  auto logs = ExtractArrayFromJsonObj(receiptJson, "event_logs", error);
   if (!error.empty()) {
     LOG_GENERAL(WARNING, "Error extracting event logs: " << error);
   }
@@ -119,6 +126,7 @@ void BlocksCache::AddCommittedTransaction(uint64_t epoch, uint32_t shard,
     item.events.emplace_back();
     auto &log = item.events.back();
 
+    log.txnHash = hash;
     log.address = ExtractStringFromJsonObj(event, ADDRESS_STR, error, found);
     if (log.address.empty()) {
       LOG_GENERAL(WARNING, "Error extracting address of event log: " << error);
@@ -139,13 +147,10 @@ void BlocksCache::AddCommittedTransaction(uint64_t epoch, uint32_t shard,
       log.topics.emplace_back(t.asString());
     }
 
-    auto data = ExtractStringFromJsonObj(event, DATA_STR, error, found);
-    if (data.empty()) {
+    log.data = ExtractStringFromJsonObj(event, DATA_STR, error, found);
+    if (log.data.empty()) {
       LOG_GENERAL(WARNING, "Error extracting event log data: " << error);
     }
-
-    log.response =
-        CreateEventResponseItem(n, hash, log.address, log.topics, data);
   }
 
   if (ctx.currentTxns >= ctx.totalTxns) {
@@ -185,9 +190,8 @@ void BlocksCache::FinalizeOneEpoch(EpochNumber n, EpochInProcess &data) {
         for (auto &e : txn.events) {
           item.meta.emplace_back(std::move(e));
           auto &event = item.meta.back();
-          event.response[LOGINDEX_STR] = NumberAsString(event_idx);
-          event.response[BLOCKHASH_STR] = item.blockHash;
-          event.response[TRANSACTIONINDEX_STR] = NumberAsString(txn_index);
+          event.logIndex = event_idx;
+          event.txnIndex = txn_index;
           ++event_idx;
         }
         ++txn_index;
@@ -197,6 +201,16 @@ void BlocksCache::FinalizeOneEpoch(EpochNumber n, EpochInProcess &data) {
   m_epochFinalizedCallback(item);
 }
 
+Json::Value BlocksCache::CreateEventResponse(const EpochMetadata &epoch,
+                                             const EventLog &log) {
+  auto response = CreateEventResponseItem(epoch.epoch, log.txnHash,
+                                          log.address, log.topics, log.data);
+  response[LOGINDEX_STR] = NumberAsString(log.logIndex);
+  response[BLOCKHASH_STR] = epoch.blockHash;
+  response[TRANSACTIONINDEX_STR] = NumberAsString(log.txnIndex);
+  return response;
+}
+
 BlocksCache::FinalizedEpochs::iterator BlocksCache::FindNext(
     EpochNumber after_epoch) {
   EpochMetadata item;
@@ -242,7 +256,7 @@ EpochNumber BlocksCache::GetEventFilterChanges(EpochNumber after_epoch,
 
     for (const auto &log : it->meta) {
       if (Match(filter, log.address, log.topics)) {
-        result.result.append(log.response);
+        result.result.append(CreateEventResponse(*it, log));
       }
     }
   }
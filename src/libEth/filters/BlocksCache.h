@@ -29,10 +29,15 @@ namespace filters {
 
 class BlocksCache {
  public:
+  /// Event log fields needed to match filters, the JSON response is only
+  /// built when the log is returned to a client
   struct EventLog {
+    TxnHash txnHash;
     Address address;
     std::vector<Quantity> topics;
-    Json::Value response;
+    std::string data;
+    size_t logIndex = 0;
+    size_t txnIndex = 0;
   };
 
   struct EpochMetadata {
@@ -55,7 +60,11 @@ class BlocksCache {
                   uint32_t num_txns);
 
   void AddCommittedTransaction(uint64_t epoch, uint32_t shard,
-                               const TxnHash &hash, const Json::Value &receipt);
+                               const TxnHash &hash, const std::string &receipt);
+
+  /// Renders the eth_getLogs response item of an event log
+  static Json::Value CreateEventResponse(const EpochMetadata &epoch,
+                                         const EventLog &log);
 
   EpochNumber GetEventFilterChanges(EpochNumber after_epoch,
                                     const EventFilterParams &filter,
@@ -165,7 +165,11 @@ TxBlockValidationMsg CheckTxBlocks(const std::vector<TxBlock>& txBlocks,
 
 Lookup::Lookup(Mediator& mediator, SyncType syncType, bool multiplierSyncMode,
                PairOfKey extSeedKey)
-    : m_mediator(mediator) {
+    : m_mediator(mediator),
+      m_stateDeltasSyncPipeline(
+          "statedeltas", GETSTATEDELTAS_WINDOW, GETSTATEDELTAS_CHUNK_SIZE,
+          chrono::seconds(GETSTATEDELTAS_TIMEOUT_IN_SECONDS),
+          RETRY_GETSTATEDELTAS_COUNT) {
   m_syncType.store(SyncType::NO_SYNC);
   MULTIPLIER_SYNC_MODE = multiplierSyncMode;
   LOG_GENERAL(INFO, "MULTIPLIER_SYNC_MODE is set to " << MULTIPLIER_SYNC_MODE);
@@ -1034,22 +1038,44 @@ bool Lookup::GetStateDeltaFromSeedNodes(const uint64_t& blockNum)
   return true;
 }
 
-bool Lookup::GetStateDeltasFromSeedNodes(uint64_t lowBlockNum,
-                                         uint64_t highBlockNum)
+VectorOfPeer Lookup::GetStateDeltasSources() const {
+  VectorOfPeer sources;
+  const auto addSource = [&sources](const Peer& peer) {
+    sources.emplace_back(peer.GetIpAddress(), peer.GetListenPortHost(),
+                         peer.GetHostname());
+  };
 
-{
   if (m_syncType == SyncType::LOOKUP_SYNC) {
-    SendMessageToRandomLookupNode(
-        ComposeGetStateDeltasMessage(lowBlockNum, highBlockNum));
+    lock_guard<mutex> lock(m_mutexLookupNodes);
+    // To avoid sending message to multiplier and himself
+    for (const auto& node : m_lookupNodes) {
+      if (none_of(m_multipliers.begin(), m_multipliers.end(),
+                  [&node](const PairOfNode& mult) {
+                    return node.second == mult.second;
+                  }) &&
+          node.second != m_mediator.m_selfPeer) {
+        addSource(node.second);
+      }
+    }
   } else if (LOOKUP_NODE_MODE && ARCHIVAL_LOOKUP && !MULTIPLIER_SYNC_MODE) {
-    SendMessageToRandomL2lDataProvider(
-        ComposeGetStateDeltasMessage(lowBlockNum, highBlockNum));
+    lock_guard<mutex> lock(m_mutexL2lDataProviders);
+    for (const auto& node : m_l2lDataProviders) {
+      addSource(node.second);
+    }
   } else {
-    SendMessageToRandomSeedNode(
-        ComposeGetStateDeltasMessage(lowBlockNum, highBlockNum));
+    lock_guard<mutex> lock(m_mutexSeedNodes);
+    for (const auto& node : m_seedNodes) {
+      if (!Blacklist::GetInstance().Exist({node.second.GetIpAddress(),
+                                           node.second.GetListenPortHost(),
+                                           node.second.GetNodeIndentifier()}) &&
+          (m_mediator.m_selfPeer.GetIpAddress() !=
+           node.second.GetIpAddress())) {
+        addSource(node.second);
+      }
+    }
   }
 
-  return true;
+  return sources;
 }
 
 bool Lookup::SetDSCommitteInfo(bool replaceMyPeerWithDefault) {
@@ -3179,28 +3205,32 @@ bool Lookup::CommitTxBlocks(const vector<TxBlock>& txBlocks) {
   uint64_t highBlockNum = txBlocks.back().GetHeader().GetBlockNum();
   bool placeholder = false;
   if (m_syncType != SyncType::RECOVERY_ALL_SYNC) {
-    unsigned int retry = 1;
-    while (retry <= RETRY_GETSTATEDELTAS_COUNT) {
-      {
-        std::unique_lock<std::mutex> cv_lk(m_mutexSetStateDeltasFromSeed);
-        m_setStateDeltasFromSeedSignal = false;
-      }
-      // Get the state-delta for all txBlocks from random lookup nodes
-      GetStateDeltasFromSeedNodes(lowBlockNum, highBlockNum);
-      std::unique_lock<std::mutex> cv_lk(m_mutexSetStateDeltasFromSeed);
-      if (!cv_setStateDeltasFromSeed.wait_for(
-              cv_lk, std::chrono::seconds(GETSTATEDELTAS_TIMEOUT_IN_SECONDS),
-              [this]() { return m_setStateDeltasFromSeedSignal; })) {
-        LOG_GENERAL(
-            WARNING,
-            "[Retry: " << retry
-                       << "] Didn't receive statedeltas! Will try again");
-        retry++;
-      } else {
-        break;
+    const bool whitelistSources =
+        (m_syncType == SyncType::LOOKUP_SYNC) ||
+        (LOOKUP_NODE_MODE && ARCHIVAL_LOOKUP && !MULTIPLIER_SYNC_MODE);
+    const auto sendRequest = [this, whitelistSources](const Peer& source,
+                                                      uint64_t low,
+                                                      uint64_t high) {
+      if (whitelistSources) {
+        Blacklist::GetInstance().Whitelist(
+            {source.GetIpAddress(), source.GetListenPortHost(), ""});
       }
-    }
-    if (retry > RETRY_GETSTATEDELTAS_COUNT) {
+      LOG_GENERAL(INFO, "Requesting state-deltas " << low << "-" << high
+                                                   << " from " << source);
+      zil::p2p::GetInstance().SendMessage(
+          nullptr, source, ComposeGetStateDeltasMessage(low, high));
+    };
+    const auto applyDeltas = [this, highBlockNum](
+                                 uint64_t low, [[maybe_unused]] uint64_t high,
+                                 const vector<zbytes>& stateDeltas) {
+      return ApplyStateDeltas(low, highBlockNum, stateDeltas);
+    };
+
+    // Get the state-deltas for all txBlocks, several ranges at a time and
+    // from several lookups, and apply them in order
+    if (!m_stateDeltasSyncPipeline.Run(lowBlockNum, highBlockNum,
+                                       GetStateDeltasSources(), sendRequest,
+                                       applyDeltas)) {
       LOG_GENERAL(WARNING, "Failed to receive state-deltas for txBlks: "
                                << lowBlockNum << "-" << highBlockNum);
       cv_setTxBlockFromSeed.notify_all();
@@ -3587,14 +3617,9 @@ bool Lookup::ProcessSetStateDeltasFromSeed(
     [[gnu::unused]] const unsigned char& startByte,
     std::shared_ptr<zil::p2p::P2PServerConnection>) {
   if (AlreadyJoinedNetwork()) {
-    {
-      unique_lock<std::mutex> lock(m_mutexSetStateDeltasFromSeed);
-      m_setStateDeltasFromSeedSignal = true;
-    }
-    cv_setStateDeltasFromSeed.notify_all();
+    m_stateDeltasSyncPipeline.Finish();
     return true;
   }
-  unique_lock<std::mutex> lock(m_mutexSetStateDeltasFromSeed);
 
   uint64_t lowBlockNum = 0;
   uint64_t highBlockNum = 0;
@@ -3621,14 +3646,14 @@ bool Lookup::ProcessSetStateDeltasFromSeed(
                 << from << " for blocks: " << lowBlockNum << " to "
                 << highBlockNum);
 
-  if (stateDeltas.size() != (highBlockNum - lowBlockNum + 1)) {
-    LOG_GENERAL(WARNING,
-                "StateDeltas recvd:" << stateDeltas.size() << " , Expected: "
-                                     << highBlockNum - lowBlockNum + 1);
-    return false;
-  }
+  // The pipeline checks the range was requested and applies it in order
+  return m_stateDeltasSyncPipeline.OnResponse(lowBlockNum, highBlockNum,
+                                              std::move(stateDeltas));
+}
 
-  int txBlkNum = lowBlockNum;
+bool Lookup::ApplyStateDeltas(uint64_t lowBlockNum, uint64_t lastBlockNum,
+                              const vector<zbytes>& stateDeltas) {
+  uint64_t txBlkNum = lowBlockNum;
   zbytes tmp;
   for (const auto& delta : stateDeltas) {
     // TBD - To verify state delta hash against one from TxBlk.
@@ -3651,7 +3676,7 @@ bool Lookup::ProcessSetStateDeltasFromSeed(
       m_prevStateRootHashTemp = AccountStore::GetInstance().GetStateRootHash();
 
       if ((txBlkNum + 1) % NUM_FINAL_BLOCK_PER_POW == 0) {
-        if (txBlkNum + NUM_FINAL_BLOCK_PER_POW > highBlockNum) {
+        if (txBlkNum + NUM_FINAL_BLOCK_PER_POW > lastBlockNum) {
           if (!AccountStore::GetInstance().MoveUpdatesToDisk(
                   txBlkNum / NUM_FINAL_BLOCK_PER_POW)) {
             LOG_GENERAL(WARNING, "AccountStore::MoveUpdatesToDisk()");
@@ -3659,12 +3684,10 @@ bool Lookup::ProcessSetStateDeltasFromSeed(
           }
         }
       }
-      txBlkNum++;
     }
+    txBlkNum++;
   }
 
-  m_setStateDeltasFromSeedSignal = true;
-  cv_setStateDeltasFromSeed.notify_all();
   return true;
 }
 
@@ -3929,15 +3952,12 @@ bool Lookup::ProcessSetTxnsFromLookup(
   LOG_GENERAL(INFO,
               "Received " << txns.size() << " txns for microblock :" << mbHash);
 
-  uint64_t epochNum = 0;
-  {
-    MicroBlockSharedPtr microBlockPtr;
-    if (!BlockStorage::GetBlockStorage().GetMicroBlock(mbHash, microBlockPtr)) {
-      LOG_GENERAL(WARNING, "Failed to get MB with hash " << mbHash);
-      return false;
-    }
-    epochNum = microBlockPtr->GetHeader().GetEpochNum();
+  MicroBlockSharedPtr microBlockPtr;
+  if (!BlockStorage::GetBlockStorage().GetMicroBlock(mbHash, microBlockPtr)) {
+    LOG_GENERAL(WARNING, "Failed to get MB with hash " << mbHash);
+    return false;
   }
+  const uint64_t epochNum = microBlockPtr->GetHeader().GetEpochNum();
 
   for (const auto& txn : txns) {
     zbytes serializedTxBody;
@@ -3952,6 +3972,10 @@ bool Lookup::ProcessSetTxnsFromLookup(
     }
   }
 
+  if (!BlockStorage::GetBlockStorage().PutTxLocations(*microBlockPtr)) {
+    LOG_GENERAL(WARNING, "BlockStorage::PutTxLocations failed " << mbHash);
+  }
+
   // Delete the mb from unavailable list here
   std::lock_guard<mutex> lock(m_mediator.m_node->m_mutexUnavailableMicroBlocks);
   auto& unavailableMBs = m_mediator.m_node->GetUnavailableMicroBlocks();
@@ -5684,6 +5708,12 @@ void Lookup::SetSyncType(SyncType syncType) {
   m_syncType.store(syncType);
   LOG_EPOCH(INFO, m_mediator.m_currentEpochNum,
             "Set sync type to " << syncType);
+
+  // The historical state purge only runs on lookups, hold it back while
+  // the node is catching up so it does not compete with the sync for disk
+  if (LOOKUP_NODE_MODE) {
+    AccountStore::GetInstance().SetPurgePaused(syncType != SyncType::NO_SYNC);
+  }
 }
 
 bool Lookup::ProcessGetDSGuardNetworkInfo(
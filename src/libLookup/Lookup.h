@@ -33,6 +33,7 @@
 #include "libBlockchain/TxBlock.h"
 #include "libData/AccountData/Transaction.h"
 #include "libData/AccountData/TransactionLite.h"
+#include "libLookup/SyncPipeline.h"
 #include "libNetwork/Executable.h"
 #include "libNetwork/ShardStruct.h"
 #include "libUtils/IPConverter.h"
@@ -115,9 +116,7 @@ class Lookup : public Executable {
   std::map<Address, uint64_t> m_gentxnAddrLatestNonceSent;
 
   // Get StateDeltas from seed
-  std::mutex m_mutexSetStateDeltasFromSeed;
-  std::condition_variable cv_setStateDeltasFromSeed;
-  bool m_setStateDeltasFromSeedSignal;
+  SyncPipeline m_stateDeltasSyncPipeline;
 
   // TxBlockBuffer
   std::vector<TxBlock> m_txBlockBuffer;
@@ -230,7 +229,10 @@ class Lookup : public Executable {
   bool GetTxBlockFromLookupNodes(uint64_t lowBlockNum, uint64_t highBlockNum);
   bool GetTxBlockFromSeedNodes(uint64_t lowBlockNum, uint64_t highBlockNum);
   bool GetStateDeltaFromSeedNodes(const uint64_t& blockNum);
-  bool GetStateDeltasFromSeedNodes(uint64_t lowBlockNum, uint64_t highBlockNum);
+
+  // Peers to request state deltas from, the same kind of peers the other
+  // block data is synced from
+  VectorOfPeer GetStateDeltasSources() const;
 
   // UNUSED
   bool ProcessGetShardFromSeed([[gnu::unused]] const zbytes& message,
@@ -414,6 +416,10 @@ class Lookup : public Executable {
       const zbytes& message, unsigned int offset, const Peer& from,
       [[gnu::unused]] const unsigned char& startByte,
       std::shared_ptr<zil::p2p::P2PServerConnection>);
+  // Applies the state deltas of the blocks from lowBlockNum on, of a sync up
+  // to lastBlockNum
+  bool ApplyStateDeltas(uint64_t lowBlockNum, uint64_t lastBlockNum,
+                        const std::vector<zbytes>& stateDeltas);
 
   bool ProcessSetLookupOffline(const zbytes& message, unsigned int offset,
                                const Peer& from,
@@ -0,0 +1,298 @@
+/*
+ * Copyright (C) 2023 Zilliqa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "SyncPipeline.h"
+
+#include <algorithm>
+#include <limits>
+
+#include "libUtils/Logger.h"
+
+using namespace std;
+
+namespace {
+
+// Weight of the latest measurement in the throughput of a source
+constexpr double THROUGHPUT_SMOOTHING = 0.3;
+
+}  // namespace
+
+SyncPipeline::SyncPipeline(const string& name, unsigned int window,
+                           uint64_t chunkSize,
+                           chrono::milliseconds requestTimeout,
+                           unsigned int maxAttempts)
+    : m_name(name),
+      m_window(max(window, 1u)),
+      m_chunkSize(max<uint64_t>(chunkSize, 1)),
+      m_requestTimeout(requestTimeout),
+      m_maxAttempts(max(maxAttempts, 1u)) {
+  m_stats.SetCallback([this](auto&& result) {
+    if (!m_stats.Enabled()) {
+      return;
+    }
+    size_t outstanding = 0;
+    size_t buffered = 0;
+    {
+      lock_guard<mutex> g(m_mutex);
+      outstanding = m_outstanding.size();
+      buffered = m_received.size();
+    }
+    result.Set(outstanding, {{"pipeline", m_name}, {"counter", "Outstanding"}});
+    result.Set(buffered, {{"pipeline", m_name}, {"counter", "Buffered"}});
+    result.Set(m_blocksApplied.load(),
+               {{"pipeline", m_name}, {"counter", "BlocksApplied"}});
+    result.Set(m_requestsSent.load(),
+               {{"pipeline", m_name}, {"counter", "RequestsSent"}});
+    result.Set(m_requestsRetried.load(),
+               {{"pipeline", m_name}, {"counter", "RequestsRetried"}});
+  });
+}
+
+bool SyncPipeline::Run(uint64_t lowBlockNum, uint64_t highBlockNum,
+                       const vector<Peer>& sources, const SendRequest& send,
+                       const ApplyRange& apply) {
+  if (lowBlockNum > highBlockNum) {
+    return true;
+  }
+  if (sources.empty()) {
+    LOG_GENERAL(WARNING, m_name << ": no source to sync from");
+    return false;
+  }
+
+  const auto startTime = chrono::steady_clock::now();
+  unique_lock<mutex> lock(m_mutex);
+  m_running = true;
+  m_aborted = false;
+  m_finished = false;
+
+  uint64_t nextToRequest = lowBlockNum;
+  uint64_t nextToApply = lowBlockNum;
+  vector<pair<Peer, pair<uint64_t, uint64_t>>> toSend;
+  bool ret = true;
+
+  while (nextToApply <= highBlockNum) {
+    if (m_aborted) {
+      LOG_GENERAL(INFO, m_name << ": aborted");
+      ret = false;
+      break;
+    }
+    if (m_finished) {
+      LOG_GENERAL(INFO, m_name << ": finished at block " << nextToApply);
+      break;
+    }
+
+    // Request again the ranges that timed out, from another source
+    const auto now = chrono::steady_clock::now();
+    for (auto& [requestLow, request] : m_outstanding) {
+      if (now - request.m_sentTime < m_requestTimeout) {
+        continue;
+      }
+      auto& stats = m_sources[request.m_source];
+      stats.m_outstanding--;
+      stats.m_failures++;
+      if (request.m_attempts >= m_maxAttempts) {
+        LOG_GENERAL(WARNING, m_name << ": failed to receive blocks "
+                                    << requestLow << "-"
+                                    << request.m_highBlockNum << " after "
+                                    << request.m_attempts << " attempts");
+        ret = false;
+        break;
+      }
+      LOG_GENERAL(INFO, m_name << ": [Retry: " << request.m_attempts
+                               << "] didn't receive blocks " << requestLow
+                               << "-" << request.m_highBlockNum << " from "
+                               << request.m_source);
+      request.m_source = PickSource(sources, &request.m_source);
+      request.m_sentTime = now;
+      request.m_attempts++;
+      m_sources[request.m_source].m_outstanding++;
+      m_requestsRetried++;
+      toSend.push_back(
+          {request.m_source, {requestLow, request.m_highBlockNum}});
+    }
+    if (!ret) {
+      break;
+    }
+
+    // Keep the window full, counting the ranges waiting to be applied
+    while (m_outstanding.size() + m_received.size() < m_window &&
+           nextToRequest <= highBlockNum) {
+      const uint64_t requestHigh =
+          min(highBlockNum, nextToRequest + m_chunkSize - 1);
+      const auto source = PickSource(sources, nullptr);
+      m_outstanding.emplace(nextToRequest,
+                            Request{requestHigh, source, now, 1});
+      m_sources[source].m_outstanding++;
+      toSend.push_back({source, {nextToRequest, requestHigh}});
+      nextToRequest = requestHigh + 1;
+    }
+
+    if (!toSend.empty()) {
+      lock.unlock();
+      for (const auto& [source, range] : toSend) {
+        send(source, range.first, range.second);
+        m_requestsSent++;
+      }
+      lock.lock();
+      toSend.clear();
+      continue;
+    }
+
+    auto receivedIt = m_received.find(nextToApply);
+    if (receivedIt != m_received.end()) {
+      const uint64_t rangeHigh = receivedIt->second.first;
+      const auto items = std::move(receivedIt->second.second);
+      m_received.erase(receivedIt);
+      lock.unlock();
+      const bool applied = apply(nextToApply, rangeHigh, items);
+      lock.lock();
+      if (!applied) {
+        LOG_GENERAL(WARNING, m_name << ": failed to apply blocks "
+                                    << nextToApply << "-" << rangeHigh);
+        ret = false;
+        break;
+      }
+      m_blocksApplied += rangeHigh - nextToApply + 1;
+      nextToApply = rangeHigh + 1;
+      continue;
+    }
+
+    // Wait for a response or for the earliest request to time out
+    auto deadline = now + m_requestTimeout;
+    for (const auto& [requestLow, request] : m_outstanding) {
+      deadline = min(deadline, request.m_sentTime + m_requestTimeout);
+    }
+    m_cv.wait_until(lock, deadline);
+  }
+
+  m_outstanding.clear();
+  m_received.clear();
+  for (auto& [source, stats] : m_sources) {
+    stats.m_outstanding = 0;
+  }
+  m_running = false;
+  lock.unlock();
+
+  const auto elapsedMs = chrono::duration_cast<chrono::milliseconds>(
+                             chrono::steady_clock::now() - startTime)
+                             .count();
+  const uint64_t numBlocks = nextToApply - lowBlockNum;
+  LOG_GENERAL(INFO, m_name << ": synced " << numBlocks << " blocks in "
+                           << elapsedMs << " ms ("
+                           << numBlocks * 1000 / max<int64_t>(elapsedMs, 1)
+                           << " blocks/s)");
+  return ret;
+}
+
+bool SyncPipeline::OnResponse(uint64_t lowBlockNum, uint64_t highBlockNum,
+                              vector<zbytes>&& items) {
+  lock_guard<mutex> g(m_mutex);
+  if (!m_running) {
+    return false;
+  }
+
+  auto it = m_outstanding.find(lowBlockNum);
+  if (it == m_outstanding.end() ||
+      it->second.m_highBlockNum != highBlockNum) {
+    LOG_GENERAL(INFO, m_name << ": no request for blocks " << lowBlockNum
+                             << "-" << highBlockNum);
+    return false;
+  }
+
+  const auto now = chrono::steady_clock::now();
+  auto& request = it->second;
+  if (items.size() != highBlockNum - lowBlockNum + 1) {
+    LOG_GENERAL(WARNING, m_name << ": received " << items.size()
+                                << " blocks from " << request.m_source
+                                << ", expected "
+                                << highBlockNum - lowBlockNum + 1);
+    // Let the request time out now so it is sent to another source
+    request.m_sentTime = now - m_requestTimeout;
+    m_cv.notify_all();
+    return false;
+  }
+
+  auto& stats = m_sources[request.m_source];
+  const double elapsedSec =
+      max(chrono::duration<double>(now - request.m_sentTime).count(), 1e-3);
+  const double blocksPerSec = items.size() / elapsedSec;
+  stats.m_blocksPerSec =
+      (stats.m_blocksPerSec == 0)
+          ? blocksPerSec
+          : (1 - THROUGHPUT_SMOOTHING) * stats.m_blocksPerSec +
+                THROUGHPUT_SMOOTHING * blocksPerSec;
+  stats.m_outstanding--;
+  stats.m_failures = 0;
+
+  m_received.emplace(lowBlockNum, make_pair(highBlockNum, std::move(items)));
+  m_outstanding.erase(it);
+  m_cv.notify_all();
+  return true;
+}
+
+void SyncPipeline::Abort() {
+  lock_guard<mutex> g(m_mutex);
+  if (m_running) {
+    m_aborted = true;
+    m_cv.notify_all();
+  }
+}
+
+void SyncPipeline::Finish() {
+  lock_guard<mutex> g(m_mutex);
+  if (m_running) {
+    m_finished = true;
+    m_cv.notify_all();
+  }
+}
+
+bool SyncPipeline::IsRunning() const {
+  lock_guard<mutex> g(m_mutex);
+  return m_running;
+}
+
+double SyncPipeline::GetThroughput(const Peer& source) const {
+  lock_guard<mutex> g(m_mutex);
+  auto it = m_sources.find(source);
+  return (it == m_sources.end()) ? 0 : it->second.m_blocksPerSec;
+}
+
+Peer SyncPipeline::PickSource(const vector<Peer>& sources,
+                              const Peer* exclude) {
+  // Prefer fast sources that are idle and haven't failed recently. Sources
+  // never measured come first so that every source gets measured, unless
+  // they never responded.
+  const Peer* best = nullptr;
+  double bestScore = -1;
+  for (const auto& source : sources) {
+    if (exclude && source == *exclude && sources.size() > 1) {
+      continue;
+    }
+    const auto& stats = m_sources[source];
+    double throughput = stats.m_blocksPerSec;
+    if (throughput == 0 && stats.m_failures == 0) {
+      throughput = numeric_limits<double>::max();
+    }
+    const double score = throughput / (1.0 + stats.m_outstanding) /
+                         (1.0 + stats.m_failures);
+    if (score > bestScore) {
+      best = &source;
+      bestScore = score;
+    }
+  }
+  return *best;
+}
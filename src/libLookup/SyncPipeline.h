@@ -0,0 +1,119 @@
+/*
+ * Copyright (C) 2023 Zilliqa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef ZILLIQA_SRC_LIBLOOKUP_SYNCPIPELINE_H_
+#define ZILLIQA_SRC_LIBLOOKUP_SYNCPIPELINE_H_
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "common/BaseType.h"
+#include "libMetrics/Api.h"
+#include "libNetwork/Peer.h"
+
+/// Fetches a range of per-block data, such as state deltas, as several
+/// smaller ranges requested in parallel from the available sources, and
+/// hands the data over strictly in block order. Ranges that arrive early are
+/// buffered, ranges that time out are requested again from another source.
+/// The throughput of every source is tracked and the fastest idle sources
+/// are preferred.
+class SyncPipeline {
+ public:
+  using SendRequest = std::function<void(
+      const Peer& source, uint64_t lowBlockNum, uint64_t highBlockNum)>;
+  using ApplyRange =
+      std::function<bool(uint64_t lowBlockNum, uint64_t highBlockNum,
+                         const std::vector<zbytes>& items)>;
+
+  /// window is the number of ranges of chunkSize blocks requested or
+  /// buffered at a time. A range is requested at most maxAttempts times.
+  SyncPipeline(const std::string& name, unsigned int window,
+               uint64_t chunkSize, std::chrono::milliseconds requestTimeout,
+               unsigned int maxAttempts);
+
+  /// Fetches [lowBlockNum, highBlockNum] from the sources and applies it in
+  /// order. Returns once everything is applied or the pipeline is finished,
+  /// or false when a range can't be fetched or applied or the pipeline is
+  /// aborted.
+  bool Run(uint64_t lowBlockNum, uint64_t highBlockNum,
+           const std::vector<Peer>& sources, const SendRequest& send,
+           const ApplyRange& apply);
+
+  /// Hands over the response to a request, returns false if it doesn't
+  /// match an outstanding request
+  bool OnResponse(uint64_t lowBlockNum, uint64_t highBlockNum,
+                  std::vector<zbytes>&& items);
+
+  void Abort();
+
+  /// Stops a running pipeline without failing it, e.g. once the node has
+  /// obtained the data another way
+  void Finish();
+
+  bool IsRunning() const;
+
+  /// Blocks per second last measured for the source, 0 if never measured
+  double GetThroughput(const Peer& source) const;
+
+ private:
+  struct Request {
+    uint64_t m_highBlockNum;
+    Peer m_source;
+    std::chrono::steady_clock::time_point m_sentTime;
+    unsigned int m_attempts;
+  };
+
+  struct SourceStats {
+    double m_blocksPerSec = 0;
+    unsigned int m_outstanding = 0;
+    unsigned int m_failures = 0;
+  };
+
+  Peer PickSource(const std::vector<Peer>& sources, const Peer* exclude);
+
+  const std::string m_name;
+  const unsigned int m_window;
+  const uint64_t m_chunkSize;
+  const std::chrono::milliseconds m_requestTimeout;
+  const unsigned int m_maxAttempts;
+
+  mutable std::mutex m_mutex;
+  std::condition_variable m_cv;
+  bool m_running = false;
+  bool m_aborted = false;
+  bool m_finished = false;
+  // Outstanding requests and received ranges, by their lowest block number
+  std::map<uint64_t, Request> m_outstanding;
+  std::map<uint64_t, std::pair<uint64_t, std::vector<zbytes>>> m_received;
+  std::unordered_map<Peer, SourceStats> m_sources;
+
+  std::atomic<uint64_t> m_blocksApplied{0};
+  std::atomic<uint64_t> m_requestsSent{0};
+  std::atomic<uint64_t> m_requestsRetried{0};
+
+  Z_I64GAUGE m_stats{Z_FL::BLOCKS, "lookup.sync_pipeline.stats",
+                     "Block data sync pipeline statistics", "units", true};
+};
+
+#endif  // ZILLIQA_SRC_LIBLOOKUP_SYNCPIPELINE_H_
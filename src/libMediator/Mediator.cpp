@@ -24,6 +24,7 @@
 #include "libEth/Filters.h"
 #include "libLookup/Lookup.h"
 #include "libMetrics/Api.h"
+#include "libMetrics/EpochTimeline.h"
 #include "libMetrics/TracedIds.h"
 #include "libNode/Node.h"
 #include "libServer/DedicatedWebsocketServer.h"
@@ -180,6 +181,9 @@ void Mediator::IncreaseEpochNum() {
   m_currentEpochNum++;
   m_isVacuousEpoch = CommonUtils::IsVacuousEpoch(m_currentEpochNum);
   zil::local::variables.SetCurrentEpochNum(m_currentEpochNum);
+  EpochTimeline::GetInstance().SetEpoch(
+      m_dsBlockChain.GetLastBlock().GetHeader().GetBlockNum(),
+      m_currentEpochNum);
 
   // Update GetWork Server info for nodes in shard
   if (GETWORK_SERVER_MINE) {
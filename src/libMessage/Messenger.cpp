@@ -8085,3 +8085,55 @@ bool Messenger::GetTxEpoch(const zbytes& src, const unsigned int offset,
 
   return true;
 }
+
+bool Messenger::SetTxLocation(zbytes& dst, const unsigned int offset,
+                              const TxLocation& location) {
+  ProtoTxLocation result;
+  result.set_blocknum(location.m_blockNum);
+  result.set_mbindex(location.m_mbIndex);
+  result.set_txindex(location.m_txIndexInMb);
+  if (location.m_txIndexInBlock) {
+    result.set_hasblockindex(true);
+    result.set_blockindex(*location.m_txIndexInBlock);
+  }
+
+  if (!result.IsInitialized()) {
+    LOG_GENERAL(WARNING, "ProtoTxLocation initialization failed");
+    return false;
+  }
+
+  return SerializeToArray(result, dst, offset);
+}
+
+bool Messenger::GetTxLocation(const zbytes& src, const unsigned int offset,
+                              TxLocation& location) {
+  if (src.size() == 0) {
+    LOG_GENERAL(INFO, "Empty TxLocation");
+    return false;
+  }
+
+  if (offset >= src.size()) {
+    LOG_GENERAL(WARNING, "Invalid data and offset, data size "
+                             << src.size() << ", offset " << offset);
+    return false;
+  }
+
+  ProtoTxLocation result;
+  result.ParseFromArray(src.data() + offset, src.size() - offset);
+
+  if (!result.IsInitialized()) {
+    LOG_GENERAL(WARNING, "ProtoTxLocation initialization failed");
+    return false;
+  }
+
+  location.m_blockNum = result.blocknum();
+  location.m_mbIndex = result.mbindex();
+  location.m_txIndexInMb = result.txindex();
+  if (result.hasblockindex()) {
+    location.m_txIndexInBlock = result.blockindex();
+  } else {
+    location.m_txIndexInBlock.reset();
+  }
+
+  return true;
+}
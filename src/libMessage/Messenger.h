@@ -24,6 +24,7 @@
 #include "common/TxnStatus.h"
 #include "libBlockchain/Block.h"
 #include "libData/AccountData/MBnForwardedTxnEntry.h"
+#include "libData/BlockChainData/TxLocation.h"
 #include "libData/CoinbaseData/CoinbaseStruct.h"
 #include "libData/MiningData/DSPowSolution.h"
 #include "libData/MiningData/MinerInfo.h"
@@ -942,5 +943,10 @@ class Messenger {
                          const uint64_t& epochNum);
   static bool GetTxEpoch(const zbytes& src, const unsigned int offset,
                          uint64_t& epochNum);
+
+  static bool SetTxLocation(zbytes& dst, const unsigned int offset,
+                            const TxLocation& location);
+  static bool GetTxLocation(const zbytes& src, const unsigned int offset,
+                            TxLocation& location);
 };
 #endif  // ZILLIQA_SRC_LIBMESSAGE_MESSENGER_H_
@@ -39,7 +39,7 @@ bool MessengerAccountStoreTrie::SetAccountStoreTrie(
 
   for (const auto& i : stateTrie) {
     ProtoAccountStore::AddressAccount* protoEntry = result.add_entries();
-    Address address(i.first);
+    Address address = GetAddressFromStateTrieKey(i.first);
     protoEntry->set_address(address.data(), address.size);
     ProtoAccount* protoEntryAccount = protoEntry->mutable_account();
 
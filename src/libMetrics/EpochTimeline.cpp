@@ -0,0 +1,153 @@
+/*
+ * Copyright (C) 2023 Zilliqa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "EpochTimeline.h"
+
+#include "libMetrics/Api.h"
+
+using namespace std;
+
+namespace {
+
+constexpr array<string_view, EpochTimeline::NUM_PHASES> PHASE_NAMES = {
+#define EPOCH_PHASE_NAME(P) #P,
+    EPOCH_PHASES(EPOCH_PHASE_NAME)
+#undef EPOCH_PHASE_NAME
+};
+
+Z_DBLHIST& GetPhaseLatency() {
+  static vector<double> latencyBoundaries{
+      0,    10,   50,    100,   250,   500,    1000,
+      2500, 5000, 10000, 30000, 60000, 120000, 300000};
+  static Z_DBLHIST histogram{Z_FL::BLOCKS, "epoch.phase.latency",
+                             latencyBoundaries, "Duration of epoch phases",
+                             "ms"};
+  return histogram;
+}
+
+}  // namespace
+
+EpochTimeline& EpochTimeline::GetInstance() {
+  static EpochTimeline timeline;
+  return timeline;
+}
+
+string_view EpochTimeline::GetPhaseName(EpochPhase phase) {
+  return PHASE_NAMES.at(static_cast<size_t>(phase));
+}
+
+void EpochTimeline::SetEpoch(uint64_t dsEpoch, uint64_t txEpoch) {
+  lock_guard<mutex> g(m_mutex);
+  m_dsEpoch = dsEpoch;
+  m_txEpoch = txEpoch;
+}
+
+uint64_t EpochTimeline::GetTxEpoch() const {
+  lock_guard<mutex> g(m_mutex);
+  return m_txEpoch;
+}
+
+void EpochTimeline::Begin(EpochPhase phase) {
+  lock_guard<mutex> g(m_mutex);
+  m_open.at(static_cast<size_t>(phase)) =
+      OpenPhase{m_dsEpoch, m_txEpoch, chrono::system_clock::now(),
+                chrono::steady_clock::now()};
+}
+
+void EpochTimeline::End(EpochPhase phase) {
+  lock_guard<mutex> g(m_mutex);
+  auto& open = m_open.at(static_cast<size_t>(phase));
+  if (!open) {
+    return;
+  }
+  RecordLocked(phase, open->m_txEpoch, open->m_dsEpoch, open->m_start,
+               chrono::duration_cast<chrono::milliseconds>(
+                   chrono::steady_clock::now() - open->m_steadyStart));
+  open.reset();
+}
+
+void EpochTimeline::Record(EpochPhase phase, uint64_t txEpoch,
+                           chrono::system_clock::time_point start,
+                           chrono::milliseconds duration) {
+  lock_guard<mutex> g(m_mutex);
+  RecordLocked(phase, txEpoch, nullopt, start, duration);
+}
+
+void EpochTimeline::RecordLocked(EpochPhase phase, uint64_t txEpoch,
+                                 optional<uint64_t> dsEpoch,
+                                 chrono::system_clock::time_point start,
+                                 chrono::milliseconds duration) {
+  if (GetPhaseLatency().Enabled()) {
+    // The phase names are literals so data() is null terminated
+    GetPhaseLatency().Record(static_cast<double>(duration.count()),
+                             {{"phase", GetPhaseName(phase).data()}});
+  }
+
+  if (txEpoch == m_txEpoch) {
+    dsEpoch = m_dsEpoch;
+  }
+
+  auto it = m_epochs.find(txEpoch);
+  if (it == m_epochs.end()) {
+    if (!dsEpoch) {
+      return;
+    }
+    if (m_epochs.size() >= MAX_EPOCHS) {
+      if (txEpoch < m_epochs.begin()->first) {
+        return;
+      }
+      m_epochs.erase(m_epochs.begin());
+    }
+    it = m_epochs.emplace(txEpoch, EpochRecord{}).first;
+    it->second.m_dsEpoch = *dsEpoch;
+    it->second.m_txEpoch = txEpoch;
+  }
+
+  auto& record = it->second.m_phases.at(static_cast<size_t>(phase));
+  if (record.m_count == 0) {
+    record.m_start = start;
+  }
+  record.m_duration += duration;
+  record.m_count++;
+}
+
+vector<EpochTimeline::EpochRecord> EpochTimeline::GetRecent(
+    size_t numEpochs) const {
+  lock_guard<mutex> g(m_mutex);
+  vector<EpochRecord> records;
+  for (auto it = m_epochs.rbegin();
+       it != m_epochs.rend() && records.size() < numEpochs; ++it) {
+    records.emplace_back(it->second);
+  }
+  return records;
+}
+
+EpochPhaseScope::EpochPhaseScope(EpochPhase phase)
+    : EpochPhaseScope(phase, EpochTimeline::GetInstance().GetTxEpoch()) {}
+
+EpochPhaseScope::EpochPhaseScope(EpochPhase phase, uint64_t txEpoch)
+    : m_phase(phase),
+      m_txEpoch(txEpoch),
+      m_start(chrono::system_clock::now()),
+      m_steadyStart(chrono::steady_clock::now()) {}
+
+EpochPhaseScope::~EpochPhaseScope() {
+  EpochTimeline::GetInstance().Record(
+      m_phase, m_txEpoch, m_start,
+      chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() -
+                                                  m_steadyStart));
+}
@@ -0,0 +1,137 @@
+/*
+ * Copyright (C) 2023 Zilliqa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef ZILLIQA_SRC_LIBMETRICS_EPOCHTIMELINE_H_
+#define ZILLIQA_SRC_LIBMETRICS_EPOCHTIMELINE_H_
+
+#include <array>
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+#define EPOCH_PHASES(M)         \
+  M(POW)                        \
+  M(DS_CONSENSUS)               \
+  M(MICROBLOCK_COMPOSITION)     \
+  M(TXN_PROCESSING)             \
+  M(FINALBLOCK_CONSENSUS)       \
+  M(CONSENSUS_ROUND_1)          \
+  M(CONSENSUS_ROUND_2)          \
+  M(STATE_COMMIT)               \
+  M(PERSISTENCE)                \
+  M(STATE_DELTA_DISTRIBUTION)
+
+enum class EpochPhase {
+#define ENUM_EPOCH_PHASE(P) P,
+  EPOCH_PHASES(ENUM_EPOCH_PHASE)
+#undef ENUM_EPOCH_PHASE
+      EPOCH_PHASE_END
+};
+
+/// Records where the wall time of the recent epochs goes, by TX epoch and
+/// phase. A phase is attributed to the epoch current when it begins, unless
+/// given one. A phase run several times in an epoch, such as persistence,
+/// adds up. Only the current epoch starts a new record, as its DS epoch is
+/// the only one known, so a phase given an older epoch without a record, e.g.
+/// persisting blocks during a sync, is left out. Every phase duration is also
+/// recorded in a histogram.
+class EpochTimeline {
+ public:
+  static constexpr size_t NUM_PHASES =
+      static_cast<size_t>(EpochPhase::EPOCH_PHASE_END);
+  static constexpr size_t MAX_EPOCHS = 256;
+
+  struct PhaseRecord {
+    // Wall clock time the phase first began, 0 if it didn't run
+    std::chrono::system_clock::time_point m_start{};
+    std::chrono::milliseconds m_duration{0};
+    uint32_t m_count = 0;
+  };
+
+  struct EpochRecord {
+    uint64_t m_dsEpoch = 0;
+    uint64_t m_txEpoch = 0;
+    std::array<PhaseRecord, NUM_PHASES> m_phases{};
+  };
+
+  static EpochTimeline& GetInstance();
+
+  static std::string_view GetPhaseName(EpochPhase phase);
+
+  /// dsEpoch is the number of the latest DS block
+  void SetEpoch(uint64_t dsEpoch, uint64_t txEpoch);
+
+  uint64_t GetTxEpoch() const;
+
+  void Begin(EpochPhase phase);
+
+  /// Ends the phase last begun, whatever the epoch is now
+  void End(EpochPhase phase);
+
+  /// Adds a phase that ran in epoch txEpoch
+  void Record(EpochPhase phase, uint64_t txEpoch,
+              std::chrono::system_clock::time_point start,
+              std::chrono::milliseconds duration);
+
+  /// The numEpochs most recent epochs, the most recent first
+  std::vector<EpochRecord> GetRecent(size_t numEpochs) const;
+
+ private:
+  EpochTimeline() = default;
+
+  struct OpenPhase {
+    uint64_t m_dsEpoch;
+    uint64_t m_txEpoch;
+    std::chrono::system_clock::time_point m_start;
+    std::chrono::steady_clock::time_point m_steadyStart;
+  };
+
+  /// dsEpoch is that of txEpoch, if known
+  void RecordLocked(EpochPhase phase, uint64_t txEpoch,
+                    std::optional<uint64_t> dsEpoch,
+                    std::chrono::system_clock::time_point start,
+                    std::chrono::milliseconds duration);
+
+  mutable std::mutex m_mutex;
+  uint64_t m_dsEpoch = 0;
+  uint64_t m_txEpoch = 0;
+  std::map<uint64_t, EpochRecord> m_epochs;
+  std::array<std::optional<OpenPhase>, NUM_PHASES> m_open;
+};
+
+/// Times a phase that runs within a scope
+class EpochPhaseScope final {
+ public:
+  explicit EpochPhaseScope(EpochPhase phase);
+  /// Attributes the phase to epoch txEpoch rather than the current one
+  EpochPhaseScope(EpochPhase phase, uint64_t txEpoch);
+  ~EpochPhaseScope();
+
+  EpochPhaseScope(const EpochPhaseScope&) = delete;
+  EpochPhaseScope& operator=(const EpochPhaseScope&) = delete;
+
+ private:
+  const EpochPhase m_phase;
+  const uint64_t m_txEpoch;
+  const std::chrono::system_clock::time_point m_start;
+  const std::chrono::steady_clock::time_point m_steadyStart;
+};
+
+#endif  // ZILLIQA_SRC_LIBMETRICS_EPOCHTIMELINE_H_
@@ -43,7 +43,10 @@
   M(GLOBAL_ERROR)                 \
   M(DEMO)                         \
   M(CPS_EVM)                      \
-  M(CPS_SCILLA)
+  M(CPS_SCILLA)                   \
+  M(DATABASE)                     \
+  M(POW)                          \
+  M(SCOPED_TIMERS)
 
 namespace zil {
 namespace metrics {
@@ -0,0 +1,289 @@
+/*
+ * Copyright (C) 2023 Zilliqa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "ScopedTimer.h"
+
+#include <bit>
+#include <cstring>
+#include <filesystem>
+#include <mutex>
+#include <set>
+#include <unordered_set>
+
+#include <boost/algorithm/string.hpp>
+
+#include "libMetrics/Api.h"
+#include "libUtils/Logger.h"
+
+namespace zil {
+namespace metrics {
+
+namespace {
+
+constexpr size_t MAX_SITES = 1024;
+
+struct SiteCounters {
+  std::atomic<uint64_t> m_calls{0};
+  std::atomic<uint64_t> m_totalNs{0};
+  std::array<std::atomic<uint64_t>, ScopedTimer::NUM_BUCKETS> m_buckets{};
+};
+
+// Counters of the sites reached by a thread, allocated on the first call
+struct ThreadCounters {
+  std::array<std::atomic<SiteCounters*>, MAX_SITES> m_sites{};
+
+  ~ThreadCounters() {
+    for (auto& site : m_sites) {
+      delete site.load(std::memory_order_relaxed);
+    }
+  }
+};
+
+// Only the owning thread writes to its counters, readers only load them
+void Add(std::atomic<uint64_t>& counter, uint64_t value) {
+  counter.store(counter.load(std::memory_order_relaxed) + value,
+                std::memory_order_relaxed);
+}
+
+void AddTo(ScopedTimer::Stats& stats, const SiteCounters& counters) {
+  stats.m_calls += counters.m_calls.load(std::memory_order_relaxed);
+  stats.m_totalNs += counters.m_totalNs.load(std::memory_order_relaxed);
+  for (size_t i = 0; i < ScopedTimer::NUM_BUCKETS; i++) {
+    stats.m_buckets[i] += counters.m_buckets[i].load(std::memory_order_relaxed);
+  }
+}
+
+void AddTo(ScopedTimer::Stats& stats, const ScopedTimer::Stats& other) {
+  stats.m_calls += other.m_calls;
+  stats.m_totalNs += other.m_totalNs;
+  for (size_t i = 0; i < ScopedTimer::NUM_BUCKETS; i++) {
+    stats.m_buckets[i] += other.m_buckets[i];
+  }
+}
+
+class TimerRegistry {
+ public:
+  static TimerRegistry& GetInstance() {
+    static TimerRegistry registry;
+    return registry;
+  }
+
+  size_t Register(TimerSite& site) {
+    std::lock_guard<std::mutex> g(m_mutex);
+    site.m_log = m_loggedKeys.count(site.m_key) > 0;
+    if (m_sites.size() >= MAX_SITES) {
+      LOG_GENERAL(WARNING, "Too many scoped timers, " << site.m_key << ':'
+                                                      << site.m_line
+                                                      << " isn't timed");
+      return MAX_SITES;
+    }
+    m_sites.emplace_back(&site);
+    m_retired.emplace_back();
+    return m_sites.size() - 1;
+  }
+
+  void AddThread(ThreadCounters* counters) {
+    std::lock_guard<std::mutex> g(m_mutex);
+    m_threads.emplace(counters);
+  }
+
+  /// Keeps the counters of an exiting thread in the totals
+  void RetireThread(ThreadCounters* counters) {
+    std::lock_guard<std::mutex> g(m_mutex);
+    for (size_t i = 0; i < m_retired.size(); i++) {
+      const auto* site = counters->m_sites[i].load(std::memory_order_acquire);
+      if (site) {
+        AddTo(m_retired[i], *site);
+      }
+    }
+    m_threads.erase(counters);
+    delete counters;
+  }
+
+  void SetLogging(const std::string& key, bool log) {
+    std::lock_guard<std::mutex> g(m_mutex);
+    if (log) {
+      m_loggedKeys.emplace(key);
+    } else {
+      m_loggedKeys.erase(key);
+    }
+    for (auto* site : m_sites) {
+      if (key == site->m_key) {
+        site->m_log = log;
+      }
+    }
+  }
+
+  bool IsLogging(const std::string& key) {
+    std::lock_guard<std::mutex> g(m_mutex);
+    for (const auto* site : m_sites) {
+      if (key == site->m_key && site->m_log) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  ScopedTimer::Stats GetStats(const std::string& key) {
+    std::lock_guard<std::mutex> g(m_mutex);
+    ScopedTimer::Stats stats;
+    for (size_t i = 0; i < m_sites.size(); i++) {
+      if (key == m_sites[i]->m_key) {
+        AddTo(stats, GetStatsLocked(i));
+      }
+    }
+    return stats;
+  }
+
+ private:
+  TimerRegistry() {
+    std::vector<std::string> keys;
+    boost::split(keys, METRIC_ZILLIQA_LOGGED_TIMERS, boost::is_any_of(","));
+    for (auto& key : keys) {
+      boost::trim(key);
+      if (!key.empty()) {
+        m_loggedKeys.emplace(key);
+      }
+    }
+
+    m_stats.SetCallback([this](auto&& result) {
+      if (!m_stats.Enabled()) {
+        return;
+      }
+      std::lock_guard<std::mutex> g(m_mutex);
+      for (size_t i = 0; i < m_sites.size(); i++) {
+        const auto stats = GetStatsLocked(i);
+        if (stats.m_calls == 0) {
+          continue;
+        }
+        const std::string site =
+            m_sites[i]->m_key + ':' + std::to_string(m_sites[i]->m_line);
+        result.Set(stats.m_calls, {{"site", site}, {"counter", "Calls"}});
+        result.Set(stats.m_totalNs, {{"site", site}, {"counter", "TotalNs"}});
+        for (size_t b = 0; b < ScopedTimer::NUM_BUCKETS; b++) {
+          if (stats.m_buckets[b] == 0) {
+            continue;
+          }
+          const std::string bound = (b + 1 < ScopedTimer::NUM_BUCKETS)
+                                        ? std::to_string(1ULL << b)
+                                        : "+Inf";
+          // Exclusive bound, unlike the inclusive "le" of Prometheus
+          result.Set(stats.m_buckets[b],
+                     {{"site", site}, {"counter", "Bucket"}, {"lt_us", bound}});
+        }
+      }
+    });
+  }
+
+  ScopedTimer::Stats GetStatsLocked(size_t index) {
+    ScopedTimer::Stats stats = m_retired[index];
+    for (const auto* thread : m_threads) {
+      const auto* site = thread->m_sites[index].load(std::memory_order_acquire);
+      if (site) {
+        AddTo(stats, *site);
+      }
+    }
+    return stats;
+  }
+
+  std::mutex m_mutex;
+  std::vector<TimerSite*> m_sites;
+  std::unordered_set<ThreadCounters*> m_threads;
+  // Counters of the threads that exited, by site
+  std::vector<ScopedTimer::Stats> m_retired;
+  std::set<std::string, std::less<>> m_loggedKeys;
+
+  Z_I64GAUGE m_stats{Z_FL::SCOPED_TIMERS, "scoped_timer.stats",
+                     "Calls and latencies of timed scopes", "calls", true};
+};
+
+struct ThreadCountersOwner {
+  ThreadCounters* m_counters = nullptr;
+
+  ~ThreadCountersOwner() {
+    if (m_counters) {
+      TimerRegistry::GetInstance().RetireThread(m_counters);
+    }
+  }
+};
+
+thread_local ThreadCountersOwner t_counters;
+
+ThreadCounters& GetThreadCounters() {
+  if (!t_counters.m_counters) {
+    t_counters.m_counters = new ThreadCounters;
+    TimerRegistry::GetInstance().AddThread(t_counters.m_counters);
+  }
+  return *t_counters.m_counters;
+}
+
+}  // namespace
+
+TimerSite::TimerSite(const char* file, int line, const char* func)
+    : m_file(file),
+      m_line(line),
+      m_func(func),
+      m_key(std::string{std::filesystem::path{file}.filename().string()} +
+            ':' + func) {
+  m_index = TimerRegistry::GetInstance().Register(*this);
+}
+
+void ScopedTimer::SetLogging(const std::string& key, bool log) {
+  TimerRegistry::GetInstance().SetLogging(key, log);
+}
+
+bool ScopedTimer::IsLogging(const std::string& key) {
+  return TimerRegistry::GetInstance().IsLogging(key);
+}
+
+ScopedTimer::Stats ScopedTimer::GetStats(const std::string& key) {
+  return TimerRegistry::GetInstance().GetStats(key);
+}
+
+void ScopedTimer::LogBegin() const {
+  LogCapture(m_site.m_file, m_site.m_line, m_site.m_func, INFO,
+             &Logger::IsGeneralSink, CreateTracingExtraData())
+          .stream()
+      << " BEG";
+}
+
+void ScopedTimer::Record(TimerSite& site, std::chrono::nanoseconds elapsed) {
+  const uint64_t ns = std::max<int64_t>(elapsed.count(), 0);
+  if (site.m_index < MAX_SITES) {
+    auto& slot = GetThreadCounters().m_sites[site.m_index];
+    auto* counters = slot.load(std::memory_order_relaxed);
+    if (!counters) {
+      counters = new SiteCounters;
+      slot.store(counters, std::memory_order_release);
+    }
+    const size_t bucket =
+        std::min<size_t>(std::bit_width(ns / 1000), NUM_BUCKETS - 1);
+    Add(counters->m_calls, 1);
+    Add(counters->m_totalNs, ns);
+    Add(counters->m_buckets[bucket], 1);
+  }
+
+  if (site.m_log.load(std::memory_order_relaxed)) {
+    LogCapture(site.m_file, site.m_line, site.m_func, INFO,
+               &Logger::IsGeneralSink, CreateTracingExtraData())
+            .stream()
+        << " END " << ns / 1000 << " us";
+  }
+}
+
+}  // namespace metrics
+}  // namespace zil
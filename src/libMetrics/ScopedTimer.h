@@ -0,0 +1,107 @@
+/*
+ * Copyright (C) 2023 Zilliqa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef ZILLIQA_SRC_LIBMETRICS_SCOPEDTIMER_H_
+#define ZILLIQA_SRC_LIBMETRICS_SCOPEDTIMER_H_
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace zil {
+namespace metrics {
+
+/// A call site of SCOPED_TIMER(), registered the first time it is reached
+struct TimerSite {
+  TimerSite(const char* file, int line, const char* func);
+
+  const char* const m_file;
+  const int m_line;
+  const char* const m_func;
+  // File name and function, e.g. "ConsensusLeader.cpp:ProcessMessage", so
+  // that functions of the same name in different files are told apart
+  const std::string m_key;
+  size_t m_index;
+  // Whether entering and leaving the scope is also logged
+  std::atomic<bool> m_log{false};
+
+  TimerSite(const TimerSite&) = delete;
+  TimerSite& operator=(const TimerSite&) = delete;
+};
+
+/// Times a scope into counters of its site that only the calling thread
+/// writes to, so no lock nor atomic read-modify-write is taken. The counters
+/// of all the threads are summed when exported. Nothing is logged unless the
+/// site is enabled with METRIC_ZILLIQA_LOGGED_TIMERS or SetLogging().
+class ScopedTimer final {
+ public:
+  // Bucket i counts the calls that took less than 2^i microseconds, the last
+  // bucket counts the rest. The buckets are exported with an "lt_us" label
+  // holding that exclusive upper bound.
+  static constexpr size_t NUM_BUCKETS = 24;
+
+  struct Stats {
+    uint64_t m_calls = 0;
+    uint64_t m_totalNs = 0;
+    std::array<uint64_t, NUM_BUCKETS> m_buckets{};
+  };
+
+  explicit ScopedTimer(TimerSite& site)
+      : m_site(site), m_start(std::chrono::steady_clock::now()) {
+    if (m_site.m_log.load(std::memory_order_relaxed)) {
+      LogBegin();
+    }
+  }
+
+  ~ScopedTimer() {
+    const auto elapsed = std::chrono::steady_clock::now() - m_start;
+    Record(m_site, elapsed);
+  }
+
+  /// Logs entering and leaving the scopes of the sites with the given key,
+  /// i.e. "<file name>:<function>"
+  static void SetLogging(const std::string& key, bool log);
+
+  /// Whether the scopes of the sites with the given key are logged
+  static bool IsLogging(const std::string& key);
+
+  /// Sums the counters of every thread for the sites with the given key
+  static Stats GetStats(const std::string& key);
+
+  ScopedTimer(const ScopedTimer&) = delete;
+  ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+ private:
+  void LogBegin() const;
+  static void Record(TimerSite& site, std::chrono::nanoseconds elapsed);
+
+  TimerSite& m_site;
+  const std::chrono::steady_clock::time_point m_start;
+};
+
+}  // namespace metrics
+}  // namespace zil
+
+#define SCOPED_TIMER()                                              \
+  static zil::metrics::TimerSite scopedTimerSite{__FILE__, __LINE__, \
+                                                 __FUNCTION__};      \
+  zil::metrics::ScopedTimer scopedTimer{scopedTimerSite};
+
+#endif  // ZILLIQA_SRC_LIBMETRICS_SCOPEDTIMER_H_
@@ -23,6 +23,7 @@
 #include "SendJobs.h"
 #include "common/Messages.h"
 #include "libCrypto/Sha2.h"
+#include "libMetrics/ScopedTimer.h"
 #include "libUtils/DataConversion.h"
 #include "libUtils/Logger.h"
 
@@ -240,7 +241,7 @@ void SendBroadcastMessageImpl(const std::shared_ptr<SendJobs>& sendJobs,
 /// Multicasts message of type=broadcast to specified list of peers.
 void P2P::SendBroadcastMessage(const VectorOfPeer& peers, const zbytes& message,
                                bool inject_trace_context) {
-  LOG_MARKER();
+  SCOPED_TIMER();
 
   zbytes hash;
   SendBroadcastMessageImpl(m_sendJobs, peers, m_selfPeer, message, hash,
@@ -256,7 +257,7 @@ void P2P::SendBroadcastMessage(const VectorOfPeer& peers, const zbytes& message,
 void P2P::SendBroadcastMessage(const std::deque<Peer>& peers,
                                const zbytes& message,
                                bool inject_trace_context) {
-  LOG_MARKER();
+  SCOPED_TIMER();
 
   zbytes hash;
   SendBroadcastMessageImpl(m_sendJobs, peers, m_selfPeer, message, hash,
@@ -288,30 +289,30 @@ void P2P::SendMessageNoQueue(const Peer& peer, const zbytes& message,
 }
 
 bool P2P::SpreadRumor(const zbytes& message) {
-  LOG_MARKER();
+  SCOPED_TIMER();
   return m_rumorManager->AddRumor(message);
 }
 
 bool P2P::SpreadForeignRumor(const zbytes& message) {
-  LOG_MARKER();
+  SCOPED_TIMER();
   return m_rumorManager->AddForeignRumor(message);
 }
 
 void P2P::SendRumorToForeignPeer(const Peer& foreignPeer,
                                  const zbytes& message) {
-  LOG_MARKER();
+  SCOPED_TIMER();
   m_rumorManager->SendRumorToForeignPeer(foreignPeer, message);
 }
 
 void P2P::SendRumorToForeignPeers(const VectorOfPeer& foreignPeers,
                                   const zbytes& message) {
-  LOG_MARKER();
+  SCOPED_TIMER();
   m_rumorManager->SendRumorToForeignPeers(foreignPeers, message);
 }
 
 void P2P::SendRumorToForeignPeers(const std::deque<Peer>& foreignPeers,
                                   const zbytes& message) {
-  LOG_MARKER();
+  SCOPED_TIMER();
   m_rumorManager->SendRumorToForeignPeers(foreignPeers, message);
 }
 
@@ -15,10 +15,13 @@
  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
+
 #include "Node.h"
 #include "common/Constants.h"
 #include "common/Messages.h"
 #include "common/Serializable.h"
+#include "libConsensus/AggregateKeyCache.h"
 #include "libData/AccountData/Account.h"
 #include "libData/AccountData/Transaction.h"
 #include "libData/AccountStore/AccountStore.h"
@@ -110,31 +113,22 @@ void Node::UpdateDSCommitteeComposition(DequeOfNode& dsComm,
 bool Node::VerifyDSBlockCoSignature(const DSBlock& dsblock) {
   LOG_MARKER();
 
-  unsigned int index = 0;
-  unsigned int count = 0;
-
   const vector<bool>& B2 = dsblock.GetB2();
   if (m_mediator.m_DSCommittee->size() != B2.size()) {
     LOG_CHECK_FAIL("Cosig size", B2.size(), m_mediator.m_DSCommittee->size());
     return false;
   }
 
-  // Generate the aggregated key
-  vector<PubKey> keys;
-  for (auto const& kv : *m_mediator.m_DSCommittee) {
-    if (B2.at(index)) {
-      keys.emplace_back(kv.first);
-      count++;
-    }
-    index++;
-  }
+  const unsigned int count = std::count(B2.begin(), B2.end(), true);
 
   if (count != ConsensusCommon::NumForConsensus(B2.size())) {
     LOG_GENERAL(WARNING, "Cosig was not generated by enough nodes");
     return false;
   }
 
-  shared_ptr<PubKey> aggregatedKey = MultiSig::AggregatePubKeys(keys);
+  shared_ptr<const PubKey> aggregatedKey =
+      AggregateKeyCache::GetInstance().GetAggregatedKey(
+          *m_mediator.m_DSCommittee, B2);
   if (aggregatedKey == nullptr) {
     LOG_GENERAL(WARNING, "Aggregated key generation failed");
     return false;
@@ -151,8 +145,12 @@ bool Node::VerifyDSBlockCoSignature(const DSBlock& dsblock) {
   if (!MultiSig::MultiSigVerify(message, 0, message.size(), dsblock.GetCS2(),
                                 *aggregatedKey)) {
     LOG_GENERAL(WARNING, "Cosig verification failed");
-    for (auto& kv : keys) {
-      LOG_GENERAL(WARNING, kv);
+    unsigned int index = 0;
+    for (auto const& kv : *m_mediator.m_DSCommittee) {
+      if (B2.at(index)) {
+        LOG_GENERAL(WARNING, kv.first);
+      }
+      index++;
     }
     return false;
   }
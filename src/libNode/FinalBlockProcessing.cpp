@@ -15,6 +15,8 @@
  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
+
 #include <boost/algorithm/string.hpp>
 #include <boost/multiprecision/cpp_dec_float.hpp>
 #include <boost/range/adaptor/map.hpp>
@@ -25,6 +27,7 @@
 #include "common/Constants.h"
 #include "common/Messages.h"
 #include "common/Serializable.h"
+#include "libConsensus/AggregateKeyCache.h"
 #include "libCrypto/Sha2.h"
 #include "libData/AccountData/Account.h"
 #include "libData/AccountData/Transaction.h"
@@ -34,6 +37,7 @@
 #include "libMediator/Mediator.h"
 #include "libMessage/Messenger.h"
 #include "libMetrics/Api.h"
+#include "libMetrics/EpochTimeline.h"
 #include "libMetrics/TracedIds.h"
 #include "libNetwork/Blacklist.h"
 #include "libNetwork/Guard.h"
@@ -339,31 +343,22 @@ bool Node::RemoveTxRootHashFromUnavailableMicroBlock(
 bool Node::VerifyFinalBlockCoSignature(const TxBlock& txblock) {
   LOG_MARKER();
 
-  unsigned int index = 0;
-  unsigned int count = 0;
-
   const vector<bool>& B2 = txblock.GetB2();
   if (m_mediator.m_DSCommittee->size() != B2.size()) {
     LOG_CHECK_FAIL("Cosig size", B2.size(), m_mediator.m_DSCommittee->size());
     return false;
   }
 
-  // Generate the aggregated key
-  vector<PubKey> keys;
-  for (auto const& kv : *m_mediator.m_DSCommittee) {
-    if (B2.at(index)) {
-      keys.emplace_back(kv.first);
-      count++;
-    }
-    index++;
-  }
+  const unsigned int count = std::count(B2.begin(), B2.end(), true);
 
   if (count != ConsensusCommon::NumForConsensus(B2.size())) {
     LOG_GENERAL(WARNING, "Cosig was not generated by enough nodes");
     return false;
   }
 
-  shared_ptr<PubKey> aggregatedKey = MultiSig::AggregatePubKeys(keys);
+  shared_ptr<const PubKey> aggregatedKey =
+      AggregateKeyCache::GetInstance().GetAggregatedKey(
+          *m_mediator.m_DSCommittee, B2);
   if (aggregatedKey == nullptr) {
     LOG_GENERAL(WARNING, "Aggregated key generation failed");
     return false;
@@ -380,8 +375,12 @@ bool Node::VerifyFinalBlockCoSignature(const TxBlock& txblock) {
   if (!MultiSig::MultiSigVerify(message, 0, message.size(), txblock.GetCS2(),
                                 *aggregatedKey)) {
     LOG_GENERAL(WARNING, "Cosig verification failed");
-    for (auto& kv : keys) {
-      LOG_GENERAL(WARNING, kv);
+    unsigned int index = 0;
+    for (auto const& kv : *m_mediator.m_DSCommittee) {
+      if (B2.at(index)) {
+        LOG_GENERAL(WARNING, kv.first);
+      }
+      index++;
     }
     return false;
   }
@@ -1193,6 +1192,8 @@ bool Node::ProcessFinalBlockCore(uint64_t& dsBlockNumber,
     }
 
     auto writeStateToDisk = [this]() -> void {
+      EpochPhaseScope commitPhase(EpochPhase::STATE_COMMIT,
+                                  m_mediator.m_currentEpochNum);
       if (!AccountStore::GetInstance().MoveUpdatesToDisk(
               m_mediator.m_dsBlockChain.GetLastBlock()
                   .GetHeader()
@@ -1425,26 +1426,26 @@ void Node::CommitForwardedTransactions(const MBnForwardedTxnEntry& entry) {
         LookupServer::AddToRecentTransactions(txhash);
         const auto& receipt = twr.GetTransactionReceipt();
         cache_upd.AddCommittedTransaction(epochNum, shardId, txhash.hex(),
-                                          receipt.GetJsonValue());
+                                          receipt.GetString());
 
         LOG_GENERAL(INFO, entry << " receipt=" << receipt.GetString());
       }
     }
+
+    if (!BlockStorage::GetBlockStorage().PutTxLocations(entry.m_microBlock)) {
+      LOG_GENERAL(WARNING, "BlockStorage::PutTxLocations failed " << entry);
+    }
   }
 
   if (!ARCHIVAL_LOOKUP && REMOTESTORAGE_DB_ENABLE) {
-    auto mongoInsertFunc = [transactions = entry.m_transactions,
-                            epoch = m_mediator.m_currentEpochNum]() {
-      for (const auto& twr : transactions) {
-        const auto& tran = twr.GetTransaction();
-        const auto& txhash = tran.GetTranID();
-        RemoteStorageDB::GetInstance().UpdateTxn(
-            txhash.hex(), TxnStatus::CONFIRMED, epoch,
-            twr.GetTransactionReceipt().GetJsonValue()["success"].asBool());
-      }
-      RemoteStorageDB::GetInstance().ExecuteWriteDetached();
-    };
-    DetachedFunction(1, mongoInsertFunc);
+    // Only queued here, the remote storage writer thread batches them with
+    // those of the other entries by size and time
+    for (const auto& twr : entry.m_transactions) {
+      RemoteStorageDB::GetInstance().UpdateTxn(
+          twr.GetTransaction().GetTranID().hex(), TxnStatus::CONFIRMED,
+          m_mediator.m_currentEpochNum,
+          twr.GetTransactionReceipt().GetSuccess());
+    }
   }
   LOG_EPOCH(INFO, m_mediator.m_currentEpochNum,
             "Proceessed " << entry.m_transactions.size() << " of txns.");
@@ -1468,17 +1469,12 @@ void Node::SoftConfirmForwardedTransactions(const MBnForwardedTxnEntry& entry) {
   }
   {
     if (!ARCHIVAL_LOOKUP && REMOTESTORAGE_DB_ENABLE) {
-      auto mongoInsertFunc = [txns = entry.m_transactions,
-                              epoch = m_mediator.m_currentEpochNum]() {
-        for (const auto& twr : txns) {
-          const auto& txhash = twr.GetTransaction().GetTranID();
-          RemoteStorageDB::GetInstance().UpdateTxn(
-              txhash.hex(), TxnStatus::SOFT_CONFIRMED, epoch,
-              twr.GetTransactionReceipt().GetJsonValue()["success"].asBool());
-        }
-        RemoteStorageDB::GetInstance().ExecuteWriteDetached();
-      };
-      DetachedFunction(1, mongoInsertFunc);
+      for (const auto& twr : entry.m_transactions) {
+        RemoteStorageDB::GetInstance().UpdateTxn(
+            twr.GetTransaction().GetTranID().hex(), TxnStatus::SOFT_CONFIRMED,
+            m_mediator.m_currentEpochNum,
+            twr.GetTransactionReceipt().GetSuccess());
+      }
     }
   }
 }
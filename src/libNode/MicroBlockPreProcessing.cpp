@@ -30,6 +30,7 @@
 #include "libData/CoinbaseData/RewardControlContractState.h"
 #include "libMediator/Mediator.h"
 #include "libMessage/Messenger.h"
+#include "libMetrics/EpochTimeline.h"
 #include "libNetwork/P2P.h"
 #include "libPOW/pow.h"
 #include "libUtils/BitVector.h"
@@ -85,6 +86,7 @@ bool Node::ComposeMicroBlock(const uint64_t& microblock_gas_limit) {
   }
   // To-do: Replace dummy values with the required ones
   LOG_MARKER();
+  EpochPhaseScope compositionPhase(EpochPhase::MICROBLOCK_COMPOSITION);
 
   // TxBlockHeader
   const uint32_t version = MICROBLOCK_VERSION;
@@ -374,6 +376,7 @@ void Node::NotifyTimeout(bool& txnProcTimeout) {
 void Node::ProcessTransactionWhenShardLeader(
     const uint64_t& microblock_gas_limit) {
   LOG_MARKER();
+  EpochPhaseScope processingPhase(EpochPhase::TXN_PROCESSING);
 
   if (ENABLE_ACCOUNTS_POPULATING && UPDATE_PREGENED_ACCOUNTS) {
     UpdateBalanceForPreGeneratedAccounts();
@@ -692,6 +695,7 @@ void Node::UpdateProcessedTransactions() {
 void Node::ProcessTransactionWhenShardBackup(
     const uint64_t& microblock_gas_limit) {
   LOG_MARKER();
+  EpochPhaseScope processingPhase(EpochPhase::TXN_PROCESSING);
 
   if (ENABLE_ACCOUNTS_POPULATING && UPDATE_PREGENED_ACCOUNTS) {
     UpdateBalanceForPreGeneratedAccounts();
@@ -30,6 +30,7 @@
 #include "libData/AccountStore/AccountStore.h"
 #include "libMediator/Mediator.h"
 #include "libMessage/Messenger.h"
+#include "libMetrics/EpochTimeline.h"
 #include "libNetwork/Guard.h"
 #include "libNetwork/P2P.h"
 #include "libPOW/pow.h"
@@ -105,6 +106,7 @@ bool Node::StartPoW(const uint64_t& block_num, uint8_t ds_difficulty,
   LOG_EPOCH(INFO, m_mediator.m_currentEpochNum,
             "Current dsblock is " << block_num);
 
+  EpochPhaseScope powPhase(EpochPhase::POW);
   lock_guard<mutex> g(m_mutexGasPrice);
 
   auto headerHash = POW::GenHeaderHash(rand1, rand2, m_mediator.m_selfPeer,
@@ -19,6 +19,7 @@
 #include "libCrypto/Sha2.h"
 #include "libData/AccountData/Transaction.h"
 #include "libData/AccountData/TransactionReceipt.h"
+#include "libMetrics/ScopedTimer.h"
 #include "libUtils/Logger.h"
 
 using namespace std;
@@ -43,7 +44,7 @@ inline const TxnHash& GetHash(const TransactionWithReceipt& item) {
 
 template <typename... Container>
 TxnHash ConcatTranAndHash(const Container&... conts) {
-  LOG_MARKER();
+  SCOPED_TIMER();
 
   SHA256Calculator sha2;
   bool hasValue = false;
@@ -67,21 +68,21 @@ TxnHash ConcatTranAndHash(const Container&... conts) {
 }  // namespace
 
 h256 ComputeRoot(const vector<h256>& hashes) {
-  LOG_MARKER();
+  SCOPED_TIMER();
 
   return ConcatTranAndHash(hashes);
 }
 
 TxnHash ComputeRoot(const list<Transaction>& receivedTransactions,
                     const list<Transaction>& submittedTransactions) {
-  LOG_MARKER();
+  SCOPED_TIMER();
 
   return ConcatTranAndHash(receivedTransactions, submittedTransactions);
 }
 
 TxnHash ComputeRoot(
     const unordered_map<TxnHash, Transaction>& processedTransactions) {
-  LOG_MARKER();
+  SCOPED_TIMER();
 
   return ConcatTranAndHash(processedTransactions);
 }
@@ -89,13 +90,13 @@ TxnHash ComputeRoot(
 TxnHash ComputeRoot(
     const unordered_map<TxnHash, Transaction>& receivedTransactions,
     const unordered_map<TxnHash, Transaction>& submittedTransactions) {
-  LOG_MARKER();
+  SCOPED_TIMER();
 
   return ConcatTranAndHash(receivedTransactions, submittedTransactions);
 }
 
 TxnHash ComputeRoot(const vector<TransactionWithReceipt>& transactions) {
-  LOG_MARKER();
+  SCOPED_TIMER();
 
   return ConcatTranAndHash(transactions);
 }
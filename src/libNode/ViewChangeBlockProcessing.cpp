@@ -15,6 +15,7 @@
  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
 #include <array>
 #include <chrono>
 #include <functional>
@@ -24,6 +25,7 @@
 #include "common/Constants.h"
 #include "common/Messages.h"
 #include "common/Serializable.h"
+#include "libConsensus/AggregateKeyCache.h"
 #include "libMediator/Mediator.h"
 #include "libMessage/Messenger.h"
 #include "libNetwork/Guard.h"
@@ -39,9 +41,6 @@ using namespace boost::multiprecision;
 bool Node::VerifyVCBlockCoSignature(const VCBlock& vcblock) {
   LOG_MARKER();
 
-  unsigned int index = 0;
-  unsigned int count = 0;
-
   const vector<bool>& B2 = vcblock.GetB2();
   if (m_mediator.m_DSCommittee->size() != B2.size()) {
     LOG_GENERAL(WARNING, "Mismatch: DS committee size = "
@@ -50,23 +49,16 @@ bool Node::VerifyVCBlockCoSignature(const VCBlock& vcblock) {
     return false;
   }
 
-  // Generate the aggregated key
-  vector<PubKey> keys;
-
-  for (auto const& kv : *m_mediator.m_DSCommittee) {
-    if (B2.at(index)) {
-      keys.emplace_back(kv.first);
-      count++;
-    }
-    index++;
-  }
+  const unsigned int count = std::count(B2.begin(), B2.end(), true);
 
   if (count != ConsensusCommon::NumForConsensus(B2.size())) {
     LOG_GENERAL(WARNING, "Cosig was not generated by enough nodes");
     return false;
   }
 
-  shared_ptr<PubKey> aggregatedKey = MultiSig::AggregatePubKeys(keys);
+  shared_ptr<const PubKey> aggregatedKey =
+      AggregateKeyCache::GetInstance().GetAggregatedKey(
+          *m_mediator.m_DSCommittee, B2);
   if (aggregatedKey == nullptr) {
     LOG_GENERAL(WARNING, "Aggregated key generation failed");
     return false;
@@ -83,8 +75,12 @@ bool Node::VerifyVCBlockCoSignature(const VCBlock& vcblock) {
   if (!MultiSig::MultiSigVerify(message, 0, message.size(), vcblock.GetCS2(),
                                 *aggregatedKey)) {
     LOG_GENERAL(WARNING, "Cosig verification failed. Pubkeys");
-    for (auto& kv : keys) {
-      LOG_GENERAL(WARNING, kv);
+    unsigned int index = 0;
+    for (auto const& kv : *m_mediator.m_DSCommittee) {
+      if (B2.at(index)) {
+        LOG_GENERAL(WARNING, kv.first);
+      }
+      index++;
     }
     return false;
   }
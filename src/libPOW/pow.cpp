@@ -18,12 +18,15 @@
 #include <boost/algorithm/string/predicate.hpp>
 #include <chrono>
 #include <ctime>
+#include <future>
 #include <iomanip>
 #include <iostream>
+#include <limits>
 
 #include "common/Serializable.h"
 #include "ethash/ethash.hpp"
 #include "libCrypto/Sha2.h"
+#include "libMetrics/Api.h"
 #include "libServer/GetWorkServer.h"
 #include "libUtils/DataConversion.h"
 #include "pow.h"
@@ -42,7 +45,133 @@ hash256 calculate_seed(int epoch_number) noexcept;
 
 using namespace boost::multiprecision;
 
+namespace zil {
+namespace local {
+
+class POWVariables {
+  std::atomic<uint64_t> cpuHashrate{};
+  std::atomic<unsigned int> cpuThreads{};
+  std::atomic<int> nextEpoch{-1};
+  std::atomic<int> nextEpochReady{};
+  std::atomic<uint64_t> lightGenerationMs{};
+  std::atomic<uint64_t> fullGenerationMs{};
+  std::atomic<uint64_t> syncGenerations{};
+  std::atomic<uint64_t> verifyCacheHits{};
+  std::atomic<uint64_t> verifyCacheMisses{};
+  std::atomic<uint64_t> verifyBatchSize{};
+  std::atomic<uint64_t> verifyBatchMs{};
+
+ public:
+  std::unique_ptr<Z_I64GAUGE> temp;
+  std::unique_ptr<Z_I64GAUGE> epochContext;
+  std::unique_ptr<Z_I64GAUGE> verify;
+
+  void SetCpuHashrate(uint64_t hashrate, unsigned int threads) {
+    Init();
+    cpuHashrate = hashrate;
+    cpuThreads = threads;
+  }
+
+  void SetNextEpoch(int epoch, bool ready) {
+    Init();
+    nextEpoch = epoch;
+    nextEpochReady = ready;
+  }
+
+  void SetLightGenerationMs(uint64_t ms) {
+    Init();
+    lightGenerationMs = ms;
+  }
+
+  void SetFullGenerationMs(uint64_t ms) {
+    Init();
+    fullGenerationMs = ms;
+  }
+
+  void AddSyncGeneration() {
+    Init();
+    syncGenerations++;
+  }
+
+  void AddVerifyCacheLookup(bool hit) {
+    Init();
+    if (hit) {
+      verifyCacheHits++;
+    } else {
+      verifyCacheMisses++;
+    }
+  }
+
+  void SetVerifyBatch(uint64_t size, uint64_t ms) {
+    Init();
+    verifyBatchSize = size;
+    verifyBatchMs = ms;
+  }
+
+  void Init() {
+    if (!temp) {
+      temp = std::make_unique<Z_I64GAUGE>(Z_FL::POW, "pow.cpu.gauge",
+                                          "CPU mining", "hashes/s", true);
+
+      temp->SetCallback([this](auto&& result) {
+        result.Set(cpuHashrate.load(), {{"counter", "Hashrate"}});
+        result.Set(cpuThreads.load(), {{"counter", "Threads"}});
+      });
+    }
+
+    if (!epochContext) {
+      epochContext = std::make_unique<Z_I64GAUGE>(
+          Z_FL::POW, "pow.epoch_context.gauge",
+          "Ethash epoch context generation", "ms", true);
+
+      epochContext->SetCallback([this](auto&& result) {
+        result.Set(nextEpoch.load(), {{"counter", "NextEpoch"}});
+        result.Set(nextEpochReady.load(), {{"counter", "NextEpochReady"}});
+        result.Set(lightGenerationMs.load(),
+                   {{"counter", "LightGenerationMs"}});
+        result.Set(fullGenerationMs.load(), {{"counter", "FullGenerationMs"}});
+        result.Set(syncGenerations.load(), {{"counter", "SyncGenerations"}});
+      });
+    }
+
+    if (!verify) {
+      verify = std::make_unique<Z_I64GAUGE>(
+          Z_FL::POW, "pow.verify.gauge", "PoW verification", "calls", true);
+
+      verify->SetCallback([this](auto&& result) {
+        result.Set(verifyCacheHits.load(), {{"counter", "CacheHits"}});
+        result.Set(verifyCacheMisses.load(), {{"counter", "CacheMisses"}});
+        result.Set(verifyBatchSize.load(), {{"counter", "LastBatchSize"}});
+        result.Set(verifyBatchMs.load(), {{"counter", "LastBatchMs"}});
+      });
+    }
+  }
+};
+
+static POWVariables variables{};
+
+}  // namespace local
+}  // namespace zil
+
 namespace {
+// The clock is read once per this many hashes of a mining thread
+constexpr uint64_t MINE_TIME_CHECK_INTERVAL = 64;
+
+// Each hash reads 64 random items of the dataset. Hashing a quarter as many
+// times as there are items reads every item 16 times on average, which leaves
+// about e^-16 of the dataset to be built during mining.
+constexpr uint64_t DATASET_ITEMS_PER_WARM_HASH = 4;
+
+// The header hash of a submission commits to the DS block randomness, so
+// entries of past DS epochs are never looked up again and only take space
+constexpr size_t MAX_VERIFIED_ENTRIES = 1 << 16;
+
+uint64_t ElapsedMs(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration_cast<std::chrono::milliseconds>(
+             std::chrono::steady_clock::now() - start)
+      .count();
+}
+
 size_t clz(uint8_t x) {
   static constexpr std::uint8_t clz_lookup[16] = {4, 3, 2, 2, 1, 1, 1, 1,
                                                   0, 0, 0, 0, 0, 0, 0, 0};
@@ -75,7 +204,12 @@ POW::POW() {
   }
 }
 
-POW::~POW() {}
+POW::~POW() {
+  m_stopPregen = true;
+  if (m_pregenThread.joinable()) {
+    m_pregenThread.join();
+  }
+}
 
 POW& POW::GetInstance() {
   static POW pow;
@@ -248,27 +382,160 @@ bool POW::EthashConfigureClient(uint64_t block_number, bool fullDataset) {
                     << " currentBlockNum: " << m_currentBlockNum);
   }
 
-  if (ethash::get_epoch_number(block_number) !=
-      ethash::get_epoch_number(m_currentBlockNum)) {
-    auto epochNumber = ethash::get_epoch_number(block_number);
-    m_epochContextLight = ethash::create_epoch_context(epochNumber);
+  const auto epochNumber = ethash::get_epoch_number(block_number);
+
+  if (epochNumber != ethash::get_epoch_number(m_currentBlockNum)) {
+    m_epochContextLight = TakeEpochContextLight(epochNumber);
   }
 
   bool isMineFullCpu =
       fullDataset && !OPENCL_GPU_MINE && !GETWORK_SERVER_MINE && !REMOTE_MINE;
 
-  if (isMineFullCpu && (m_epochContextFull == nullptr ||
-                        ethash::get_epoch_number(block_number) !=
-                            ethash::get_epoch_number(m_currentBlockNum))) {
-    m_epochContextFull = ethash::create_epoch_context_full(
-        ethash::get_epoch_number(block_number));
+  if (isMineFullCpu &&
+      (m_epochContextFull == nullptr ||
+       epochNumber != ethash::get_epoch_number(m_currentBlockNum))) {
+    m_epochContextFull = TakeEpochContextFull(epochNumber);
   }
 
   m_currentBlockNum = block_number;
 
+  PregenerateNextEpochContext(block_number, isMineFullCpu);
+
   return true;
 }
 
+std::shared_ptr<ethash::epoch_context> POW::TakeEpochContextLight(
+    int epochNumber) {
+  {
+    std::lock_guard<std::mutex> g(m_mutexNextEpochContext);
+    if (m_nextEpochNumber == epochNumber && m_nextEpochContextLight) {
+      return std::move(m_nextEpochContextLight);
+    }
+    if (m_nextEpochNumber < epochNumber) {
+      m_nextEpochContextLight.reset();
+      m_nextEpochContextFull.reset();
+    }
+  }
+
+  LOG_GENERAL(INFO, "Building light context of epoch " << epochNumber);
+  zil::local::variables.AddSyncGeneration();
+  const auto start = std::chrono::steady_clock::now();
+  std::shared_ptr<ethash::epoch_context> context =
+      ethash::create_epoch_context(epochNumber);
+  zil::local::variables.SetLightGenerationMs(ElapsedMs(start));
+  return context;
+}
+
+std::shared_ptr<ethash::epoch_context_full> POW::TakeEpochContextFull(
+    int epochNumber) {
+  {
+    // A context still being warmed up is taken as well, the mining threads
+    // build whatever items of the dataset the warm up has not reached yet.
+    std::lock_guard<std::mutex> g(m_mutexNextEpochContext);
+    if (m_nextEpochNumber == epochNumber && m_nextEpochContextFull) {
+      return std::move(m_nextEpochContextFull);
+    }
+  }
+
+  LOG_GENERAL(INFO, "Building full context of epoch " << epochNumber);
+  zil::local::variables.AddSyncGeneration();
+  const auto start = std::chrono::steady_clock::now();
+  std::shared_ptr<ethash::epoch_context_full> context =
+      ethash::create_epoch_context_full(epochNumber);
+  zil::local::variables.SetFullGenerationMs(ElapsedMs(start));
+  return context;
+}
+
+void POW::PregenerateNextEpochContext(uint64_t blockNum, bool fullDataset) {
+  if (ETHASH_PREGEN_BLOCKS_AHEAD == 0) {
+    return;
+  }
+
+  const int nextEpochNumber = ethash::get_epoch_number(blockNum) + 1;
+  if (ethash::get_epoch_number(blockNum + ETHASH_PREGEN_BLOCKS_AHEAD) <
+      nextEpochNumber) {
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> g(m_mutexNextEpochContext);
+    if (m_nextEpochNumber == nextEpochNumber &&
+        (!fullDataset || m_nextEpochContextFull)) {
+      return;
+    }
+  }
+
+  bool expected = false;
+  if (!m_pregenRunning.compare_exchange_strong(expected, true)) {
+    return;
+  }
+
+  if (m_pregenThread.joinable()) {
+    m_pregenThread.join();
+  }
+
+  m_pregenThread = std::thread([this, nextEpochNumber, fullDataset]() {
+    GenerateEpochContext(nextEpochNumber, fullDataset);
+    m_pregenRunning = false;
+  });
+}
+
+bool POW::IsEpochContextReady(int epochNumber, bool fullDataset) {
+  std::lock_guard<std::mutex> g(m_mutexNextEpochContext);
+  return m_nextEpochNumber == epochNumber && m_nextEpochContextLight &&
+         (!fullDataset || (m_nextEpochContextFull && m_nextEpochContextReady));
+}
+
+void POW::GenerateEpochContext(int epochNumber, bool fullDataset) {
+  LOG_GENERAL(INFO, "Pregenerating context of epoch " << epochNumber);
+  zil::local::variables.SetNextEpoch(epochNumber, false);
+
+  auto start = std::chrono::steady_clock::now();
+  std::shared_ptr<ethash::epoch_context> light =
+      ethash::create_epoch_context(epochNumber);
+  zil::local::variables.SetLightGenerationMs(ElapsedMs(start));
+
+  {
+    std::lock_guard<std::mutex> g(m_mutexNextEpochContext);
+    if (m_nextEpochNumber != epochNumber) {
+      m_nextEpochContextFull.reset();
+    }
+    m_nextEpochNumber = epochNumber;
+    m_nextEpochContextLight = std::move(light);
+    m_nextEpochContextReady = !fullDataset;
+  }
+
+  if (fullDataset) {
+    start = std::chrono::steady_clock::now();
+    std::shared_ptr<ethash::epoch_context_full> full =
+        ethash::create_epoch_context_full(epochNumber);
+    {
+      std::lock_guard<std::mutex> g(m_mutexNextEpochContext);
+      m_nextEpochContextFull = full;
+    }
+
+    WarmFullDataset(*full);
+    zil::local::variables.SetFullGenerationMs(ElapsedMs(start));
+
+    std::lock_guard<std::mutex> g(m_mutexNextEpochContext);
+    m_nextEpochContextReady = !m_stopPregen;
+  }
+
+  zil::local::variables.SetNextEpoch(epochNumber, !m_stopPregen);
+  LOG_GENERAL(INFO, "Pregenerated context of epoch " << epochNumber);
+}
+
+void POW::WarmFullDataset(const ethash::epoch_context_full& context) {
+  // The library builds the dataset lazily as hashes read it, so hashing
+  // with arbitrary nonces builds it ahead of the mining.
+  const uint64_t numHashes =
+      context.full_dataset_num_items / DATASET_ITEMS_PER_WARM_HASH;
+  const ethash_hash256 headerHash{};
+  for (uint64_t nonce = 0; nonce < numHashes && !m_stopPregen; ++nonce) {
+    ethash::hash(context, headerHash, nonce);
+  }
+}
+
 ethash_mining_result_t POW::MineGetWork(uint64_t blockNum,
                                         ethash_hash256 const& headerHash,
                                         uint8_t difficulty, int timeWindow, const HeaderHashParams& headerParams) {
@@ -287,72 +554,114 @@ ethash_mining_result_t POW::MineGetWork(uint64_t blockNum,
   return result;
 }
 
-ethash_mining_result_t POW::MineLight(ethash_hash256 const& headerHash,
-                                      ethash_hash256 const& boundary,
-                                      uint64_t startNonce, int timeWindow) {
-  uint64_t nonce = startNonce;
-  auto startTime = std::chrono::high_resolution_clock::now();
+unsigned int POW::GetPoWVerifyThreads() {
+  if (POW_VERIFY_THREADS > 0) {
+    return POW_VERIFY_THREADS;
+  }
+  return std::max(1u, std::thread::hardware_concurrency());
+}
 
-  while (m_shouldMine) {
-    auto mineResult = ethash::hash(*m_epochContextLight, headerHash, nonce);
-    if (ethash::is_less_or_equal(mineResult.final_hash, boundary)) {
-      ethash_mining_result_t winning_result = {
-          BlockhashToHexString(mineResult.final_hash),
-          BlockhashToHexString(mineResult.mix_hash), nonce, {}, true};
-      return winning_result;
-    }
-    nonce++;
+unsigned int POW::GetCpuMineThreads() {
+  if (CPU_MINE_THREADS > 0) {
+    return CPU_MINE_THREADS;
+  }
+  return std::max(1u, std::thread::hardware_concurrency());
+}
 
-    auto currentTime = std::chrono::high_resolution_clock::now();
-    auto timePassedInSeconds = std::chrono::duration_cast<std::chrono::seconds>(
-                                   currentTime - startTime)
-                                   .count();
-    if (timePassedInSeconds > timeWindow) {
-      LOG_GENERAL(WARNING,
-                  "Time out while mining pow result, time "
-                  "passed in seconds "
-                      << timePassedInSeconds << ", time window " << timeWindow);
-      m_shouldMine = false;
-      break;
+template <class EpochContext>
+ethash_mining_result_t POW::MineCpu(const EpochContext& context,
+                                    ethash_hash256 const& headerHash,
+                                    ethash_hash256 const& boundary,
+                                    uint64_t startNonce, int timeWindow,
+                                    unsigned int numThreads) {
+  numThreads = std::max(1u, numThreads);
+  const uint64_t nonceStride =
+      std::numeric_limits<uint64_t>::max() / numThreads;
+  const auto startTime = std::chrono::steady_clock::now();
+  const auto deadline = startTime + std::chrono::seconds(timeWindow);
+
+  std::atomic<bool> found{false};
+  std::atomic<bool> timedOut{false};
+  std::atomic<uint64_t> totalHashes{0};
+  ethash_mining_result_t winning_result = {"", "", 0, {}, false};
+
+  auto mine = [&](uint64_t nonce) {
+    uint64_t hashes = 0;
+    while (m_shouldMine && !found) {
+      auto mineResult = ethash::hash(context, headerHash, nonce);
+      ++hashes;
+      if (ethash::is_less_or_equal(mineResult.final_hash, boundary)) {
+        bool expected = false;
+        if (found.compare_exchange_strong(expected, true)) {
+          winning_result = {BlockhashToHexString(mineResult.final_hash),
+                            BlockhashToHexString(mineResult.mix_hash), nonce,
+                            {}, true};
+        }
+        break;
+      }
+      nonce++;
+
+      if (hashes % MINE_TIME_CHECK_INTERVAL == 0 &&
+          std::chrono::steady_clock::now() > deadline) {
+        timedOut = true;
+        break;
+      }
     }
+    totalHashes += hashes;
+  };
+
+  // Thread i searches from startNonce + i * nonceStride
+  std::vector<std::thread> threads;
+  for (unsigned int i = 1; i < numThreads; ++i) {
+    threads.emplace_back(mine, startNonce + i * nonceStride);
+  }
+  mine(startNonce);
+  for (auto& thread : threads) {
+    thread.join();
   }
 
-  ethash_mining_result_t failure_result = {"", "", 0, {}, false};
-  return failure_result;
+  const auto elapsedUs = std::chrono::duration_cast<std::chrono::microseconds>(
+                             std::chrono::steady_clock::now() - startTime)
+                             .count();
+  m_cpuHashrate = elapsedUs > 0 ? totalHashes * 1000000 / elapsedUs : 0;
+  zil::local::variables.SetCpuHashrate(m_cpuHashrate, numThreads);
+  LOG_GENERAL(INFO, "Mined " << totalHashes << " hashes on " << numThreads
+                             << " threads at " << m_cpuHashrate
+                             << " hashes/s");
+
+  if (timedOut && !found) {
+    LOG_GENERAL(WARNING, "Time out while mining pow result, time window "
+                             << timeWindow);
+    m_shouldMine = false;
+  }
+
+  return winning_result;
+}
+
+ethash_mining_result_t POW::MineLight(ethash_hash256 const& headerHash,
+                                      ethash_hash256 const& boundary,
+                                      uint64_t startNonce, int timeWindow,
+                                      unsigned int numThreads) {
+  std::shared_ptr<ethash::epoch_context> context;
+  {
+    std::lock_guard<std::mutex> g(m_mutexLightClientConfigure);
+    context = m_epochContextLight;
+  }
+  return MineCpu(*context, headerHash, boundary, startNonce, timeWindow,
+                 numThreads);
 }
 
 ethash_mining_result_t POW::MineFull(ethash_hash256 const& headerHash,
                                      ethash_hash256 const& boundary,
-                                     uint64_t startNonce, int timeWindow) {
-  uint64_t nonce = startNonce;
-  auto startTime = std::chrono::high_resolution_clock::now();
-
-  while (m_shouldMine) {
-    auto mineResult = ethash::hash(*m_epochContextFull, headerHash, nonce);
-    if (ethash::is_less_or_equal(mineResult.final_hash, boundary)) {
-      ethash_mining_result_t winning_result = {
-          BlockhashToHexString(mineResult.final_hash),
-          BlockhashToHexString(mineResult.mix_hash), nonce, {}, true};
-      return winning_result;
-    }
-    nonce++;
-
-    auto currentTime = std::chrono::high_resolution_clock::now();
-    auto timePassedInSeconds = std::chrono::duration_cast<std::chrono::seconds>(
-                                   currentTime - startTime)
-                                   .count();
-    if (timePassedInSeconds > timeWindow) {
-      LOG_GENERAL(WARNING,
-                  "Time out while mining pow result, time "
-                  "passed in seconds "
-                      << timePassedInSeconds << ", time window " << timeWindow);
-      m_shouldMine = false;
-      break;
-    }
+                                     uint64_t startNonce, int timeWindow,
+                                     unsigned int numThreads) {
+  std::shared_ptr<ethash::epoch_context_full> context;
+  {
+    std::lock_guard<std::mutex> g(m_mutexLightClientConfigure);
+    context = m_epochContextFull;
   }
-
-  ethash_mining_result_t failure_result = {"", "", 0, {}, false};
-  return failure_result;
+  return MineCpu(*context, headerHash, boundary, startNonce, timeWindow,
+                 numThreads);
 }
 
 ethash_mining_result_t POW::MineFullGPU(uint64_t blockNum,
@@ -933,13 +1242,30 @@ ethash_mining_result_t POW::PoWMine(uint64_t blockNum, uint8_t difficulty,
     result =
         MineFullGPU(blockNum, headerHash, difficulty, startNonce, timeWindow);
   } else if (fullDataset) {
-    result = MineFull(headerHash, boundary, startNonce, timeWindow);
+    result = MineFull(headerHash, boundary, startNonce, timeWindow,
+                      GetCpuMineThreads());
   } else {
-    result = MineLight(headerHash, boundary, startNonce, timeWindow);
+    result = MineLight(headerHash, boundary, startNonce, timeWindow,
+                       GetCpuMineThreads());
   }
   return result;
 }
 
+ethash_mining_result_t POW::PoWMineCpu(uint64_t blockNum,
+                                       const ethash_hash256& headerHash,
+                                       const ethash_hash256& boundary,
+                                       bool fullDataset, uint64_t startNonce,
+                                       int timeWindow,
+                                       unsigned int numThreads) {
+  std::lock_guard<std::mutex> g(m_mutexPoWMine);
+  EthashConfigureClient(blockNum, fullDataset);
+  m_shouldMine = true;
+  if (fullDataset) {
+    return MineFull(headerHash, boundary, startNonce, timeWindow, numThreads);
+  }
+  return MineLight(headerHash, boundary, startNonce, timeWindow, numThreads);
+}
+
 bool POW::PoWVerify(uint64_t blockNum, uint8_t difficulty,
                     const ethash_hash256& headerHash, uint64_t winning_nonce,
                     const std::string& winning_result,
@@ -955,8 +1281,120 @@ bool POW::PoWVerify(uint64_t blockNum, uint8_t difficulty,
     return false;
   }
 
-  return ethash::verify(*m_epochContextLight, headerHash, winningMixhash,
-                        winning_nonce, boundary);
+  std::shared_ptr<ethash::epoch_context> context;
+  {
+    std::lock_guard<std::mutex> g(m_mutexLightClientConfigure);
+    context = m_epochContextLight;
+  }
+
+  return VerifySolution(*context, headerHash, winning_nonce, winningMixhash,
+                        boundary);
+}
+
+std::vector<bool> POW::PoWVerifyBatch(
+    const std::vector<PoWVerifyRequest>& requests, unsigned int numThreads) {
+  LOG_MARKER();
+  std::vector<uint8_t> verified(requests.size(), false);
+  if (requests.empty()) {
+    return {};
+  }
+
+  const auto start = std::chrono::steady_clock::now();
+  EthashConfigureClient(requests.front().blockNum);
+  std::shared_ptr<ethash::epoch_context> context;
+  {
+    std::lock_guard<std::mutex> g(m_mutexLightClientConfigure);
+    context = m_epochContextLight;
+  }
+
+  // Requests of another ethash epoch can't use the shared context, they are
+  // verified one by one afterwards
+  std::vector<size_t> otherEpoch;
+  std::mutex mutexOtherEpoch;
+  std::atomic<size_t> next{0};
+  auto verifyRequests = [&]() {
+    for (size_t i = next++; i < requests.size(); i = next++) {
+      const auto& request = requests[i];
+      if (ethash::get_epoch_number(request.blockNum) !=
+          context->epoch_number) {
+        std::lock_guard<std::mutex> g(mutexOtherEpoch);
+        otherEpoch.emplace_back(i);
+        continue;
+      }
+
+      const auto boundary = DifficultyLevelInIntDevided(request.difficulty);
+      if (!ethash::is_less_or_equal(StringToBlockhash(request.result),
+                                    boundary)) {
+        continue;
+      }
+      verified[i] =
+          VerifySolution(*context, request.headerHash, request.nonce,
+                         StringToBlockhash(request.mixHash), boundary);
+    }
+  };
+
+  if (numThreads == 0) {
+    numThreads = GetPoWVerifyThreads();
+  }
+  numThreads = std::min<size_t>(numThreads, requests.size());
+
+  std::vector<std::future<void>> futures;
+  for (unsigned int t = 1; t < numThreads; ++t) {
+    futures.emplace_back(std::async(std::launch::async, verifyRequests));
+  }
+  verifyRequests();
+  for (auto& future : futures) {
+    future.get();
+  }
+
+  for (const auto i : otherEpoch) {
+    const auto& request = requests[i];
+    verified[i] = PoWVerify(request.blockNum, request.difficulty,
+                            request.headerHash, request.nonce, request.result,
+                            request.mixHash);
+  }
+
+  zil::local::variables.SetVerifyBatch(requests.size(), ElapsedMs(start));
+  return {verified.begin(), verified.end()};
+}
+
+bool POW::VerifySolution(const ethash::epoch_context& context,
+                         const ethash_hash256& headerHash, uint64_t nonce,
+                         const ethash_hash256& mixHash,
+                         const ethash_hash256& boundary) {
+  // The final hash is cheap to check, only the mix hash needs the dataset
+  if (!ethash::verify_final_hash(headerHash, mixHash, nonce, boundary)) {
+    return false;
+  }
+
+  VerifiedKey key{};
+  std::copy(std::begin(headerHash.bytes), std::end(headerHash.bytes),
+            key.begin());
+  std::copy(std::begin(mixHash.bytes), std::end(mixHash.bytes),
+            key.begin() + UINT256_SIZE);
+  for (size_t i = 0; i < sizeof(nonce); ++i) {
+    key[2 * UINT256_SIZE + i] = static_cast<uint8_t>(nonce >> (8 * i));
+  }
+
+  {
+    std::lock_guard<std::mutex> g(m_mutexVerified);
+    const bool hit = m_verified.find(key) != m_verified.end();
+    zil::local::variables.AddVerifyCacheLookup(hit);
+    if (hit) {
+      return true;
+    }
+  }
+
+  if (!ethash::verify(context, headerHash, mixHash, nonce, boundary)) {
+    return false;
+  }
+
+  std::lock_guard<std::mutex> g(m_mutexVerified);
+  if (m_verified.size() >= MAX_VERIFIED_ENTRIES) {
+    m_verified.clear();
+  }
+  m_verified.emplace(key);
+  return true;
 }
 
 ethash::result POW::LightHash(uint64_t blockNum,
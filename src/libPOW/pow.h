@@ -20,7 +20,9 @@
 
 #include <stdint.h>
 #include <array>
+#include <atomic>
 #include <mutex>
+#include <set>
 #include <string>
 #include <thread>
 #include <vector>
@@ -56,6 +58,16 @@ struct HeaderHashParams {
   uint128_t gasPrice;
 };
 
+/// A proof-of-work submission to verify as part of a batch.
+struct PoWVerifyRequest {
+  uint64_t blockNum;
+  uint8_t difficulty;
+  ethash_hash256 headerHash;
+  uint64_t nonce;
+  std::string result;
+  std::string mixHash;
+};
+
 /// Implements the proof-of-work functionality.
 class POW {
   static std::string BytesToHexString(const uint8_t* str, const uint64_t s);
@@ -96,6 +108,27 @@ class POW {
                                  bool fullDataset, uint64_t startNonce,
                                  int timeWindow, const HeaderHashParams& headerParams);
 
+  /// Mines on the CPU with numThreads threads, each one searching its own
+  /// range of nonces. Put it to public function so can directly benchmark it.
+  ethash_mining_result_t PoWMineCpu(uint64_t blockNum,
+                                    const ethash_hash256& headerHash,
+                                    const ethash_hash256& boundary,
+                                    bool fullDataset, uint64_t startNonce,
+                                    int timeWindow, unsigned int numThreads);
+
+  /// Number of CPU mining threads, CPU_MINE_THREADS or all hardware threads.
+  static unsigned int GetCpuMineThreads();
+
+  /// Hashes per second achieved by the last CPU mining.
+  uint64_t GetCpuHashrate() const { return m_cpuHashrate; }
+
+  /// Starts building the contexts of the epoch following blockNum in the
+  /// background, if it is within ETHASH_PREGEN_BLOCKS_AHEAD blocks.
+  void PregenerateNextEpochContext(uint64_t blockNum, bool fullDataset);
+
+  /// True once the contexts of the given epoch have been pregenerated.
+  bool IsEpochContextReady(int epochNumber, bool fullDataset);
+
   /// Terminates proof-of-work mining.
   void StopMining();
 
@@ -104,6 +137,16 @@ class POW {
                  const ethash_hash256& headerHash, uint64_t winning_nonce,
                  const std::string& winning_result,
                  const std::string& winning_mixhash);
+
+  /// Verifies a batch of proof-of-work submissions on numThreads threads
+  /// sharing one epoch context, 0 to use GetPoWVerifyThreads().
+  std::vector<bool> PoWVerifyBatch(
+      const std::vector<PoWVerifyRequest>& requests,
+      unsigned int numThreads = 0);
+
+  /// Number of verification threads, POW_VERIFY_THREADS or all hardware
+  /// threads.
+  static unsigned int GetPoWVerifyThreads();
   static zbytes ConcatAndhash(
       const std::array<unsigned char, UINT256_SIZE>& rand1,
       const std::array<unsigned char, UINT256_SIZE>& rand2, const Peer& peer,
@@ -148,6 +191,7 @@ class POW {
   std::shared_ptr<ethash::epoch_context_full> m_epochContextFull = nullptr;
   uint64_t m_currentBlockNum;
   std::atomic<bool> m_shouldMine{};
+  std::atomic<uint64_t> m_cpuHashrate{};
   std::vector<dev::eth::MinerPtr> m_miners;
   std::vector<ethash_mining_result_t> m_vecMiningResult;
   std::atomic<int> m_minerIndex{};
@@ -155,12 +199,49 @@ class POW {
   std::mutex m_mutexMiningResult;
   std::unique_ptr<jsonrpc::HttpClient> m_httpClient;
 
+  // Contexts of the next ethash epoch, built by m_pregenThread
+  std::mutex m_mutexNextEpochContext;
+  int m_nextEpochNumber = -1;
+  std::shared_ptr<ethash::epoch_context> m_nextEpochContextLight = nullptr;
+  std::shared_ptr<ethash::epoch_context_full> m_nextEpochContextFull =
+      nullptr;
+  bool m_nextEpochContextReady = false;
+  std::thread m_pregenThread;
+  std::atomic<bool> m_pregenRunning{};
+  std::atomic<bool> m_stopPregen{};
+
+  // Submissions whose mix hash was verified, so that verifying them again
+  // (e.g. against another difficulty) only needs the final hash
+  using VerifiedKey = std::array<uint8_t, 2 * UINT256_SIZE + sizeof(uint64_t)>;
+  std::mutex m_mutexVerified;
+  std::set<VerifiedKey> m_verified;
+
+  bool VerifySolution(const ethash::epoch_context& context,
+                      const ethash_hash256& headerHash, uint64_t nonce,
+                      const ethash_hash256& mixHash,
+                      const ethash_hash256& boundary);
+
+  void GenerateEpochContext(int epochNumber, bool fullDataset);
+  void WarmFullDataset(const ethash::epoch_context_full& context);
+  std::shared_ptr<ethash::epoch_context> TakeEpochContextLight(
+      int epochNumber);
+  std::shared_ptr<ethash::epoch_context_full> TakeEpochContextFull(
+      int epochNumber);
+
   ethash_mining_result_t MineLight(ethash_hash256 const& headerHash,
                                    ethash_hash256 const& boundary,
-                                   uint64_t startNonce, int timeWindow);
+                                   uint64_t startNonce, int timeWindow,
+                                   unsigned int numThreads);
   ethash_mining_result_t MineFull(ethash_hash256 const& headerHash,
                                   ethash_hash256 const& boundary,
-                                  uint64_t startNonce, int timeWindow);
+                                  uint64_t startNonce, int timeWindow,
+                                  unsigned int numThreads);
+  template <class EpochContext>
+  ethash_mining_result_t MineCpu(const EpochContext& context,
+                                 ethash_hash256 const& headerHash,
+                                 ethash_hash256 const& boundary,
+                                 uint64_t startNonce, int timeWindow,
+                                 unsigned int numThreads);
   ethash_mining_result_t MineGetWork(uint64_t blockNum,
                                      ethash_hash256 const& headerHash,
                                      uint8_t difficulty, int timeWindow,
@@ -21,8 +21,8 @@
 #include <iomanip>
 #include <iostream>
 #include <string>
+#include <unordered_map>
 
-#include <boost/lexical_cast.hpp>
 
 #include "BlockStorage.h"
 #include "common/Constants.h"
@@ -32,6 +32,7 @@
 #include "libData/BlockChainData/BlockLinkChain.h"
 #include "libMessage/Messenger.h"
 #include "libMetrics/Api.h"
+#include "libMetrics/EpochTimeline.h"
 #include "libMetrics/TracedIds.h"
 #include "libPersistence/ContractStorage.h"
 #include "libUtils/DataConversion.h"
@@ -69,6 +70,7 @@ void BlockStorage::Initialize(const std::string& path, bool diagnostic) {
   if (LOOKUP_NODE_MODE) {
     m_txBodyDBs.emplace_back(std::make_shared<LevelDB>("txBodies"));
     m_txEpochDB = std::make_shared<LevelDB>("txEpochs");
+    m_txLocationDB = std::make_shared<LevelDB>("txLocations");
     m_txTraceDB = std::make_shared<LevelDB>("txTraces");
     m_otterTraceDB = std::make_shared<LevelDB>("otterTraces");
     m_otterTxAddressMappingDB =
@@ -143,6 +145,8 @@ bool BlockStorage::PutTxBlock(const TxBlockHeader& blockHeader,
       TracedIds::GetInstance().GetCurrentEpochSpanIds());
   span.SetAttribute("block.type", "Tx");
   span.SetAttribute("block.num", blockHeader.GetBlockNum());
+  EpochPhaseScope persistencePhase(EpochPhase::PERSISTENCE,
+                                   blockHeader.GetBlockNum());
 
   const auto status = PutBlock(blockHeader.GetBlockNum(), body, BlockType::Tx);
   if (status) {
@@ -198,6 +202,88 @@ bool BlockStorage::PutTxBody(const uint64_t& epochNum, const dev::h256& key,
   return true;
 }
 
+bool BlockStorage::PutTxLocations(const MicroBlock& microBlock) {
+  if (!LOOKUP_NODE_MODE) {
+    LOG_GENERAL(WARNING, "Non lookup node should not trigger this.");
+    return false;
+  }
+
+  const auto& tranHashes = microBlock.GetTranHashes();
+  if (tranHashes.empty()) {
+    return true;
+  }
+
+  TxLocation location;
+  location.m_blockNum = microBlock.GetHeader().GetEpochNum();
+
+  TxBlockSharedPtr txBlock;
+  if (!GetTxBlock(location.m_blockNum, txBlock)) {
+    LOG_GENERAL(WARNING, "Missing TxBlock " << location.m_blockNum
+                                            << " for microblock "
+                                            << microBlock.GetBlockHash());
+    return false;
+  }
+
+  // Count the transactions of the preceding microblocks once per microblock,
+  // the same way EthRpcMethods::GetTransactionIndexFromBlock does per query
+  const auto& microBlockInfos = txBlock->GetMicroBlockInfos();
+  uint64_t baseIndex = 0;
+  bool baseIndexKnown = true;
+  bool found = false;
+  for (uint32_t i = 0; i < microBlockInfos.size(); ++i) {
+    const auto& mbInfo = microBlockInfos[i];
+    if (mbInfo.m_microBlockHash == microBlock.GetBlockHash()) {
+      location.m_mbIndex = i;
+      found = true;
+      break;
+    }
+    if (mbInfo.m_txnRootHash == TxnHash{}) {
+      continue;
+    }
+    MicroBlockSharedPtr prevMicroBlock;
+    if (!GetMicroBlock(mbInfo.m_microBlockHash, prevMicroBlock)) {
+      baseIndexKnown = false;
+      continue;
+    }
+    baseIndex += prevMicroBlock->GetTranHashes().size();
+  }
+
+  if (!found) {
+    LOG_GENERAL(WARNING, "Microblock " << microBlock.GetBlockHash()
+                                       << " not in TxBlock "
+                                       << location.m_blockNum);
+    return false;
+  }
+
+  std::unordered_map<std::string, std::string> batch;
+  for (uint32_t i = 0; i < tranHashes.size(); ++i) {
+    location.m_txIndexInMb = i;
+    if (baseIndexKnown) {
+      location.m_txIndexInBlock = baseIndex + i;
+    }
+
+    zbytes value;
+    if (!Messenger::SetTxLocation(value, 0, location)) {
+      LOG_GENERAL(WARNING, "Messenger::SetTxLocation failed.");
+      return false;
+    }
+    const zbytes& keyBytes = tranHashes[i].asBytes();
+    batch.emplace(std::string(keyBytes.begin(), keyBytes.end()),
+                  std::string(value.begin(), value.end()));
+  }
+
+  lock_guard<mutex> g(m_mutexTxBody);
+
+  if (!m_txLocationDB) {
+    LOG_GENERAL(
+        WARNING,
+        "Attempt to access non initialized DB! Are you in lookup mode? ");
+    return false;
+  }
+
+  return m_txLocationDB->BatchInsert(batch);
+}
+
 bool BlockStorage::PutProcessedTxBodyTmp(const dev::h256& key,
                                          const zbytes& body) {
   int ret;
@@ -222,6 +308,7 @@ bool BlockStorage::PutMicroBlock(const BlockHash& blockHash,
       TracedIds::GetInstance().GetCurrentEpochSpanIds());
   span.SetAttribute("block.type", "MicroBlock");
   span.SetAttribute("block.hash", blockHash.hex());
+  EpochPhaseScope persistencePhase(EpochPhase::PERSISTENCE, epochNum);
 
   lock_guard<mutex> g(m_mutexMicroBlock);
 
@@ -394,6 +481,7 @@ bool BlockStorage::ReleaseDB() {
     }
     m_txBodyDBs.clear();
     m_txEpochDB.reset();
+    m_txLocationDB.reset();
   }
   {
     lock_guard<mutex> g(m_mutexMicroBlock);
@@ -515,14 +603,7 @@ bool BlockStorage::GetLatestTxBlock(TxBlockSharedPtr& block) {
 
   {
     shared_lock<shared_timed_mutex> g(m_mutexTxBlockchain);
-    std::unique_ptr<leveldb::Iterator> it{
-        m_txBlockchainDB->GetDB()->NewIterator(leveldb::ReadOptions())};
-    for (it->SeekToFirst(); it->Valid(); it->Next()) {
-      uint64_t blockNum = boost::lexical_cast<uint64_t>(it->key().ToString());
-      if (blockNum > latestTxBlockNum) {
-        latestTxBlockNum = blockNum;
-      }
-    }
+    m_txBlockchainDB->GetLastBlockNum(latestTxBlockNum);
   }
 
   LOG_GENERAL(INFO, "Latest Tx block = " << latestTxBlockNum);
@@ -564,6 +645,31 @@ bool BlockStorage::GetTxBody(const dev::h256& key, TxBodySharedPtr& body) {
   return true;
 }
 
+bool BlockStorage::GetTxLocation(const dev::h256& key, TxLocation& location) {
+  const zbytes& keyBytes = key.asBytes();
+
+  string locationString;
+  {
+    lock_guard<mutex> g(m_mutexTxBody);
+
+    if (!m_txLocationDB) {
+      LOG_GENERAL(
+          WARNING,
+          "Attempt to access non initialized DB! Are you in lookup mode? ");
+      return false;
+    }
+
+    locationString = m_txLocationDB->Lookup(keyBytes);
+  }
+
+  if (locationString.empty()) {
+    return false;
+  }
+
+  return Messenger::GetTxLocation(
+      zbytes(locationString.begin(), locationString.end()), 0, location);
+}
+
 bool BlockStorage::CheckTxBody(const dev::h256& key) {
   const zbytes& keyBytes = key.asBytes();
 
@@ -774,7 +880,8 @@ bool BlockStorage::GetAllDSBlocks(std::list<DSBlockSharedPtr>& blocks) {
   std::unique_ptr<leveldb::Iterator> it{
       m_dsBlockchainDB->GetDB()->NewIterator(leveldb::ReadOptions())};
   for (it->SeekToFirst(); it->Valid(); it->Next()) {
-    string bns = it->key().ToString();
+    uint64_t blockNum = 0;
+    LevelDB::ParseBlockNumKey(it->key(), blockNum);
     string blockString = it->value().ToString();
     if (blockString.empty()) {
       LOG_GENERAL(WARNING, "Lost one block in the chain");
@@ -784,7 +891,7 @@ bool BlockStorage::GetAllDSBlocks(std::list<DSBlockSharedPtr>& blocks) {
     auto block = std::make_shared<DSBlock>();
     block->Deserialize(zbytes(blockString.begin(), blockString.end()), 0);
     blocks.emplace_back(block);
-    LOG_GENERAL(INFO, "Retrievd DsBlock Num:" << bns);
+    LOG_GENERAL(INFO, "Retrievd DsBlock Num:" << blockNum);
   }
 
   if (blocks.empty()) {
@@ -967,7 +1074,8 @@ bool BlockStorage::GetAllBlockLink(std::list<BlockLink>& blocklinks) {
   std::unique_ptr<leveldb::Iterator> it{
       m_blockLinkDB->GetDB()->NewIterator(leveldb::ReadOptions())};
   for (it->SeekToFirst(); it->Valid(); it->Next()) {
-    string bns = it->key().ToString();
+    uint64_t index = 0;
+    LevelDB::ParseBlockNumKey(it->key(), index);
     string blockString = it->value().ToString();
     if (blockString.empty()) {
       LOG_GENERAL(WARNING, "Lost one blocklink in the chain");
@@ -976,7 +1084,7 @@ bool BlockStorage::GetAllBlockLink(std::list<BlockLink>& blocklinks) {
     BlockLink blcklink;
     if (!Messenger::GetBlockLink(zbytes(blockString.begin(), blockString.end()),
                                  0, blcklink)) {
-      LOG_GENERAL(WARNING, "Deserialization of blockLink failed " << bns);
+      LOG_GENERAL(WARNING, "Deserialization of blockLink failed " << index);
       return false;
     }
     if (get<BlockLinkIndex::VERSION>(blcklink) != BLOCKLINK_VERSION) {
@@ -1247,6 +1355,7 @@ bool BlockStorage::GetShardStructure(DequeOfShardMembers& shards) {
 bool BlockStorage::PutStateDelta(const uint64_t& finalBlockNum,
                                  const zbytes& stateDelta) {
   LOG_MARKER();
+  EpochPhaseScope persistencePhase(EpochPhase::PERSISTENCE, finalBlockNum);
 
   unique_lock<shared_timed_mutex> g(m_mutexStateDelta);
 
@@ -1710,6 +1819,7 @@ bool BlockStorage::ResetDB(DBTYPE type) {
     case TX_BODY: {
       lock_guard<mutex> g(m_mutexTxBody);
       ret = m_txEpochDB->ResetDB();
+      ret &= m_txLocationDB->ResetDB();
       for (auto& txBodyDB : m_txBodyDBs) {
         ret &= txBodyDB->ResetDB();
       }
@@ -1827,6 +1937,7 @@ bool BlockStorage::RefreshDB(DBTYPE type) {
     case TX_BODY: {
       lock_guard<mutex> g(m_mutexTxBody);
       ret = m_txEpochDB->RefreshDB();
+      ret &= m_txLocationDB->RefreshDB();
       for (auto& txBodyDB : m_txBodyDBs) {
         ret &= txBodyDB->RefreshDB();
       }
@@ -26,6 +26,7 @@
 #include <Schnorr.h>
 #include "libBlockchain/Block.h"
 #include "libData/AccountData/Address.h"
+#include "libData/BlockChainData/TxLocation.h"
 #include "libData/MiningData/MinerInfo.h"
 
 typedef std::tuple<uint32_t, uint64_t, uint64_t, BlockType, BlockHash>
@@ -86,6 +87,7 @@ class BlockStorage : boost::noncopyable {
   std::vector<std::shared_ptr<LevelDB>> m_txBodyDBs;
   std::shared_ptr<LevelDB> m_txBodyOrigDB;
   std::shared_ptr<LevelDB> m_txEpochDB;
+  std::shared_ptr<LevelDB> m_txLocationDB;
   std::shared_ptr<LevelDB> m_txTraceDB;
   std::shared_ptr<LevelDB> m_otterTraceDB;
   std::shared_ptr<LevelDB> m_otterTxAddressMappingDB;
@@ -167,6 +169,9 @@ class BlockStorage : boost::noncopyable {
   bool PutTxBody(const uint64_t& epochNum, const dev::h256& key,
                  const zbytes& body);
 
+  /// Adds the locations of all transactions in a committed microblock.
+  bool PutTxLocations(const MicroBlock& microBlock);
+
   bool PutProcessedTxBodyTmp(const dev::h256& key, const zbytes& body);
 
   /// Retrieves the requested DS block.
@@ -202,6 +207,9 @@ class BlockStorage : boost::noncopyable {
   /// Retrieves the requested transaction body.
   bool GetTxBody(const dev::h256& key, TxBodySharedPtr& body);
 
+  /// Retrieves the location of the requested transaction within its Tx block.
+  bool GetTxLocation(const dev::h256& key, TxLocation& location);
+
   /// Retrieves the requested transaction trace.
   bool PutTxTrace(const dev::h256& key, const std::string& trace);
   bool GetTxTrace(const dev::h256& key, std::string& trace);
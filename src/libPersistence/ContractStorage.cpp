@@ -639,60 +639,162 @@ bool ContractStorage::FetchStateJsonForContract(Json::Value& _json,
     /// addr+vname+[indices...]
     vector<string> map_indices(fragments.begin() + 2, fragments.end());
 
-    std::function<void(Json::Value&, const vector<string>&, const zbytes&,
-                       unsigned int, int)>
-        jsonMapWrapper = [&](Json::Value& _json, const vector<string>& indices,
-                             const zbytes& value, unsigned int cur_index,
-                             int mapdepth) -> void {
-      if (cur_index + 1 < indices.size()) {
-        string key = indices.at(cur_index);
-        UnquoteString(key);
-        jsonMapWrapper(_json[key], indices, value, cur_index + 1, mapdepth);
+    InsertStateValueToJson(_json[vname], map_indices, state.second, 0,
+                           FetchMapDepth(address, vname, temp));
+  }
+
+  return true;
+}
+
+int ContractStorage::FetchMapDepth(const dev::h160& address,
+                                   const string& vname, bool temp) {
+  map<string, zbytes> map_depth;
+  string map_depth_key =
+      GenerateStorageKey(address, MAP_DEPTH_INDICATOR, {vname});
+  FetchStateDataForKey(map_depth, map_depth_key, temp);
+
+  return !map_depth.empty() ? std::stoi(DataConversion::CharArrayToString(
+                                  map_depth[map_depth_key]))
+                            : -1;
+}
+
+void ContractStorage::InsertStateValueToJson(Json::Value& _json,
+                                             const vector<string>& indices,
+                                             const zbytes& value,
+                                             unsigned int cur_index,
+                                             int mapdepth) {
+  if (cur_index + 1 < indices.size()) {
+    string key = indices.at(cur_index);
+    UnquoteString(key);
+    InsertStateValueToJson(_json[key], indices, value, cur_index + 1,
+                           mapdepth);
+  } else {
+    if (mapdepth > 0) {
+      if ((int)indices.size() == mapdepth) {
+        InsertValueToStateJson(_json, indices.at(cur_index),
+                               DataConversion::CharArrayToString(value));
       } else {
-        if (mapdepth > 0) {
-          if ((int)indices.size() == mapdepth) {
-            InsertValueToStateJson(_json, indices.at(cur_index),
-                                   DataConversion::CharArrayToString(value));
-          } else {
-            if (indices.empty()) {
-              _json = Json::objectValue;
-            } else {
-              string key = indices.at(cur_index);
-              UnquoteString(key);
-              _json[key] = Json::objectValue;
-            }
-          }
-        } else if (mapdepth == 0) {
-          InsertValueToStateJson(
-              _json, "", DataConversion::CharArrayToString(value), true, true);
+        if (indices.empty()) {
+          _json = Json::objectValue;
         } else {
-          /// Enters only when the fields_map_depth not available, almost
-          /// impossible Check value whether parsable to Protobuf
-          ProtoScillaVal empty_val;
-          if (empty_val.ParseFromArray(value.data(), value.size()) &&
-              empty_val.IsInitialized() && empty_val.has_mval() &&
-              empty_val.mval().m().empty()) {
-            string key = indices.at(cur_index);
-            UnquoteString(key);
-            _json[key] = Json::objectValue;
-          } else {
-            InsertValueToStateJson(_json, indices.at(cur_index),
-                                   DataConversion::CharArrayToString(value));
-          }
+          string key = indices.at(cur_index);
+          UnquoteString(key);
+          _json[key] = Json::objectValue;
         }
       }
-    };
+    } else if (mapdepth == 0) {
+      InsertValueToStateJson(
+          _json, "", DataConversion::CharArrayToString(value), true, true);
+    } else {
+      /// Enters only when the fields_map_depth not available, almost
+      /// impossible Check value whether parsable to Protobuf
+      ProtoScillaVal empty_val;
+      if (empty_val.ParseFromArray(value.data(), value.size()) &&
+          empty_val.IsInitialized() && empty_val.has_mval() &&
+          empty_val.mval().m().empty()) {
+        string key = indices.at(cur_index);
+        UnquoteString(key);
+        _json[key] = Json::objectValue;
+      } else {
+        InsertValueToStateJson(_json, indices.at(cur_index),
+                               DataConversion::CharArrayToString(value));
+      }
+    }
+  }
+}
 
-    map<string, zbytes> map_depth;
-    string map_depth_key =
-        GenerateStorageKey(address, MAP_DEPTH_INDICATOR, {vname});
-    FetchStateDataForKey(map_depth, map_depth_key, temp);
+bool ContractStorage::FetchStateJsonPageForContract(
+    Json::Value& _json, const dev::h160& address, const string& vname,
+    const string& keyPrefix, const string& cursor, uint32_t limit,
+    string& nextCursor) {
+  nextCursor.clear();
+
+  if (vname.empty() || IsReservedVName(vname) || limit == 0) {
+    LOG_GENERAL(WARNING, "Invalid state page query for " << vname);
+    return false;
+  }
+
+  const string base = GenerateStorageKey(address, vname, {});
+  // Map keys are stored as quoted JSON strings
+  const string prefix = keyPrefix.empty() ? base : base + '"' + keyPrefix;
+
+  string start = prefix;
+  if (!cursor.empty()) {
+    zbytes decoded;
+    if (!DataConversion::HexStrToUint8Vec(cursor, decoded)) {
+      LOG_GENERAL(WARNING, "Invalid state page cursor " << cursor);
+      return false;
+    }
+    start = base + DataConversion::CharArrayToString(decoded);
+    if (start.compare(0, prefix.size(), prefix) != 0) {
+      LOG_GENERAL(WARNING, "State page cursor does not match the prefix");
+      return false;
+    }
+  }
+
+  lock_guard<mutex> g(m_stateDataMutex);
+
+  const int mapdepth = FetchMapDepth(address, vname, false);
+  Json::Value& field = _json[vname];
+
+  // Merge the uncommitted m_stateDataMap with the database in key order, the
+  // former taking precedence, like FetchStateDataForKey does
+  std::unique_ptr<leveldb::Iterator> it(
+      m_stateDataDB.GetDB()->NewIterator(leveldb::ReadOptions()));
+  it->Seek(start);
+  auto p = m_stateDataMap.lower_bound(start);
+
+  uint32_t count = 0;
+  string lastKey;
+  while (true) {
+    const bool dbValid = it->Valid() && it->key().starts_with(prefix);
+    const bool mapValid = p != m_stateDataMap.end() &&
+                          p->first.compare(0, prefix.size(), prefix) == 0;
+    if (!dbValid && !mapValid) {
+      // No more entries, no continuation
+      lastKey.clear();
+      break;
+    }
+
+    if (count == limit) {
+      break;
+    }
+
+    string key;
+    zbytes value;
+    if (mapValid && (!dbValid || it->key().compare(p->first) >= 0)) {
+      if (dbValid && it->key() == p->first) {
+        it->Next();
+      }
+      key = p->first;
+      value = p->second;
+      ++p;
+    } else {
+      key = it->key().ToString();
+      value.assign(it->value().data(), it->value().data() + it->value().size());
+      it->Next();
+    }
+
+    // The cursor entry was returned by the previous page
+    if ((!cursor.empty() && key == start) ||
+        m_indexToBeDeleted.find(key) != m_indexToBeDeleted.cend()) {
+      continue;
+    }
 
-    jsonMapWrapper(_json[vname], map_indices, state.second, 0,
-                   !map_depth.empty()
-                       ? std::stoi(DataConversion::CharArrayToString(
-                             map_depth[map_depth_key]))
-                       : -1);
+    vector<string> fragments;
+    boost::split(fragments, key,
+                 [](char c) { return c == SCILLA_INDEX_SEPARATOR; });
+    if (fragments.back().empty()) fragments.pop_back();
+    vector<string> map_indices(fragments.begin() + 2, fragments.end());
+
+    InsertStateValueToJson(field, map_indices, value, 0, mapdepth);
+    lastKey = std::move(key);
+    ++count;
+  }
+
+  if (!lastKey.empty()) {
+    nextCursor = DataConversion::Uint8VecToHexStrRet(
+        DataConversion::StringToCharArray(lastKey.substr(base.size())));
   }
 
   return true;
@@ -1324,6 +1426,10 @@ bool ContractStorage::IsPurgeRunning() {
   return m_stateTrie.db()->IsPurgeRunning();
 }
 
+void ContractStorage::SetPurgePaused(bool paused) {
+  m_stateTrie.db()->SetPurgePaused(paused);
+}
+
 void ContractStorage::InitTempStateCore() {
   t_stateDataMap.clear();
   t_indexToBeDeleted.clear();
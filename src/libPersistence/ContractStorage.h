@@ -80,6 +80,14 @@ class ContractStorage : boost::noncopyable {
 
   void FetchProofForKey(std::set<std::string>& proof, const dev::h256& key);
 
+  int FetchMapDepth(const dev::h160& address, const std::string& vname,
+                    bool temp);
+
+  void InsertStateValueToJson(Json::Value& _json,
+                              const std::vector<std::string>& indices,
+                              const zbytes& value, unsigned int cur_index,
+                              int mapdepth);
+
   ContractStorage();
 
   ~ContractStorage() = default;
@@ -144,6 +152,19 @@ class ContractStorage : boost::noncopyable {
                                  const std::vector<std::string>& indices = {},
                                  bool temp = false);
 
+  /// Fetches at most `limit` entries of the field `vname`, whose first map key
+  /// starts with `keyPrefix`, following the entry identified by `cursor` in
+  /// storage order. Entries of m_stateDataMap not yet flushed to the database
+  /// are merged in and take precedence, as in FetchStateJsonForContract with
+  /// temp unset. `nextCursor` is set to the continuation token, or left empty
+  /// once the field is exhausted.
+  bool FetchStateJsonPageForContract(Json::Value& _json,
+                                     const dev::h160& address,
+                                     const std::string& vname,
+                                     const std::string& keyPrefix,
+                                     const std::string& cursor, uint32_t limit,
+                                     std::string& nextCursor);
+
   void FetchStateDataForKey(std::map<std::string, zbytes>& states,
                             const std::string& key, bool temp);
 
@@ -178,6 +199,8 @@ class ContractStorage : boost::noncopyable {
 
   bool IsPurgeRunning();
 
+  void SetPurgePaused(bool paused);
+
   /// Buffer the current t_map into p_map
   void BufferCurrentState();
 
@@ -22,7 +22,6 @@
 #include <bsoncxx/json.hpp>
 #include <bsoncxx/stdx/make_unique.hpp>
 #include "libServer/JSONConversion.h"
-#include "libUtils/DetachedFunction.h"
 #include "libUtils/TimeUtils.h"
 
 using namespace std;
@@ -117,6 +116,14 @@ optional<string_view> extractDbName(const string& connStr) {
 }  // namespace
 
 void RemoteStorageDB::Init(bool reset) {
+  {
+    // Writes what the previous writer still has queued with the previous
+    // pool, callers enqueueing meanwhile wait and then find no writer
+    unique_lock<shared_mutex> g(m_mutexWriter);
+    m_initialized = false;
+    m_writer.reset();
+  }
+
   try {
     if (!reset) {
       auto instance = bsoncxx::stdx::make_unique<mongocxx::instance>();
@@ -172,16 +179,15 @@ void RemoteStorageDB::Init(bool reset) {
                   "SockeTimeoutInMS: " << URI.socket_timeout_ms().value());
     }
     m_pool = bsoncxx::stdx::make_unique<mongocxx::pool>(std::move(URI));
-    mongocxx::options::bulk_write bulk_opts;
-    bulk_opts.ordered(false);
-    const auto& conn = GetConnection();
-    auto txnCollection = conn->database(m_dbName)[m_txnCollectionName];
-    auto bulk = bsoncxx::stdx::make_unique<mongocxx::bulk_write>(
-        txnCollection.create_bulk_write(bulk_opts));
-    {
-      lock_guard<mutex> g(m_mutexBulkWrite);
-      m_bulkWrite = std::move(bulk);
-    }
+    auto writer = make_unique<RemoteStorageWriter>(
+        [this](vector<RemoteStorageWriter::Op>& batch) {
+          return WriteBatch(batch);
+        },
+        REMOTESTORAGE_DB_QUEUE_SIZE, REMOTESTORAGE_DB_BATCH_SIZE,
+        chrono::milliseconds(REMOTESTORAGE_DB_BATCH_INTERVAL_MS),
+        chrono::milliseconds(REMOTESTORAGE_DB_ENQUEUE_TIMEOUT_MS));
+    unique_lock<shared_mutex> g(m_mutexWriter);
+    m_writer = std::move(writer);
     m_initialized = true;
   } catch (exception& e) {
     LOG_GENERAL(WARNING, "Failed to initialize DB: " << e.what());
@@ -223,21 +229,13 @@ bool RemoteStorageDB::InsertTxn(const Transaction& txn, const TxnStatus status,
   }
 
   try {
-    const bsoncxx::document::value& doc_val =
-        bsoncxx::from_json(tx_json.toStyledString());
-
-    mongocxx::model::insert_one insert_op{doc_val.view()};
-    {
-      lock_guard<mutex> g(m_mutexBulkWrite);
-      m_bulkWrite->append(insert_op);
-      m_bulkWriteEmpty = false;
-    }
+    mongocxx::model::insert_one insert_op{
+        bsoncxx::from_json(tx_json.toStyledString())};
+    return Enqueue(std::move(insert_op), txn.GetTranID().hex(), status);
   } catch (exception& e) {
     LOG_GENERAL(DEBUG, "Failed to InsertTxn " << e.what());
     return false;
   }
-
-  return true;
 }
 
 bool RemoteStorageDB::ExecuteWrite() {
@@ -246,44 +244,51 @@ bool RemoteStorageDB::ExecuteWrite() {
     return false;
   }
   LOG_MARKER();
-  auto resetBulkWrite = [this]() mutable {
-    mongocxx::options::bulk_write bulk_opts;
-    m_bulkWrite.reset(nullptr);
-    bulk_opts.ordered(false);
+  shared_lock<shared_mutex> g(m_mutexWriter);
+  return m_writer && m_writer->FlushAndWait();
+}
+
+bool RemoteStorageDB::WriteBatch(vector<RemoteStorageWriter::Op>& batch) {
+  try {
     const auto& conn = GetConnection();
     auto txnCollection = conn->database(m_dbName)[m_txnCollectionName];
-    auto bulk = bsoncxx::stdx::make_unique<mongocxx::bulk_write>(
-        txnCollection.create_bulk_write(bulk_opts));
-    m_bulkWrite = std::move(bulk);
-    m_bulkWriteEmpty = true;
-  };
-  lock_guard<mutex> g(m_mutexBulkWrite);
-  if (m_bulkWriteEmpty) {
-    LOG_GENERAL(INFO, "No txns for RemoteStorageDB");
-    return true;
-  }
-  try {
-    const auto& res = m_bulkWrite->execute();
+    mongocxx::options::bulk_write bulk_opts;
+    bulk_opts.ordered(false);
+    auto bulkWrite = txnCollection.create_bulk_write(bulk_opts);
+    for (const auto& op : batch) {
+      bulkWrite.append(op);
+    }
+    const auto& res = bulkWrite.execute();
 
     if (!res) {
       LOG_GENERAL(WARNING, "Failed to ExecuteWrite");
-      resetBulkWrite();
       return false;
     }
 
     LOG_GENERAL(INFO, "Inserted " << res.value().inserted_count()
                                   << " & Updated "
                                   << res.value().modified_count());
-
-    resetBulkWrite();
     return true;
   } catch (exception& e) {
     LOG_GENERAL(WARNING, "Failed to write bulk " << e.what());
-    resetBulkWrite();
     return false;
   }
 }
 
+bool RemoteStorageDB::Enqueue(RemoteStorageWriter::Op&& op,
+                              const string& txnhash, const TxnStatus status) {
+  {
+    shared_lock<shared_mutex> g(m_mutexWriter);
+    if (m_writer && m_writer->Enqueue(std::move(op))) {
+      return true;
+    }
+  }
+  // Not written, so a later update to the same status isn't a duplicate
+  lock_guard<mutex> g(m_mutexHashMapUpdateTxn);
+  m_hashMapUpdateTxn.erase(PendingTxnStatus{txnhash, status});
+  return false;
+}
+
 inline bsoncxx::stdx::optional<mongoConnection>
 RemoteStorageDB::TryGetConnection() {
   return m_pool->try_acquire();
@@ -306,27 +311,23 @@ bool RemoteStorageDB::UpdateTxn(const string& txnhash, const TxnStatus status,
   const auto& modifState = static_cast<int>(GetModificationState(status));
   try {
     const auto& currentTime = to_string(get_time_as_int());
-    const auto& query_doc = make_document(
+    auto query_doc = make_document(
         kvp("ID", txnhash),
         kvp("modificationState", make_document(kvp("$lte", modifState))));
-    const auto& doc = make_document(
+    auto doc = make_document(
         kvp("$set", make_document(kvp("status", static_cast<int>(status)),
                                   kvp("success", success),
                                   kvp("epochUpdated", to_string(epoch)),
                                   kvp("lastModified", currentTime),
                                   kvp("modificationState", modifState))));
 
-    mongocxx::model::update_one update_op{query_doc.view(), doc.view()};
-    {
-      lock_guard<mutex> g(m_mutexBulkWrite);
-      m_bulkWrite->append(update_op);
-      m_bulkWriteEmpty = false;
-    }
+    mongocxx::model::update_one update_op{std::move(query_doc),
+                                          std::move(doc)};
+    return Enqueue(std::move(update_op), txnhash, status);
   } catch (exception& e) {
     LOG_GENERAL(WARNING, "Failed to UpdateTxn " << txnhash << " " << e.what());
     return false;
   }
-  return true;
 }
 
 Json::Value RemoteStorageDB::QueryTxnHash(const dev::h256& txnhash) {
@@ -461,10 +462,12 @@ void RemoteStorageDB::ClearHashMapForUpdates() {
 }
 
 void RemoteStorageDB::ExecuteWriteDetached() {
-  auto func_detached = [this]() -> void {
-    if (!ExecuteWrite()) {
-      LOG_GENERAL(INFO, "Execute Write failed");
-    }
-  };
-  DetachedFunction(1, func_detached);
+  if (!m_initialized) {
+    LOG_GENERAL(DEBUG, "DB not initialized");
+    return;
+  }
+  shared_lock<shared_mutex> g(m_mutexWriter);
+  if (m_writer) {
+    m_writer->Flush();
+  }
 }
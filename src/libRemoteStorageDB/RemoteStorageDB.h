@@ -20,6 +20,7 @@
 
 #include "common/TxnStatus.h"
 #include "libData/AccountData/Transaction.h"
+#include "libRemoteStorageDB/RemoteStorageWriter.h"
 
 #include <mongocxx/client.hpp>
 #include <mongocxx/instance.hpp>
@@ -27,7 +28,9 @@
 
 #include <json/value.h>
 
+#include <atomic>
 #include <mutex>
+#include <shared_mutex>
 
 using mongoConnection = mongocxx::pool::entry;
 
@@ -60,19 +63,19 @@ struct PendingTxnStatusHash {
 class RemoteStorageDB : boost::noncopyable {
   std::unique_ptr<mongocxx::pool> m_pool;
   std::unique_ptr<mongocxx::instance> m_inst;
-  bool m_initialized;
-  bool m_bulkWriteEmpty;
+  std::atomic<bool> m_initialized;
   std::string m_dbName;
   const std::string m_txnCollectionName;
-  std::unique_ptr<mongocxx::bulk_write> m_bulkWrite;
-  std::mutex m_mutexBulkWrite;
   std::mutex m_mutexHashMapUpdateTxn;
   std::unordered_set<PendingTxnStatus, PendingTxnStatusHash> m_hashMapUpdateTxn;
+  // Held shared to use m_writer and exclusively by Init() to replace it
+  std::shared_mutex m_mutexWriter;
+  // Declared last so that it is stopped before the pool goes
+  std::unique_ptr<RemoteStorageWriter> m_writer;
 
  public:
   RemoteStorageDB(std::string txnCollectionName = "TransactionStatus")
       : m_initialized(false),
-        m_bulkWriteEmpty(true),
         m_txnCollectionName(std::move(txnCollectionName)) {}
 
   void Init(bool reset = false);
@@ -84,7 +87,9 @@ class RemoteStorageDB : boost::noncopyable {
   Json::Value QueryPendingTxns(const unsigned int txEpochFirstExclusive,
                                const unsigned int txEpochLastInclusive);
   ModificationState GetModificationState(const TxnStatus status) const;
+  /// Writes the queued operations and waits for them
   bool ExecuteWrite();
+  /// Has the queued operations written without waiting for them
   void ExecuteWriteDetached();
   bool IsInitialized() const;
   void ClearHashMapForUpdates();
@@ -98,6 +103,9 @@ class RemoteStorageDB : boost::noncopyable {
  private:
   mongoConnection GetConnection();
   bsoncxx::stdx::optional<mongoConnection> TryGetConnection();
+  bool WriteBatch(std::vector<RemoteStorageWriter::Op>& batch);
+  bool Enqueue(RemoteStorageWriter::Op&& op, const std::string& txnhash,
+               const TxnStatus status);
 };
 
 #endif  // ZILLIQA_SRC_LIBREMOTESTORAGEDB_REMOTESTORAGEDB_H_
@@ -0,0 +1,196 @@
+/*
+ * Copyright (C) 2023 Zilliqa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "RemoteStorageWriter.h"
+
+#include <algorithm>
+
+#include "libUtils/Logger.h"
+#include "libUtils/SetThreadName.h"
+
+using namespace std;
+
+namespace {
+
+Z_DBLHIST& GetBatchLatency() {
+  static vector<double> latencyBoundaries{1,   5,    10,   25,   50,   100,
+                                          250, 500,  1000, 2500, 5000, 10000};
+  static Z_DBLHIST histogram{Z_FL::DATABASE, "remotestorage.writer.latency",
+                             latencyBoundaries,
+                             "Duration of remote storage batch writes", "ms"};
+  return histogram;
+}
+
+}  // namespace
+
+RemoteStorageWriter::RemoteStorageWriter(WriteBatch writeBatch,
+                                         size_t maxQueued, size_t maxBatchSize,
+                                         chrono::milliseconds maxBatchDelay,
+                                         chrono::milliseconds enqueueTimeout)
+    : m_writeBatch(std::move(writeBatch)),
+      m_maxQueued(max<size_t>(maxQueued, 1)),
+      m_maxBatchSize(max<size_t>(maxBatchSize, 1)),
+      m_maxBatchDelay(maxBatchDelay),
+      m_enqueueTimeout(enqueueTimeout) {
+  m_stats.SetCallback([this](auto&& result) {
+    if (!m_stats.Enabled()) {
+      return;
+    }
+    lock_guard<mutex> g(m_mutex);
+    result.Set(m_queue.size(), {{"counter", "Queued"}});
+    result.Set(m_written, {{"counter", "Written"}});
+    result.Set(m_failed, {{"counter", "Failed"}});
+    result.Set(m_dropped, {{"counter", "Dropped"}});
+    result.Set(m_batches, {{"counter", "Batches"}});
+  });
+  m_thread = thread([this]() { Run(); });
+}
+
+RemoteStorageWriter::~RemoteStorageWriter() {
+  {
+    lock_guard<mutex> g(m_mutex);
+    m_stop = true;
+  }
+  m_cvWork.notify_all();
+  m_cvDone.notify_all();
+  m_thread.join();
+}
+
+bool RemoteStorageWriter::Enqueue(Op&& op) {
+  unique_lock<mutex> lock(m_mutex);
+  if (m_queue.size() >= m_maxQueued) {
+    if (m_overloaded ||
+        !m_cvDone.wait_for(lock, m_enqueueTimeout, [this]() {
+          return m_stop || m_queue.size() < m_maxQueued;
+        })) {
+      if (!m_overloaded) {
+        LOG_GENERAL(WARNING, "Remote storage queue full with "
+                                 << m_queue.size()
+                                 << " ops, dropping the next ones");
+      }
+      m_overloaded = true;
+      m_dropped++;
+      return false;
+    }
+  }
+  if (m_stop) {
+    m_dropped++;
+    return false;
+  }
+
+  m_queue.emplace_back(chrono::steady_clock::now(), std::move(op));
+  m_accepted++;
+  // The writer thread only needs waking to start the delay of a batch or to
+  // write a full one
+  if (m_queue.size() == 1 || m_queue.size() == m_maxBatchSize) {
+    m_cvWork.notify_one();
+  }
+  return true;
+}
+
+void RemoteStorageWriter::Flush() {
+  {
+    lock_guard<mutex> g(m_mutex);
+    if (m_queue.empty()) {
+      return;
+    }
+    m_flushRequested = true;
+  }
+  m_cvWork.notify_one();
+}
+
+bool RemoteStorageWriter::FlushAndWait() {
+  unique_lock<mutex> lock(m_mutex);
+  const uint64_t target = m_accepted;
+  const uint64_t failedBefore = m_failed;
+  if (!m_queue.empty()) {
+    m_flushRequested = true;
+    m_cvWork.notify_one();
+  }
+  m_cvDone.wait(lock, [this, target]() { return m_done >= target; });
+  return m_failed == failedBefore;
+}
+
+size_t RemoteStorageWriter::GetQueued() const {
+  lock_guard<mutex> g(m_mutex);
+  return m_queue.size();
+}
+
+void RemoteStorageWriter::Run() {
+  utility::SetThreadName("rsdb-writer");
+
+  vector<Op> batch;
+  batch.reserve(m_maxBatchSize);
+
+  unique_lock<mutex> lock(m_mutex);
+  while (true) {
+    if (m_queue.empty()) {
+      m_flushRequested = false;
+      if (m_stop) {
+        break;
+      }
+      m_cvWork.wait(lock, [this]() { return m_stop || !m_queue.empty(); });
+      continue;
+    }
+
+    const auto deadline = m_queue.front().first + m_maxBatchDelay;
+    const bool ready = m_cvWork.wait_until(lock, deadline, [this]() {
+      return m_stop || m_flushRequested || m_queue.size() >= m_maxBatchSize;
+    });
+    if (!ready && chrono::steady_clock::now() < deadline) {
+      continue;
+    }
+
+    const size_t batchSize = min(m_queue.size(), m_maxBatchSize);
+    for (size_t i = 0; i < batchSize; i++) {
+      batch.emplace_back(std::move(m_queue.front().second));
+      m_queue.pop_front();
+    }
+    lock.unlock();
+    m_cvDone.notify_all();
+
+    const auto started = chrono::steady_clock::now();
+    bool written = false;
+    try {
+      written = m_writeBatch(batch);
+    } catch (const exception& e) {
+      LOG_GENERAL(WARNING, "Remote storage batch write threw " << e.what());
+    }
+    const auto elapsed = chrono::duration<double, milli>(
+        chrono::steady_clock::now() - started);
+    if (GetBatchLatency().Enabled()) {
+      GetBatchLatency().Record(elapsed.count(),
+                               {{"result", written ? "written" : "failed"}});
+    }
+    if (!written) {
+      LOG_GENERAL(WARNING, "Failed to write " << batch.size()
+                                              << " ops to remote storage");
+    }
+    batch.clear();
+
+    lock.lock();
+    m_batches++;
+    m_done += batchSize;
+    if (written) {
+      m_written += batchSize;
+      m_overloaded = false;
+    } else {
+      m_failed += batchSize;
+    }
+    m_cvDone.notify_all();
+  }
+}
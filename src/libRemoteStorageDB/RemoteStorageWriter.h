@@ -0,0 +1,102 @@
+/*
+ * Copyright (C) 2023 Zilliqa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef ZILLIQA_SRC_LIBREMOTESTORAGEDB_REMOTESTORAGEWRITER_H_
+#define ZILLIQA_SRC_LIBREMOTESTORAGEDB_REMOTESTORAGEWRITER_H_
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <mongocxx/model/write.hpp>
+
+#include "libMetrics/Api.h"
+
+/// Writes the operations queued for the remote storage from one thread, in
+/// batches of up to maxBatchSize operations. A batch is written once it is
+/// full, maxBatchDelay after its oldest operation was queued, or when
+/// flushed. At most maxQueued operations wait at a time: Enqueue waits up to
+/// enqueueTimeout for room and then drops the operation. Once an operation is
+/// dropped, the next ones are dropped without waiting while the queue is
+/// full, until a batch is written again.
+class RemoteStorageWriter {
+ public:
+  using Op = mongocxx::model::write;
+  using WriteBatch = std::function<bool(std::vector<Op>& batch)>;
+
+  RemoteStorageWriter(WriteBatch writeBatch, size_t maxQueued,
+                      size_t maxBatchSize,
+                      std::chrono::milliseconds maxBatchDelay,
+                      std::chrono::milliseconds enqueueTimeout);
+
+  /// Writes the operations still queued, then stops the thread
+  ~RemoteStorageWriter();
+
+  /// Returns false if the operation was dropped
+  bool Enqueue(Op&& op);
+
+  /// Has the queued operations written without waiting for the batch delay
+  void Flush();
+
+  /// Writes the queued operations and waits for them. Returns false if a
+  /// batch failed to be written meanwhile.
+  bool FlushAndWait();
+
+  size_t GetQueued() const;
+
+  RemoteStorageWriter(const RemoteStorageWriter&) = delete;
+  RemoteStorageWriter& operator=(const RemoteStorageWriter&) = delete;
+
+ private:
+  void Run();
+
+  const WriteBatch m_writeBatch;
+  const size_t m_maxQueued;
+  const size_t m_maxBatchSize;
+  const std::chrono::milliseconds m_maxBatchDelay;
+  const std::chrono::milliseconds m_enqueueTimeout;
+
+  mutable std::mutex m_mutex;
+  // Wakes the writer thread
+  std::condition_variable m_cvWork;
+  // Signals room in the queue and written batches
+  std::condition_variable m_cvDone;
+  std::deque<std::pair<std::chrono::steady_clock::time_point, Op>> m_queue;
+  bool m_flushRequested = false;
+  bool m_overloaded = false;
+  bool m_stop = false;
+
+  // Operations accepted, and taken off the queue and written or failed
+  uint64_t m_accepted = 0;
+  uint64_t m_done = 0;
+  uint64_t m_written = 0;
+  uint64_t m_failed = 0;
+  uint64_t m_dropped = 0;
+  uint64_t m_batches = 0;
+
+  Z_I64GAUGE m_stats{Z_FL::DATABASE, "remotestorage.writer.stats",
+                     "Remote storage writer statistics", "ops", true};
+
+  std::thread m_thread;
+};
+
+#endif  // ZILLIQA_SRC_LIBREMOTESTORAGEDB_REMOTESTORAGEWRITER_H_
@@ -64,6 +64,9 @@ class APIServer {
     /// Max size of unhandled requests queue
     size_t maxQueueSize = REQUEST_QUEUE_SIZE;
 
+    /// Max number of calls in a JSON-RPC batch request
+    size_t maxBatchSize = RPC_MAX_BATCH_SIZE;
+
     // TODO enable TLS later
     // std::string tlsCertificateFileName;
     // std::string tlsKeyFileName;
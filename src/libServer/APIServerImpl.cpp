@@ -17,9 +17,14 @@
 
 #include "APIServerImpl.h"
 
+#include <json/json.h>
+#include <jsonrpccpp/common/errors.h>
+#include <jsonrpccpp/server/abstractprotocolhandler.h>
 #include <boost/asio/signal_set.hpp>
+#include <condition_variable>
 #include <deque>
 
+#include "JsonStreamWriter.h"
 #include "libUtils/Logger.h"
 #include "libUtils/SetThreadName.h"
 
@@ -497,6 +502,182 @@ void APIServerImpl::OnAccept(beast::error_code ec, tcp::socket socket) {
   AcceptNext();
 }
 
+namespace {
+
+/// State of a batch request shared between the worker which received it and
+/// the helper tasks it spawned
+struct BatchState {
+  BatchState(std::vector<std::string> calls, std::vector<std::string> results)
+      : requests(std::move(calls)), responses(std::move(results)) {}
+
+  std::vector<std::string> requests;
+  std::vector<std::string> responses;
+  std::atomic<size_t> next{0};
+  std::atomic<size_t> completed{0};
+  std::mutex mutex;
+  std::condition_variable done;
+};
+
+std::string MakeErrorResponse(int code, const std::string &message) {
+  Json::Value error;
+  error["jsonrpc"] = "2.0";
+  error["error"]["code"] = code;
+  error["error"]["message"] = message;
+  error["id"] = Json::nullValue;
+
+  Json::StreamWriterBuilder builder;
+  builder["indentation"] = "";
+  return Json::writeString(builder, error);
+}
+
+}  // namespace
+
+void APIServerImpl::HandleRequest(const std::string &request,
+                                  std::string &response) {
+  auto *handler =
+      dynamic_cast<jsonrpc::AbstractProtocolHandler *>(GetHandler());
+  if (!handler) {
+    ProcessRequest(request, response);
+    return;
+  }
+
+  // Same as AbstractProtocolHandler::HandleRequest, except that the response
+  // tree is released while being serialized
+  using jsonrpc::Errors;
+  Json::Reader reader;
+  Json::Value req;
+  Json::Value resp;
+  try {
+    if (reader.parse(request, req, false)) {
+      handler->HandleJsonRequest(req, resp);
+    } else {
+      handler->WrapError(
+          Json::nullValue, Errors::ERROR_RPC_JSON_PARSE_ERROR,
+          Errors::GetErrorMessage(Errors::ERROR_RPC_JSON_PARSE_ERROR), resp);
+    }
+  } catch (const Json::Exception &) {
+    handler->WrapError(
+        Json::nullValue, Errors::ERROR_RPC_JSON_PARSE_ERROR,
+        Errors::GetErrorMessage(Errors::ERROR_RPC_JSON_PARSE_ERROR), resp);
+  }
+
+  if (resp != Json::nullValue) {
+    req = Json::Value{};
+    JsonStreamWriter(response).Write(std::move(resp));
+  }
+}
+
+APIServerImpl::BatchResult APIServerImpl::ProcessBatchRequest(
+    const std::string &request, std::string &response) {
+  auto pos = request.find_first_not_of(" \t\r\n");
+  if (pos == std::string::npos || request[pos] != '[') {
+    return BatchResult::NOT_A_BATCH;
+  }
+
+  Json::Value batch;
+  Json::Reader reader;
+  if (!reader.parse(request, batch, false) || !batch.isArray() ||
+      batch.size() < 2) {
+    // Malformed and trivial batches are left to the protocol handler
+    return BatchResult::NOT_A_BATCH;
+  }
+
+  if (!GetHandler()) {
+    return BatchResult::NO_HANDLER;
+  }
+
+  using jsonrpc::Errors;
+
+  if (batch.size() > m_options.maxBatchSize) {
+    LOG_GENERAL(INFO, "Rejected batch of " << batch.size() << " calls");
+    response = MakeErrorResponse(
+        Errors::ERROR_RPC_INVALID_REQUEST,
+        "Batch size exceeds limit of " +
+            std::to_string(m_options.maxBatchSize));
+    return BatchResult::HANDLED;
+  }
+
+  const size_t total = batch.size();
+  std::vector<std::string> calls(total);
+  std::vector<std::string> results(total);
+
+  Json::StreamWriterBuilder builder;
+  builder["indentation"] = "";
+  for (Json::ArrayIndex i = 0; i < total; ++i) {
+    // Only objects are valid calls, nested arrays must not be treated as
+    // batches
+    if (batch[i].isObject()) {
+      calls[i] = Json::writeString(builder, batch[i]);
+    } else {
+      results[i] = MakeErrorResponse(
+          Errors::ERROR_RPC_INVALID_REQUEST,
+          Errors::GetErrorMessage(Errors::ERROR_RPC_INVALID_REQUEST));
+    }
+  }
+
+  auto state = std::make_shared<BatchState>(std::move(calls),
+                                            std::move(results));
+
+  // Both the current worker and the helpers pick calls until none are left,
+  // so the batch completes even if no helper gets scheduled
+  auto runCalls = [this, state, total] {
+    for (size_t i = state->next++; i < total; i = state->next++) {
+      if (!state->requests[i].empty()) {
+        bool error = false;
+        try {
+          HandleRequest(state->requests[i], state->responses[i]);
+        } catch (const std::exception &e) {
+          LOG_GENERAL(WARNING, "Unhandled exception in batch: " << e.what());
+          error = true;
+        } catch (...) {
+          LOG_GENERAL(WARNING, "Unhandled exception in batch.");
+          error = true;
+        }
+        if (error) {
+          state->responses[i] = MakeErrorResponse(
+              Errors::ERROR_RPC_INTERNAL_ERROR,
+              Errors::GetErrorMessage(Errors::ERROR_RPC_INTERNAL_ERROR));
+        }
+      }
+      if (++state->completed == total) {
+        std::lock_guard<std::mutex> lock(state->mutex);
+        state->done.notify_all();
+      }
+    }
+  };
+
+  const size_t numHelpers =
+      std::min(total, m_threadPool->GetNumThreads()) - 1;
+  for (size_t i = 0; i < numHelpers; ++i) {
+    if (!m_threadPool->PushTask(runCalls)) {
+      break;
+    }
+  }
+
+  runCalls();
+
+  {
+    std::unique_lock<std::mutex> lock(state->mutex);
+    state->done.wait(lock, [&] { return state->completed == total; });
+  }
+
+  // Notifications produce no response
+  response.clear();
+  for (const auto &result : state->responses) {
+    if (result.empty()) {
+      continue;
+    }
+    response += response.empty() ? '[' : ',';
+    response += result;
+  }
+  if (response.empty()) {
+    return BatchResult::NO_CONTENT;
+  }
+  response += ']';
+
+  return BatchResult::HANDLED;
+}
+
 APIThreadPool::Response APIServerImpl::ProcessRequestInThreadPool(
     const APIThreadPool::Request &request) {
   APIThreadPool::Response response;
@@ -506,11 +687,22 @@ APIThreadPool::Response APIServerImpl::ProcessRequestInThreadPool(
       std::this_thread::sleep_for(std::chrono::milliseconds(50));
     }
 
-    // Calls connection handler from AbstractServerConnector
-    ProcessRequest(request.body, response.body);
-
-    // Connection handler was not installed - internal error
-    error = response.body.empty();
+    // Calls connection handler from AbstractServerConnector, batches are
+    // split across the thread pool
+    switch (ProcessBatchRequest(request.body, response.body)) {
+      case BatchResult::NOT_A_BATCH:
+        HandleRequest(request.body, response.body);
+        // Connection handler was not installed - internal error
+        error = response.body.empty();
+        break;
+      case BatchResult::HANDLED:
+      case BatchResult::NO_CONTENT:
+        // A batch of notifications is answered with an empty success
+        break;
+      case BatchResult::NO_HANDLER:
+        error = true;
+        break;
+    }
   } catch (const std::exception &e) {
     LOG_GENERAL(WARNING,
                 "Unhandled exception in API thread pool: " << e.what());
@@ -537,6 +729,10 @@ void APIServerImpl::OnResponseFromThreadPool(
   }
 
   if (response.isWebsocket) {
+    if (response.body.empty()) {
+      // Nothing to send back for notifications
+      return;
+    }
     // API response to be dispatched to websocket connection
     if (m_websocket) {
       m_websocket->SendMessage(
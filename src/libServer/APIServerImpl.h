@@ -93,6 +93,27 @@ class APIServerImpl : public APIServer,
   APIThreadPool::Response ProcessRequestInThreadPool(
       const APIThreadPool::Request& request);
 
+  /// Calls the jsonrpccpp protocol handler and streams the response tree into
+  /// the body
+  void HandleRequest(const std::string& request, std::string& response);
+
+  /// Outcome of ProcessBatchRequest
+  enum class BatchResult {
+    /// Not a batch, to be passed to the protocol handler as is
+    NOT_A_BATCH,
+    /// Batch processed, the response holds the results
+    HANDLED,
+    /// Batch processed, but it consisted of notifications only
+    NO_CONTENT,
+    /// Connection handler was not installed
+    NO_HANDLER,
+  };
+
+  /// Executes the calls of a JSON-RPC batch request in parallel on the thread
+  /// pool and assembles their responses in order
+  BatchResult ProcessBatchRequest(const std::string& request,
+                                  std::string& response);
+
   /// Processes responses from thread pool in the main thread
   void OnResponseFromThreadPool(APIThreadPool::Response&& response);
 
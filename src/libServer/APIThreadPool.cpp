@@ -65,6 +65,12 @@ bool APIThreadPool::PushRequest(JobId id, bool isWebsocket, std::string from,
   return true;
 }
 
+bool APIThreadPool::PushTask(Task task) {
+  Request request;
+  request.task = std::move(task);
+  return m_requestQueue.bounded_push(std::move(request));
+}
+
 void APIThreadPool::Reset() {
   m_requestQueue.reset();
   m_responseQueue.reset();
@@ -102,6 +108,12 @@ void APIThreadPool::WorkerThread(size_t threadNo) {
   Request request;
   size_t queueSize = 0;
   while (m_requestQueue.pop(request, queueSize)) {
+    if (request.task) {
+      request.task();
+      request.task = nullptr;
+      continue;
+    }
+
     LOG_GENERAL(DEBUG, threadName << " processes job #" << request.id
                                   << ", Q=" << queueSize);
     sw.Start();
@@ -38,6 +38,9 @@ class APIThreadPool : public std::enable_shared_from_this<APIThreadPool> {
   /// OK response code
   static constexpr int OK_RESPONSE_CODE = 200;
 
+  /// Auxiliary job run by a worker, e.g. a part of a batch request
+  using Task = std::function<void()>;
+
   struct Request {
     /// Job ID
     JobId id = 0;
@@ -50,6 +53,9 @@ class APIThreadPool : public std::enable_shared_from_this<APIThreadPool> {
 
     /// Request body (json rpc 2.0 format expected)
     std::string body;
+
+    /// If set, the worker runs the task and produces no response
+    Task task;
   };
 
   struct Response {
@@ -83,10 +89,15 @@ class APIThreadPool : public std::enable_shared_from_this<APIThreadPool> {
   /// A metric
   size_t GetQueueSize() const { return m_requestQueue.size(); }
 
+  size_t GetNumThreads() const { return m_threads.size(); }
+
   /// Owner pushes a new request
   bool PushRequest(JobId id, bool isWebsocket, std::string from,
                    std::string body);
 
+  /// Pushes an auxiliary task, returns false if the queue is full
+  bool PushTask(Task task);
+
   /// Resets queues
   void Reset();
 
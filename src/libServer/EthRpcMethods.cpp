@@ -23,6 +23,7 @@
 #include <boost/multiprecision/cpp_dec_float.hpp>
 #include <ethash/keccak.hpp>
 #include <stdexcept>
+#include "FinalizedResponseCache.h"
 #include "JSONConversion.h"
 #include "LookupServer.h"
 #include "common/CommonData.h"
@@ -1215,15 +1216,14 @@ Json::Value EthRpcMethods::GetEthTransactionByHash(
     }
 
     const TxBlock EMPTY_BLOCK;
-    const auto txBlock = GetBlockFromTransaction(*transactionBodyPtr);
+    const auto [txBlock, transactionIndex] =
+        GetTransactionBlockAndIndex(*transactionBodyPtr, transactionHash);
     if (txBlock == EMPTY_BLOCK) {
       LOG_GENERAL(WARNING, "Unable to get the TX from a minted block!");
       return Json::nullValue;
     }
 
     constexpr auto WRONG_INDEX = std::numeric_limits<uint64_t>::max();
-    auto transactionIndex =
-        GetTransactionIndexFromBlock(txBlock, transactionHash);
     if (transactionIndex == WRONG_INDEX) {
       return Json::nullValue;
     }
@@ -1473,6 +1473,14 @@ Json::Value EthRpcMethods::GetEthBlockCommon(
     const TxBlock &txBlock, const bool includeFullTransactions) {
   INC_CALLS(GetInvocationsCounter());
 
+  auto &cache = rpc::FinalizedResponseCache::GetInstance();
+  const auto cacheKey = rpc::FinalizedResponseCache::MakeKey(
+      "eth_getBlock", txBlock.GetHeader().GetBlockNum(),
+      includeFullTransactions);
+  if (auto cached = cache.Get(cacheKey)) {
+    return std::move(*cached);
+  }
+
   const auto dsBlock = m_sharedMediator.m_dsBlockChain.GetBlock(
       txBlock.GetHeader().GetDSBlockNum());
 
@@ -1504,8 +1512,15 @@ Json::Value EthRpcMethods::GetEthBlockCommon(
     }
   }
 
-  return JSONConversion::convertTxBlocktoEthJson(txBlock, dsBlock, transactions,
-                                                 includeFullTransactions);
+  auto response = JSONConversion::convertTxBlocktoEthJson(
+      txBlock, dsBlock, transactions, includeFullTransactions);
+
+  // Only cache blocks whose bodies have all been persisted
+  if (transactions.size() == txBlock.GetHeader().GetNumTxs()) {
+    cache.Put(cacheKey, response);
+  }
+
+  return response;
 }
 
 Json::Value EthRpcMethods::GetEthBalance(const std::string &address,
@@ -1732,7 +1747,8 @@ Json::Value EthRpcMethods::GetEthTransactionReceipt(
     }
 
     const TxBlock EMPTY_BLOCK;
-    auto txBlock = GetBlockFromTransaction(*transactionBodyPtr);
+    const auto [txBlock, transactionIndex] =
+        GetTransactionBlockAndIndex(*transactionBodyPtr, txnhash);
     if (txBlock == EMPTY_BLOCK) {
       LOG_GENERAL(WARNING, "Tx receipt requested but not found in any blocks. "
                                << txnhash);
@@ -1740,8 +1756,6 @@ Json::Value EthRpcMethods::GetEthTransactionReceipt(
     }
 
     constexpr auto WRONG_INDEX = std::numeric_limits<uint64_t>::max();
-    const auto transactionIndex =
-        GetTransactionIndexFromBlock(txBlock, txnhash);
     if (transactionIndex == WRONG_INDEX) {
       LOG_GENERAL(WARNING, "Tx index requested but not found");
       return Json::nullValue;
@@ -1961,6 +1975,27 @@ uint64_t EthRpcMethods::GetTransactionIndexFromBlock(
   return WRONG_INDEX;
 }
 
+std::pair<TxBlock, uint64_t> EthRpcMethods::GetTransactionBlockAndIndex(
+    const TransactionWithReceipt &transaction,
+    const std::string &txnhash) const {
+  TxLocation location;
+  if (BlockStorage::GetBlockStorage().GetTxLocation(TxnHash{txnhash},
+                                                    location) &&
+      location.m_txIndexInBlock) {
+    try {
+      return {m_sharedMediator.m_txBlockChain.GetBlock(location.m_blockNum),
+              *location.m_txIndexInBlock};
+    } catch (std::exception &e) {
+      LOG_GENERAL(INFO, "[Error]" << e.what()
+                                  << " while getting block from TxLocation");
+    }
+  }
+
+  auto txBlock = GetBlockFromTransaction(transaction);
+  const auto transactionIndex = GetTransactionIndexFromBlock(txBlock, txnhash);
+  return {std::move(txBlock), transactionIndex};
+}
+
 // Given a transmitted RLP, return checksum-encoded original sender address
 std::string EthRpcMethods::EthRecoverTransaction(
     const std::string &txnRpc) const {
@@ -1987,16 +2022,46 @@ Json::Value EthRpcMethods::GetEthBlockReceipts(const std::string &blockId) {
 
   INC_CALLS(GetInvocationsCounter());
 
+  // Keyed by the block hash, so that a hit neither loads nor renders the
+  // block
+  auto &cache = rpc::FinalizedResponseCache::GetInstance();
+  std::string cacheKey;
+  try {
+    cacheKey = rpc::FinalizedResponseCache::MakeKey("eth_getBlockReceipts",
+                                                    BlockHash{blockId}.hex());
+  } catch (const std::exception &) {
+    // An invalid hash is reported by GetEthBlockByHash below
+  }
+  if (!cacheKey.empty()) {
+    if (auto cached = cache.Get(cacheKey)) {
+      return std::move(*cached);
+    }
+  }
+
   auto const block = GetEthBlockByHash(blockId, false);
   auto const txs = block["transactions"];
 
+  std::optional<uint64_t> blockNum;
+  if (block["number"].isString()) {
+    blockNum = std::stoull(block["number"].asString(), nullptr, 16);
+  }
+
   Json::Value res = Json::arrayValue;
+  bool complete = true;
 
   for (const auto &tx : txs) {
     auto const receipt = GetEthTransactionReceipt(tx.asString());
+    complete = complete && !receipt.isNull();
     res.append(receipt);
   }
 
+  if (!cacheKey.empty() && blockNum && complete &&
+      txs.size() == m_sharedMediator.m_txBlockChain.GetBlock(*blockNum)
+                         .GetHeader()
+                         .GetNumTxs()) {
+    cache.Put(cacheKey, res);
+  }
+
   return res;
 }
 
@@ -796,6 +796,11 @@ class EthRpcMethods {
       const TransactionWithReceipt& transaction) const;
   uint64_t GetTransactionIndexFromBlock(const TxBlock& txBlock,
                                         const std::string& txnhash) const;
+  // Resolves the block and index of a committed transaction, falling back to
+  // scanning the block's microblocks if no usable TxLocation was stored
+  std::pair<TxBlock, uint64_t> GetTransactionBlockAndIndex(
+      const TransactionWithReceipt& transaction,
+      const std::string& txnhash) const;
 
   // Eth calls
   Json::Value GetEthTransactionReceipt(const std::string& txnhash);
@@ -0,0 +1,123 @@
+/*
+ * Copyright (C) 2023 Zilliqa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "FinalizedResponseCache.h"
+
+#include "common/Constants.h"
+#include "libUtils/JsonUtils.h"
+
+namespace rpc {
+
+FinalizedResponseCache& FinalizedResponseCache::GetInstance() {
+  static FinalizedResponseCache cache(
+      static_cast<size_t>(RPC_RESPONSE_CACHE_SIZE_MB) * 1024 * 1024);
+  return cache;
+}
+
+FinalizedResponseCache::FinalizedResponseCache(size_t capacityBytes)
+    : m_capacityBytes(capacityBytes) {
+  m_stats.SetCallback([this](auto&& result) {
+    if (m_stats.Enabled()) {
+      std::lock_guard<std::mutex> g(m_mutex);
+      const auto total = m_hits + m_misses;
+      result.Set(m_sizeBytes, {{"counter", "SizeBytes"}});
+      result.Set(m_lru.size(), {{"counter", "Entries"}});
+      result.Set(total == 0 ? 0 : (m_hits * 100) / total,
+                 {{"counter", "HitRatioPercent"}});
+    }
+  });
+}
+
+std::string FinalizedResponseCache::MakeKey(std::string_view method,
+                                            uint64_t blockNum,
+                                            uint64_t flags) {
+  std::string key{method};
+  key += ':';
+  key += std::to_string(blockNum);
+  key += ':';
+  key += std::to_string(flags);
+  return key;
+}
+
+std::string FinalizedResponseCache::MakeKey(std::string_view method,
+                                            std::string_view blockHash) {
+  std::string key{method};
+  key += ":0x";
+  key += blockHash;
+  return key;
+}
+
+std::optional<Json::Value> FinalizedResponseCache::Get(const std::string& key) {
+  if (m_capacityBytes == 0) {
+    return std::nullopt;
+  }
+
+  std::lock_guard<std::mutex> g(m_mutex);
+  auto it = m_index.find(key);
+  if (it == m_index.end()) {
+    ++m_misses;
+    m_lookups.IncrementAttr({{"result", "miss"}});
+    return std::nullopt;
+  }
+
+  ++m_hits;
+  m_lookups.IncrementAttr({{"result", "hit"}});
+  m_lru.splice(m_lru.begin(), m_lru, it->second);
+  return it->second->m_response;
+}
+
+void FinalizedResponseCache::Put(const std::string& key,
+                                 const Json::Value& response) {
+  if (m_capacityBytes == 0) {
+    return;
+  }
+
+  // Serialized length is a reasonable proxy of the footprint of the tree
+  const size_t sizeBytes =
+      key.size() + JSONUtils::GetInstance().convertJsontoStr(response).size();
+  if (sizeBytes > m_capacityBytes) {
+    return;
+  }
+
+  std::lock_guard<std::mutex> g(m_mutex);
+  if (m_index.find(key) != m_index.end()) {
+    return;
+  }
+
+  m_lru.push_front(Entry{key, response, sizeBytes});
+  m_index.emplace(key, m_lru.begin());
+  m_sizeBytes += sizeBytes;
+  EvictToFit();
+}
+
+void FinalizedResponseCache::Clear() {
+  std::lock_guard<std::mutex> g(m_mutex);
+  m_lru.clear();
+  m_index.clear();
+  m_sizeBytes = 0;
+}
+
+void FinalizedResponseCache::EvictToFit() {
+  while (m_sizeBytes > m_capacityBytes && !m_lru.empty()) {
+    const auto& victim = m_lru.back();
+    m_sizeBytes -= victim.m_sizeBytes;
+    m_index.erase(victim.m_key);
+    m_lru.pop_back();
+  }
+}
+
+}  // namespace rpc
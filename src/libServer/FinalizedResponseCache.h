@@ -0,0 +1,88 @@
+/*
+ * Copyright (C) 2023 Zilliqa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef ZILLIQA_SRC_LIBSERVER_FINALIZEDRESPONSECACHE_H_
+#define ZILLIQA_SRC_LIBSERVER_FINALIZEDRESPONSECACHE_H_
+
+#include <json/json.h>
+#include <list>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include "libMetrics/Api.h"
+
+namespace rpc {
+
+/// Size-bounded LRU cache of rendered RPC responses for finalized blocks.
+/// Responses of a finalized block never change, so entries are only evicted
+/// for space and never invalidated.
+class FinalizedResponseCache {
+ public:
+  static FinalizedResponseCache& GetInstance();
+
+  explicit FinalizedResponseCache(size_t capacityBytes);
+
+  /// Builds a cache key from the RPC method, block number and request flags
+  static std::string MakeKey(std::string_view method, uint64_t blockNum,
+                             uint64_t flags = 0);
+
+  /// Builds a cache key from the RPC method and block hash, for requests
+  /// which only know the hash until the block is loaded
+  static std::string MakeKey(std::string_view method,
+                             std::string_view blockHash);
+
+  /// Returns the cached response for the key, if present
+  std::optional<Json::Value> Get(const std::string& key);
+
+  /// Caches a response. Callers must only pass responses which are final,
+  /// i.e. not for "latest"/"pending" tags or blocks with missing bodies
+  void Put(const std::string& key, const Json::Value& response);
+
+  void Clear();
+
+ private:
+  struct Entry {
+    std::string m_key;
+    Json::Value m_response;
+    size_t m_sizeBytes{};
+  };
+
+  using LruList = std::list<Entry>;
+
+  void EvictToFit();
+
+  const size_t m_capacityBytes;
+  size_t m_sizeBytes = 0;
+  LruList m_lru;
+  std::unordered_map<std::string, LruList::iterator> m_index;
+  std::mutex m_mutex;
+
+  uint64_t m_hits = 0;
+  uint64_t m_misses = 0;
+
+  Z_I64METRIC m_lookups{Z_FL::API_SERVER, "rpc.response_cache.lookups",
+                        "Lookups in the finalized response cache", "calls"};
+  Z_I64GAUGE m_stats{Z_FL::API_SERVER, "rpc.response_cache.stats",
+                     "Finalized response cache statistics", "units", true};
+};
+
+}  // namespace rpc
+
+#endif  // ZILLIQA_SRC_LIBSERVER_FINALIZEDRESPONSECACHE_H_
@@ -69,6 +69,15 @@ IsolatedServer::IsolatedServer(Mediator& mediator,
           jsonrpc::JSON_STRING, "param03", jsonrpc::JSON_ARRAY, NULL),
       &LookupServer::GetSmartContractSubStateI);
 
+  AbstractServer<IsolatedServer>::bindAndAddMethod(
+      jsonrpc::Procedure("GetSmartContractSubStatePaginated",
+                         jsonrpc::PARAMS_BY_POSITION, jsonrpc::JSON_OBJECT,
+                         "param01", jsonrpc::JSON_STRING, "param02",
+                         jsonrpc::JSON_STRING, "param03", jsonrpc::JSON_STRING,
+                         "param04", jsonrpc::JSON_STRING, "param05",
+                         jsonrpc::JSON_INTEGER, NULL),
+      &LookupServer::GetSmartContractSubStatePaginatedI);
+
   AbstractServer<IsolatedServer>::bindAndAddMethod(
       jsonrpc::Procedure("GetSmartContractState", jsonrpc::PARAMS_BY_POSITION,
                          jsonrpc::JSON_OBJECT, "param01", jsonrpc::JSON_STRING,
@@ -1211,6 +1220,15 @@ void IsolatedServer::PostTxBlock() {
                                                   serializedTxBlock)) {
     LOG_GENERAL(WARNING, "BlockStorage::PutTxBlock failed " << txBlock);
   }
+  for (const auto& mbInfo : txBlock.GetMicroBlockInfos()) {
+    MicroBlockSharedPtr mbPtr;
+    if (!BlockStorage::GetBlockStorage().GetMicroBlock(mbInfo.m_microBlockHash,
+                                                       mbPtr) ||
+        !BlockStorage::GetBlockStorage().PutTxLocations(*mbPtr)) {
+      LOG_GENERAL(WARNING, "BlockStorage::PutTxLocations failed "
+                               << mbInfo.m_microBlockHash);
+    }
+  }
   AccountStore::GetInstance().MoveUpdatesToDisk();
   AccountStore::GetInstance().InitTemp();
 
@@ -1254,7 +1272,7 @@ void IsolatedServer::PostTxBlock() {
         BlockStorage::GetBlockStorage().GetTxBody(tranHash, tptr);
         const auto& transactionReceipt = tptr->GetTransactionReceipt();
         cacheUpdate.AddCommittedTransaction(epoch, 0, tx,
-                                            transactionReceipt.GetJsonValue());
+                                            transactionReceipt.GetString());
       }
     }
   }
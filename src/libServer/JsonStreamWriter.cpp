@@ -0,0 +1,89 @@
+/*
+ * Copyright (C) 2023 Zilliqa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "JsonStreamWriter.h"
+
+namespace rpc {
+
+JsonStreamWriter::AppendBuffer::int_type
+JsonStreamWriter::AppendBuffer::overflow(int_type ch) {
+  if (!traits_type::eq_int_type(ch, traits_type::eof())) {
+    m_out.push_back(traits_type::to_char_type(ch));
+  }
+  return traits_type::not_eof(ch);
+}
+
+std::streamsize JsonStreamWriter::AppendBuffer::xsputn(const char* s,
+                                                       std::streamsize n) {
+  m_out.append(s, static_cast<size_t>(n));
+  return n;
+}
+
+JsonStreamWriter::JsonStreamWriter(std::string& out)
+    : m_out(out), m_buffer(out), m_stream(&m_buffer) {
+  Json::StreamWriterBuilder builder;
+  builder["indentation"] = "";
+  m_scalarWriter.reset(builder.newStreamWriter());
+}
+
+void JsonStreamWriter::Write(Json::Value&& value) {
+  switch (value.type()) {
+    case Json::arrayValue:
+      WriteArray(value);
+      break;
+    case Json::objectValue:
+      WriteObject(value);
+      break;
+    default:
+      m_scalarWriter->write(value, &m_stream);
+      break;
+  }
+  value = Json::Value{};
+}
+
+void JsonStreamWriter::WriteArray(Json::Value& value) {
+  m_out.push_back('[');
+  const Json::ArrayIndex size = value.size();
+  for (Json::ArrayIndex i = 0; i < size; ++i) {
+    if (i > 0) {
+      m_out.push_back(',');
+    }
+    Json::Value element;
+    element.swap(value[i]);
+    Write(std::move(element));
+  }
+  m_out.push_back(']');
+}
+
+void JsonStreamWriter::WriteObject(Json::Value& value) {
+  m_out.push_back('{');
+  bool first = true;
+  for (const auto& name : value.getMemberNames()) {
+    if (!first) {
+      m_out.push_back(',');
+    }
+    first = false;
+    m_scalarWriter->write(Json::Value{name}, &m_stream);
+    m_out.push_back(':');
+    Json::Value member;
+    value.removeMember(name, &member);
+    Write(std::move(member));
+  }
+  m_out.push_back('}');
+}
+
+}  // namespace rpc
@@ -0,0 +1,68 @@
+/*
+ * Copyright (C) 2023 Zilliqa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef ZILLIQA_SRC_LIBSERVER_JSONSTREAMWRITER_H_
+#define ZILLIQA_SRC_LIBSERVER_JSONSTREAMWRITER_H_
+
+#include <json/json.h>
+#include <memory>
+#include <ostream>
+#include <streambuf>
+#include <string>
+
+namespace rpc {
+
+/// Serializes a Json::Value into compact JSON, byte-identical to
+/// Json::StreamWriterBuilder output with empty indentation. Containers are
+/// consumed while being written, so the memory of a large response tree is
+/// released as its text grows instead of both coexisting in full.
+class JsonStreamWriter {
+ public:
+  /// Text is appended to the given string
+  explicit JsonStreamWriter(std::string& out);
+
+  /// Writes the value and leaves it null
+  void Write(Json::Value&& value);
+
+ private:
+  /// Stream buffer appending to the output string without copies
+  class AppendBuffer : public std::streambuf {
+   public:
+    explicit AppendBuffer(std::string& out) : m_out(out) {}
+
+   protected:
+    int_type overflow(int_type ch) override;
+    std::streamsize xsputn(const char* s, std::streamsize n) override;
+
+   private:
+    std::string& m_out;
+  };
+
+  void WriteArray(Json::Value& value);
+  void WriteObject(Json::Value& value);
+
+  std::string& m_out;
+  AppendBuffer m_buffer;
+  std::ostream m_stream;
+
+  /// Scalars and keys are delegated to jsoncpp to keep the exact formatting
+  std::unique_ptr<Json::StreamWriter> m_scalarWriter;
+};
+
+}  // namespace rpc
+
+#endif  // ZILLIQA_SRC_LIBSERVER_JSONSTREAMWRITER_H_
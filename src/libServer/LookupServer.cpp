@@ -19,6 +19,7 @@
 #include <boost/format.hpp>
 #include <boost/multiprecision/cpp_dec_float.hpp>
 #include "EthRpcMethods.h"
+#include "FinalizedResponseCache.h"
 #include "JSONConversion.h"
 #include "common/Messages.h"
 #include "libCrypto/Sha2.h"
@@ -255,6 +256,14 @@ LookupServer::LookupServer(Mediator& mediator,
           jsonrpc::JSON_OBJECT, "param01", jsonrpc::JSON_STRING, "param02",
           jsonrpc::JSON_STRING, "param03", jsonrpc::JSON_ARRAY, NULL),
       &LookupServer::GetSmartContractSubStateI);
+  this->bindAndAddMethod(
+      jsonrpc::Procedure("GetSmartContractSubStatePaginated",
+                         jsonrpc::PARAMS_BY_POSITION, jsonrpc::JSON_OBJECT,
+                         "param01", jsonrpc::JSON_STRING, "param02",
+                         jsonrpc::JSON_STRING, "param03", jsonrpc::JSON_STRING,
+                         "param04", jsonrpc::JSON_STRING, "param05",
+                         jsonrpc::JSON_INTEGER, NULL),
+      &LookupServer::GetSmartContractSubStatePaginatedI);
   this->bindAndAddMethod(
       jsonrpc::Procedure("GetSmartContractState", jsonrpc::PARAMS_BY_POSITION,
                          jsonrpc::JSON_OBJECT, "param01", jsonrpc::JSON_STRING,
@@ -747,8 +756,19 @@ Json::Value LookupServer::GetTxBlockByNum(const string& blockNum,
 
   try {
     uint64_t BlockNum = stoull(blockNum);
-    return JSONConversion::convertTxBlocktoJson(
-        m_mediator.m_txBlockChain.GetBlock(BlockNum), verbose);
+    auto& cache = rpc::FinalizedResponseCache::GetInstance();
+    const auto cacheKey = rpc::FinalizedResponseCache::MakeKey(
+        "GetTxBlock", BlockNum, verbose);
+    if (auto cached = cache.Get(cacheKey)) {
+      return std::move(*cached);
+    }
+    const auto txBlock = m_mediator.m_txBlockChain.GetBlock(BlockNum);
+    auto response = JSONConversion::convertTxBlocktoJson(txBlock, verbose);
+    // A dummy block is returned for blocks not yet received
+    if (txBlock.GetHeader().GetBlockNum() == BlockNum) {
+      cache.Put(cacheKey, response);
+    }
+    return response;
   } catch (const JsonRpcException& je) {
     throw je;
   } catch (runtime_error& e) {
@@ -900,6 +920,63 @@ Json::Value LookupServer::GetSmartContractState(const string& address,
   }
 }
 
+Json::Value LookupServer::GetSmartContractSubStatePaginated(
+    const string& address, const string& vname, const string& keyPrefix,
+    const string& cursor, uint32_t limit) {
+  INC_CALLS(GetCallsCounter());
+
+  if (!LOOKUP_NODE_MODE) {
+    throw JsonRpcException(RPC_INVALID_REQUEST, "Sent to a non-lookup");
+  }
+
+  if (vname.empty()) {
+    throw JsonRpcException(RPC_INVALID_PARAMETER, "Variable name required");
+  }
+
+  if (limit == 0 || limit > MAX_CONTRACT_STATE_PAGE_SIZE) {
+    throw JsonRpcException(RPC_INVALID_PARAMETER,
+                           "Limit must be between 1 and " +
+                               to_string(MAX_CONTRACT_STATE_PAGE_SIZE));
+  }
+
+  try {
+    Address addr{ToBase16AddrHelper(address)};
+
+    shared_lock<shared_timed_mutex> lock(
+        AccountStore::GetInstance().GetPrimaryMutex());
+
+    const Account* account = AccountStore::GetInstance().GetAccount(addr, true);
+
+    if (account == nullptr) {
+      throw JsonRpcException(RPC_INVALID_ADDRESS_OR_KEY,
+                             "Address does not exist");
+    }
+
+    if (!account->isContract()) {
+      throw JsonRpcException(RPC_INVALID_ADDRESS_OR_KEY,
+                             "Address not contract address");
+    }
+
+    Json::Value state = Json::objectValue;
+    string nextCursor;
+    if (!Contract::ContractStorage::GetContractStorage()
+             .FetchStateJsonPageForContract(state, addr, vname, keyPrefix,
+                                            cursor, limit, nextCursor)) {
+      throw JsonRpcException(RPC_INVALID_PARAMETER, "Invalid state query");
+    }
+
+    Json::Value _json;
+    _json["State"] = std::move(state);
+    _json["NextCursor"] = nextCursor;
+    return _json;
+  } catch (const JsonRpcException& je) {
+    throw je;
+  } catch (exception& e) {
+    LOG_GENERAL(INFO, "[Error]" << e.what() << " Input: " << address);
+    throw JsonRpcException(RPC_MISC_ERROR, "Unable To Process");
+  }
+}
+
 Json::Value LookupServer::GetSmartContractInit(const string& address) {
   INC_CALLS(GetCallsCounter());
 
@@ -1827,6 +1904,14 @@ Json::Value LookupServer::GetTransactionsForTxBlock(const TxBlock& txBlock,
     throw JsonRpcException(RPC_INVALID_PARAMS, "Tx Block does not exist");
   }
 
+  auto& cache = rpc::FinalizedResponseCache::GetInstance();
+  const auto cacheKey = rpc::FinalizedResponseCache::MakeKey(
+      "GetTransactionsForTxBlock", txBlock.GetHeader().GetBlockNum(),
+      pageNumber);
+  if (auto cached = cache.Get(cacheKey)) {
+    return std::move(*cached);
+  }
+
   auto microBlockInfos = txBlock.GetMicroBlockInfos();
   Json::Value _json = Json::arrayValue;
   bool hasTransactions = false;
@@ -1890,6 +1975,7 @@ Json::Value LookupServer::GetTransactionsForTxBlock(const TxBlock& txBlock,
   if (pageNumber == std::numeric_limits<uint32_t>::max()) {
     // Backward compatibility: return array of txns if no page number was
     // specified
+    cache.Put(cacheKey, _json);
     return _json;
   }
 
@@ -1901,6 +1987,7 @@ Json::Value LookupServer::GetTransactionsForTxBlock(const TxBlock& txBlock,
   _json2["NumPages"] =
       (txBlock.GetHeader().GetNumTxs() / NUM_TXNS_PER_PAGE) +
       ((txBlock.GetHeader().GetNumTxs() % NUM_TXNS_PER_PAGE) ? 1 : 0);
+  cache.Put(cacheKey, _json2);
   return _json2;
 }
 
@@ -238,6 +238,13 @@ class LookupServer : public Server,
                                            request[1u].asString(), request[2u]);
   }
 
+  inline virtual void GetSmartContractSubStatePaginatedI(
+      const Json::Value& request, Json::Value& response) {
+    response = this->GetSmartContractSubStatePaginated(
+        request[0u].asString(), request[1u].asString(), request[2u].asString(),
+        request[3u].asString(), request[4u].asUInt());
+  }
+
   inline virtual void GetSmartContractStateI(const Json::Value& request,
                                              Json::Value& response) {
     response = this->GetSmartContractState(request[0u].asString());
@@ -366,6 +373,11 @@ class LookupServer : public Server,
   Json::Value GetSmartContractState(
       const std::string& address, const std::string& vname = "",
       const Json::Value& indices = Json::arrayValue);
+  Json::Value GetSmartContractSubStatePaginated(const std::string& address,
+                                                const std::string& vname,
+                                                const std::string& keyPrefix,
+                                                const std::string& cursor,
+                                                uint32_t limit);
   Json::Value GetSmartContractInit(const std::string& address);
   Json::Value GetSmartContractCode(const std::string& address);
 
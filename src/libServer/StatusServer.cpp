@@ -19,6 +19,7 @@
 #include "JSONConversion.h"
 #include "libDirectoryService/DirectoryService.h"
 #include "libMediator/Mediator.h"
+#include "libMetrics/EpochTimeline.h"
 #include "libNetwork/Blacklist.h"
 #include "libNode/Node.h"
 #include "libPersistence/BlockStorage.h"
@@ -191,6 +192,11 @@ StatusServer::StatusServer(Mediator& mediator,
       jsonrpc::Procedure("ToggleGetPendingTxns", jsonrpc::PARAMS_BY_POSITION,
                          jsonrpc::JSON_OBJECT, NULL),
       &StatusServer::ToggleGetPendingTxnsI);
+  this->bindAndAddMethod(
+      jsonrpc::Procedure("GetEpochTimeline", jsonrpc::PARAMS_BY_POSITION,
+                         jsonrpc::JSON_ARRAY, "param01", jsonrpc::JSON_STRING,
+                         NULL),
+      &StatusServer::GetEpochTimelineI);
   this->bindAndAddMethod(
       jsonrpc::Procedure("EnableJsonRpcPort", jsonrpc::PARAMS_BY_POSITION,
                          jsonrpc::JSON_OBJECT, NULL),
@@ -780,3 +786,40 @@ bool StatusServer::ToggleGetPendingTxns() {
   m_mediator.m_disableGetPendingTxns = !m_mediator.m_disableGetPendingTxns;
   return m_mediator.m_disableGetPendingTxns;
 }
+
+Json::Value StatusServer::GetEpochTimeline(const string& numEpochsStr) {
+  size_t numEpochs = 0;
+  try {
+    numEpochs = stoul(numEpochsStr);
+  } catch (const exception& e) {
+    LOG_GENERAL(WARNING, "[Error] " << e.what());
+    throw JsonRpcException(RPC_INVALID_PARAMETER,
+                           "Number of epochs provided not valid");
+  }
+
+  Json::Value _json = Json::arrayValue;
+  for (const auto& epoch : EpochTimeline::GetInstance().GetRecent(numEpochs)) {
+    Json::Value epochJson;
+    epochJson["DSEpoch"] = to_string(epoch.m_dsEpoch);
+    epochJson["TxEpoch"] = to_string(epoch.m_txEpoch);
+    Json::Value phasesJson = Json::objectValue;
+    for (size_t i = 0; i < EpochTimeline::NUM_PHASES; i++) {
+      const auto& phase = epoch.m_phases[i];
+      if (phase.m_count == 0) {
+        continue;
+      }
+      Json::Value phaseJson;
+      phaseJson["StartTime"] = to_string(
+          chrono::duration_cast<chrono::milliseconds>(
+              phase.m_start.time_since_epoch())
+              .count());
+      phaseJson["DurationMs"] = to_string(phase.m_duration.count());
+      phaseJson["Count"] = phase.m_count;
+      phasesJson[string{EpochTimeline::GetPhaseName(
+          static_cast<EpochPhase>(i))}] = phaseJson;
+    }
+    epochJson["Phases"] = phasesJson;
+    _json.append(epochJson);
+  }
+  return _json;
+}
@@ -183,6 +183,10 @@ class StatusServer : public Server,
     (void)request;
     response = this->ToggleGetPendingTxns();
   }
+  inline virtual void GetEpochTimelineI(const Json::Value& request,
+                                        Json::Value& response) {
+    response = this->GetEpochTimeline(request[0u].asString());
+  }
   inline virtual void SetRemoteStorageDBUpdateTxnChangeLookupNodeI(
       const Json::Value& request, Json::Value& response) {
     (void)request;
@@ -231,6 +235,7 @@ class StatusServer : public Server,
   bool ToggleGetSmartContractState();
   bool AuditShard(const std::string& shardIDStr);
   bool ToggleGetPendingTxns();
+  Json::Value GetEpochTimeline(const std::string& numEpochsStr);
   bool EnableJsonRpcPort();
   bool DisableJsonRpcPort();
   bool SetRemoteStorageDBTxnUpdaterNode(const std::string& lookupNodeIdentity);
@@ -15,9 +15,15 @@
  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <thread>
 #include <vector>
 
 #include "Validator.h"
+#include "libConsensus/AggregateKeyCache.h"
 #include "libData/AccountStore/AccountStore.h"
 #include "libMediator/Mediator.h"
 #include "libMessage/Messenger.h"
@@ -220,9 +226,6 @@ bool Validator::CheckBlockCosignature(const DirectoryBlock& block,
     LOG_MARKER();
   }
 
-  unsigned int index = 0;
-  unsigned int count = 0;
-
   const vector<bool>& B2 = block.GetB2();
   if (commKeys.size() != B2.size()) {
     LOG_GENERAL(WARNING, "Mismatch: committee size = "
@@ -231,22 +234,15 @@ bool Validator::CheckBlockCosignature(const DirectoryBlock& block,
     return false;
   }
 
-  // Generate the aggregated key
-  vector<PubKey> keys;
-  for (auto const& kv : commKeys) {
-    if (B2.at(index)) {
-      keys.emplace_back(get<PubKey>(kv));
-      count++;
-    }
-    index++;
-  }
+  const unsigned int count = std::count(B2.begin(), B2.end(), true);
 
   if (count != ConsensusCommon::NumForConsensus(B2.size())) {
     LOG_GENERAL(WARNING, "Cosig was not generated by enough nodes");
     return false;
   }
 
-  shared_ptr<PubKey> aggregatedKey = MultiSig::AggregatePubKeys(keys);
+  shared_ptr<const PubKey> aggregatedKey =
+      AggregateKeyCache::GetInstance().GetAggregatedKey(commKeys, B2);
   if (aggregatedKey == nullptr) {
     LOG_GENERAL(WARNING, "Aggregated key generation failed");
     return false;
@@ -261,8 +257,12 @@ bool Validator::CheckBlockCosignature(const DirectoryBlock& block,
   if (!MultiSig::MultiSigVerify(serializedHeader, 0, serializedHeader.size(),
                                 block.GetCS2(), *aggregatedKey)) {
     LOG_GENERAL(WARNING, "Cosig verification failed");
-    for (auto& kv : keys) {
-      LOG_GENERAL(WARNING, kv);
+    unsigned int index = 0;
+    for (auto const& kv : commKeys) {
+      if (B2.at(index)) {
+        LOG_GENERAL(WARNING, get<PubKey>(kv));
+      }
+      index++;
     }
     return false;
   }
@@ -274,65 +274,21 @@ bool Validator::CheckDirBlocks(
     const vector<boost::variant<DSBlock, VCBlock>>& dirBlocks,
     const DequeOfNode& initDsComm, const uint64_t& index_num,
     DequeOfNode& newDSComm) {
-  DequeOfNode mutable_ds_comm = initDsComm;
-
-  bool ret = true;
-
-  uint64_t prevdsblocknum =
-      m_mediator.m_dsBlockChain.GetLastBlock().GetHeader().GetBlockNum();
   uint64_t totalIndex = index_num;
-  ShardingHash prevShardingHash =
-      m_mediator.m_dsBlockChain.GetLastBlock().GetHeader().GetShardingHash();
-  BlockHash prevHash = get<BlockLinkIndex::BLOCKHASH>(
-      m_mediator.m_blocklinkchain.GetLatestBlockLink());
-
-  for (const auto& dirBlock : dirBlocks) {
+  const auto applyBlock = [this, &totalIndex](const DirBlock& dirBlock) {
     if (typeid(DSBlock) == dirBlock.type()) {
       const auto& dsblock = get<DSBlock>(dirBlock);
-      if (dsblock.GetHeader().GetBlockNum() != prevdsblocknum + 1) {
-        LOG_GENERAL(WARNING, "DSblocks not in sequence "
-                                 << dsblock.GetHeader().GetBlockNum() << " "
-                                 << prevdsblocknum);
-        ret = false;
-        break;
-      }
-      if (dsblock.GetHeader().GetMyHash() != dsblock.GetBlockHash()) {
-        LOG_GENERAL(WARNING, "DSblock "
-                                 << prevdsblocknum + 1
-                                 << " has different blockhash than stored "
-                                 << " Stored: " << dsblock.GetBlockHash());
-        ret = false;
-        break;
-      }
-
-      if (!CheckBlockCosignature(dsblock, mutable_ds_comm)) {
-        LOG_GENERAL(WARNING, "Co-sig verification of ds block "
-                                 << prevdsblocknum + 1 << " failed");
-        ret = false;
-        break;
-      }
-      if (prevHash != dsblock.GetHeader().GetPrevHash()) {
-        LOG_GENERAL(WARNING, "prevHash incorrect "
-                                 << prevHash << " "
-                                 << dsblock.GetHeader().GetPrevHash()
-                                 << " in DS block " << prevdsblocknum + 1);
-        ret = false;
-        break;
-      }
-      prevdsblocknum++;
-      prevShardingHash = dsblock.GetHeader().GetShardingHash();
       m_mediator.m_blocklinkchain.AddBlockLink(
-          totalIndex, prevdsblocknum, BlockType::DS, dsblock.GetBlockHash());
+          totalIndex, dsblock.GetHeader().GetBlockNum(), BlockType::DS,
+          dsblock.GetBlockHash());
       m_mediator.m_dsBlockChain.AddBlock(dsblock);
       zbytes serializedDSBlock;
       dsblock.Serialize(serializedDSBlock, 0);
-      prevHash = dsblock.GetBlockHash();
       if (!BlockStorage::GetBlockStorage().PutDSBlock(
               dsblock.GetHeader().GetBlockNum(), serializedDSBlock)) {
         LOG_GENERAL(WARNING, "BlockStorage::PutDSBlock failed " << dsblock);
         return false;
       }
-      m_mediator.m_node->UpdateDSCommitteeComposition(mutable_ds_comm, dsblock);
       totalIndex++;
       if (!BlockStorage::GetBlockStorage().ResetDB(BlockStorage::STATE_DELTA)) {
         LOG_GENERAL(WARNING, "BlockStorage::ResetDB failed");
@@ -340,46 +296,9 @@ bool Validator::CheckDirBlocks(
       }
     } else if (typeid(VCBlock) == dirBlock.type()) {
       const auto& vcblock = get<VCBlock>(dirBlock);
-
-      if (vcblock.GetHeader().GetViewChangeDSEpochNo() != prevdsblocknum + 1) {
-        LOG_GENERAL(WARNING,
-                    "VC block ds epoch number does not match the number being "
-                    "processed "
-                        << prevdsblocknum << " "
-                        << vcblock.GetHeader().GetViewChangeDSEpochNo());
-        ret = false;
-        break;
-      }
-      if (vcblock.GetHeader().GetMyHash() != vcblock.GetBlockHash()) {
-        LOG_GENERAL(WARNING, "VCblock in "
-                                 << prevdsblocknum
-                                 << " has different blockhash than stored "
-                                 << " Stored: " << vcblock.GetBlockHash());
-        ret = false;
-        break;
-      }
-      if (!CheckBlockCosignature(vcblock, mutable_ds_comm)) {
-        LOG_GENERAL(WARNING, "Co-sig verification of vc block in "
-                                 << prevdsblocknum << " failed"
-                                 << totalIndex + 1);
-        ret = false;
-        break;
-      }
-
-      if (prevHash != vcblock.GetHeader().GetPrevHash()) {
-        LOG_GENERAL(WARNING, "prevHash incorrect "
-                                 << prevHash << " "
-                                 << vcblock.GetHeader().GetPrevHash()
-                                 << "in VC block " << prevdsblocknum + 1);
-        ret = false;
-        break;
-      }
-
-      m_mediator.m_node->UpdateRetrieveDSCommitteeCompositionAfterVC(
-          vcblock, mutable_ds_comm);
-      m_mediator.m_blocklinkchain.AddBlockLink(totalIndex, prevdsblocknum + 1,
-                                               BlockType::VC,
-                                               vcblock.GetBlockHash());
+      m_mediator.m_blocklinkchain.AddBlockLink(
+          totalIndex, vcblock.GetHeader().GetViewChangeDSEpochNo(),
+          BlockType::VC, vcblock.GetBlockHash());
       zbytes vcblockserialized;
       vcblock.Serialize(vcblockserialized, 0);
       if (!BlockStorage::GetBlockStorage().PutVCBlock(vcblock.GetBlockHash(),
@@ -387,115 +306,200 @@ bool Validator::CheckDirBlocks(
         LOG_GENERAL(WARNING, "BlockStorage::PutVCBlock failed " << vcblock);
         return false;
       }
-      prevHash = vcblock.GetBlockHash();
       totalIndex++;
-    } else {
-      LOG_GENERAL(WARNING, "dirBlock type unexpected ");
     }
-  }
-
-  newDSComm = std::move(mutable_ds_comm);
-  return ret;
+    return true;
+  };
+
+  return CheckDirBlocksCore(
+      dirBlocks, initDsComm,
+      m_mediator.m_dsBlockChain.GetLastBlock().GetHeader().GetBlockNum(),
+      get<BlockLinkIndex::BLOCKHASH>(
+          m_mediator.m_blocklinkchain.GetLatestBlockLink()),
+      newDSComm, true, applyBlock);
 }
 
 bool Validator::CheckDirBlocksNoUpdate(
     const vector<boost::variant<DSBlock, VCBlock>>& dirBlocks,
-    const DequeOfNode& initDsComm, const uint64_t& index_num,
+    const DequeOfNode& initDsComm, [[maybe_unused]] const uint64_t& index_num,
     DequeOfNode& newDSComm) {
-  DequeOfNode mutable_ds_comm = initDsComm;
+  return CheckDirBlocksCore(
+      dirBlocks, initDsComm, 0,
+      get<BlockLinkIndex::BLOCKHASH>(
+          BlockLinkChain::GetFromPersistentStorage(0)),
+      newDSComm, false, [](const DirBlock&) { return true; });
+}
 
+bool Validator::CheckDirBlocksCore(
+    const vector<DirBlock>& dirBlocks, const DequeOfNode& initDsComm,
+    uint64_t prevdsblocknum, BlockHash prevHash, DequeOfNode& newDSComm,
+    const bool showLogs, const function<bool(const DirBlock&)>& applyBlock) {
+  const auto startTime = chrono::steady_clock::now();
+  DequeOfNode mutable_ds_comm = initDsComm;
   bool ret = true;
-
-  uint64_t prevdsblocknum = 0;
-  uint64_t totalIndex = index_num;
-  BlockHash prevHash = get<BlockLinkIndex::BLOCKHASH>(
-      BlockLinkChain::GetFromPersistentStorage(0));
-
-  for (const auto& dirBlock : dirBlocks) {
-    if (typeid(DSBlock) == dirBlock.type()) {
-      const auto& dsblock = get<DSBlock>(dirBlock);
-      if (dsblock.GetHeader().GetBlockNum() != prevdsblocknum + 1) {
-        LOG_GENERAL(WARNING, "DSblocks not in sequence "
-                                 << dsblock.GetHeader().GetBlockNum() << " "
-                                 << prevdsblocknum);
-        ret = false;
-        break;
-      }
-      if (dsblock.GetHeader().GetMyHash() != dsblock.GetBlockHash()) {
-        LOG_GENERAL(WARNING, "DSblock "
-                                 << prevdsblocknum + 1
-                                 << " has different blockhash than stored "
-                                 << " Stored: " << dsblock.GetBlockHash());
-        ret = false;
-        break;
-      }
-      if (!CheckBlockCosignature(dsblock, mutable_ds_comm, false)) {
-        LOG_GENERAL(WARNING, "Co-sig verification of ds block "
-                                 << prevdsblocknum + 1 << " failed");
-        ret = false;
-        break;
+  size_t numVerified = 0;
+
+  // The committee evolution has to be followed block by block, but once the
+  // committee of every block is known the co-signatures can be verified in
+  // parallel. Blocks are processed in windows to bound the committee copies.
+  for (size_t windowStart = 0; ret && windowStart < dirBlocks.size();
+       windowStart += DIR_BLOCK_VERIFY_WINDOW) {
+    const size_t windowEnd =
+        min(dirBlocks.size(), windowStart + DIR_BLOCK_VERIFY_WINDOW);
+
+    // committees[i] is the committee expected to sign block windowStart + i
+    vector<DequeOfNode> committees;
+    size_t numLinked = 0;
+    for (size_t i = windowStart; i < windowEnd; i++) {
+      committees.emplace_back(mutable_ds_comm);
+      const auto& dirBlock = dirBlocks[i];
+      if (typeid(DSBlock) == dirBlock.type()) {
+        const auto& dsblock = get<DSBlock>(dirBlock);
+        if (dsblock.GetHeader().GetBlockNum() != prevdsblocknum + 1) {
+          LOG_GENERAL(WARNING, "DSblocks not in sequence "
+                                   << dsblock.GetHeader().GetBlockNum() << " "
+                                   << prevdsblocknum);
+          ret = false;
+          break;
+        }
+        if (dsblock.GetHeader().GetMyHash() != dsblock.GetBlockHash()) {
+          LOG_GENERAL(WARNING, "DSblock "
+                                   << prevdsblocknum + 1
+                                   << " has different blockhash than stored "
+                                   << " Stored: " << dsblock.GetBlockHash());
+          ret = false;
+          break;
+        }
+        if (prevHash != dsblock.GetHeader().GetPrevHash()) {
+          LOG_GENERAL(WARNING, "prevHash incorrect "
+                                   << prevHash << " "
+                                   << dsblock.GetHeader().GetPrevHash()
+                                   << " in DS block " << prevdsblocknum + 1);
+          ret = false;
+          break;
+        }
+        prevdsblocknum++;
+        prevHash = dsblock.GetBlockHash();
+        m_mediator.m_node->UpdateDSCommitteeComposition(mutable_ds_comm,
+                                                        dsblock, showLogs);
+      } else if (typeid(VCBlock) == dirBlock.type()) {
+        const auto& vcblock = get<VCBlock>(dirBlock);
+        if (vcblock.GetHeader().GetViewChangeDSEpochNo() !=
+            prevdsblocknum + 1) {
+          LOG_GENERAL(
+              WARNING,
+              "VC block ds epoch number does not match the number being "
+              "processed "
+                  << prevdsblocknum << " "
+                  << vcblock.GetHeader().GetViewChangeDSEpochNo());
+          ret = false;
+          break;
+        }
+        if (vcblock.GetHeader().GetMyHash() != vcblock.GetBlockHash()) {
+          LOG_GENERAL(WARNING, "VCblock in "
+                                   << prevdsblocknum
+                                   << " has different blockhash than stored "
+                                   << " Stored: " << vcblock.GetBlockHash());
+          ret = false;
+          break;
+        }
+        if (prevHash != vcblock.GetHeader().GetPrevHash()) {
+          LOG_GENERAL(WARNING, "prevHash incorrect "
+                                   << prevHash << " "
+                                   << vcblock.GetHeader().GetPrevHash()
+                                   << "in VC block " << prevdsblocknum + 1);
+          ret = false;
+          break;
+        }
+        prevHash = vcblock.GetBlockHash();
+        m_mediator.m_node->UpdateRetrieveDSCommitteeCompositionAfterVC(
+            vcblock, mutable_ds_comm, showLogs);
+      } else {
+        LOG_GENERAL(WARNING, "dirBlock type unexpected ");
       }
-      if (prevHash != dsblock.GetHeader().GetPrevHash()) {
-        LOG_GENERAL(WARNING, "prevHash incorrect "
-                                 << prevHash << " "
-                                 << dsblock.GetHeader().GetPrevHash()
-                                 << " in DS block " << prevdsblocknum + 1);
-        ret = false;
-        break;
-      }
-      prevdsblocknum++;
-      prevHash = dsblock.GetBlockHash();
-      m_mediator.m_node->UpdateDSCommitteeComposition(mutable_ds_comm, dsblock,
-                                                      false);
-      totalIndex++;
-    } else if (typeid(VCBlock) == dirBlock.type()) {
-      const auto& vcblock = get<VCBlock>(dirBlock);
+      numLinked++;
+    }
 
-      if (vcblock.GetHeader().GetViewChangeDSEpochNo() != prevdsblocknum + 1) {
-        LOG_GENERAL(WARNING,
-                    "VC block ds epoch number does not match the number being "
-                    "processed "
-                        << prevdsblocknum << " "
-                        << vcblock.GetHeader().GetViewChangeDSEpochNo());
-        ret = false;
-        break;
+    const size_t numValid = CheckDirBlockCosignatures(
+        dirBlocks, windowStart, committees, numLinked, showLogs);
+    for (size_t i = windowStart; i < windowStart + numValid; i++) {
+      if (!applyBlock(dirBlocks[i])) {
+        return false;
       }
-      if (vcblock.GetHeader().GetMyHash() != vcblock.GetBlockHash()) {
-        LOG_GENERAL(WARNING, "VCblock in "
-                                 << prevdsblocknum
-                                 << " has different blockhash than stored "
-                                 << " Stored: " << vcblock.GetBlockHash());
-        ret = false;
+    }
+    numVerified += numValid;
+
+    if (numValid < committees.size()) {
+      // Stop at the first invalid block with the committee expected to sign it
+      ret = false;
+      mutable_ds_comm = std::move(committees[numValid]);
+    }
+  }
+
+  const auto elapsedMs = chrono::duration_cast<chrono::milliseconds>(
+                             chrono::steady_clock::now() - startTime)
+                             .count();
+  const auto blocksPerSec = numVerified * 1000 / max<int64_t>(elapsedMs, 1);
+  LOG_GENERAL(INFO, "Verified " << numVerified << " dir blocks in "
+                                << elapsedMs << " ms (" << blocksPerSec
+                                << " blocks/s)");
+
+  newDSComm = std::move(mutable_ds_comm);
+  return ret;
+}
+
+size_t Validator::CheckDirBlockCosignatures(
+    const vector<DirBlock>& dirBlocks, size_t offset,
+    const vector<DequeOfNode>& committees, size_t count, const bool showLogs) {
+  atomic<size_t> nextIndex{0};
+  atomic<size_t> firstInvalid{count};
+
+  const auto verify = [&]() {
+    for (size_t i = nextIndex++; i < count; i = nextIndex++) {
+      if (i > firstInvalid) {
+        // Only the blocks before the first invalid one are accepted
         break;
       }
-      if (!CheckBlockCosignature(vcblock, mutable_ds_comm, false)) {
-        LOG_GENERAL(WARNING, "Co-sig verification of vc block in "
-                                 << prevdsblocknum << " failed"
-                                 << totalIndex + 1);
-        ret = false;
-        break;
+      const auto& dirBlock = dirBlocks[offset + i];
+      bool valid = true;
+      if (typeid(DSBlock) == dirBlock.type()) {
+        const auto& dsblock = get<DSBlock>(dirBlock);
+        valid = CheckBlockCosignature(dsblock, committees[i], showLogs);
+        if (!valid) {
+          LOG_GENERAL(WARNING, "Co-sig verification of ds block "
+                                   << dsblock.GetHeader().GetBlockNum()
+                                   << " failed");
+        }
+      } else if (typeid(VCBlock) == dirBlock.type()) {
+        const auto& vcblock = get<VCBlock>(dirBlock);
+        valid = CheckBlockCosignature(vcblock, committees[i], showLogs);
+        if (!valid) {
+          LOG_GENERAL(WARNING,
+                      "Co-sig verification of vc block in "
+                          << vcblock.GetHeader().GetViewChangeDSEpochNo() - 1
+                          << " failed");
+        }
       }
-
-      if (prevHash != vcblock.GetHeader().GetPrevHash()) {
-        LOG_GENERAL(WARNING, "prevHash incorrect "
-                                 << prevHash << " "
-                                 << vcblock.GetHeader().GetPrevHash()
-                                 << "in VC block " << prevdsblocknum + 1);
-        ret = false;
-        break;
+      if (!valid) {
+        size_t current = firstInvalid;
+        while (i < current && !firstInvalid.compare_exchange_weak(current, i)) {
+        }
       }
-
-      m_mediator.m_node->UpdateRetrieveDSCommitteeCompositionAfterVC(
-          vcblock, mutable_ds_comm, false);
-      prevHash = vcblock.GetBlockHash();
-      totalIndex++;
-    } else {
-      LOG_GENERAL(WARNING, "dirBlock type unexpected ");
     }
+  };
+
+  const size_t numThreads =
+      min<size_t>(max(thread::hardware_concurrency(), 1u), count);
+  vector<future<void>> workers;
+  for (size_t t = 1; t < numThreads; t++) {
+    workers.emplace_back(async(launch::async, verify));
+  }
+  verify();
+  for (auto& worker : workers) {
+    worker.get();
   }
 
-  newDSComm = std::move(mutable_ds_comm);
-  return ret;
+  return firstInvalid;
 }
 
 template bool Validator::CheckBlockCosignature<
@@ -19,7 +19,9 @@
 #define ZILLIQA_SRC_LIBVALIDATOR_VALIDATOR_H_
 
 #include <boost/variant.hpp>
+#include <functional>
 #include <string>
+#include <vector>
 #include "common/TxnStatus.h"
 #include "libBlockchain/Block.h"
 #include "libData/AccountData/Transaction.h"
@@ -59,6 +61,28 @@ class Validator {
       DequeOfNode& newDSComm);
 
   Mediator& m_mediator;
+
+ private:
+  using DirBlock = boost::variant<DSBlock, VCBlock>;
+
+  /// Number of directory blocks whose co-signatures are verified together
+  static constexpr size_t DIR_BLOCK_VERIFY_WINDOW = 256;
+
+  /// Checks the directory blocks and follows the DS committee through them,
+  /// calling applyBlock on each block found valid, in order.
+  bool CheckDirBlocksCore(
+      const std::vector<DirBlock>& dirBlocks, const DequeOfNode& initDsComm,
+      uint64_t prevdsblocknum, BlockHash prevHash, DequeOfNode& newDSComm,
+      const bool showLogs,
+      const std::function<bool(const DirBlock&)>& applyBlock);
+
+  /// Verifies the co-signatures of dirBlocks[offset, offset + count) in
+  /// parallel against committees[0, count) and returns the number of
+  /// leading blocks with a valid co-signature.
+  size_t CheckDirBlockCosignatures(const std::vector<DirBlock>& dirBlocks,
+                                   size_t offset,
+                                   const std::vector<DequeOfNode>& committees,
+                                   size_t count, const bool showLogs);
 };
 
 #endif  // ZILLIQA_SRC_LIBVALIDATOR_VALIDATOR_H_
@@ -0,0 +1,53 @@
+/*
+ * Copyright (C) 2023 Zilliqa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "BenchUtils.h"
+
+#include <benchmark/benchmark.h>
+
+#include "common/Constants.h"
+#include "libTestUtils/TestUtils.h"
+#include "libUtils/Logger.h"
+
+using namespace std;
+
+namespace BenchUtils {
+
+const vector<Transaction>& GetTransactions(size_t count) {
+  static vector<Transaction> transactions;
+  while (transactions.size() < count) {
+    transactions.emplace_back(TestUtils::GenerateRandomTransaction(
+        TRANSACTION_VERSION, transactions.size(),
+        Transaction::NON_CONTRACT));
+  }
+  return transactions;
+}
+
+}  // namespace BenchUtils
+
+int main(int argc, char** argv) {
+  // Keep the log out of the benchmark output
+  INIT_FILE_LOGGER("zilliqa_bench", "./")
+
+  benchmark::Initialize(&argc, argv);
+  if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+    return 1;
+  }
+  benchmark::RunSpecifiedBenchmarks();
+  benchmark::Shutdown();
+  return 0;
+}
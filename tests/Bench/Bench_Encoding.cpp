@@ -0,0 +1,83 @@
+/*
+ * Copyright (C) 2023 Zilliqa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "depends/common/RLP.h"
+#include "libNetwork/P2PMessage.h"
+#include "libTestUtils/TestUtils.h"
+
+using namespace std;
+
+namespace {
+
+// The fields of an Ethereum style transaction
+dev::RLPStream EncodeFields(const zbytes& data) {
+  dev::RLPStream stream(9);
+  stream << 1u << dev::u256(1000000000) << 21000u << dev::h160(1)
+         << dev::u256(1000000000000000000) << data << 27u << dev::h256(2)
+         << dev::h256(3);
+  return stream;
+}
+
+void BM_RLPEncode(benchmark::State& state) {
+  const zbytes data = TestUtils::GenerateRandomCharVector(state.range(0));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(EncodeFields(data).out());
+  }
+}
+BENCHMARK(BM_RLPEncode)->Arg(0)->Arg(1024);
+
+void BM_RLPDecode(benchmark::State& state) {
+  const zbytes encoded =
+      EncodeFields(TestUtils::GenerateRandomCharVector(state.range(0))).out();
+  for (auto _ : state) {
+    const dev::RLP rlp(encoded);
+    for (const auto& item : rlp) {
+      benchmark::DoNotOptimize(item.toBytes());
+    }
+  }
+  state.SetBytesProcessed(state.iterations() * encoded.size());
+}
+BENCHMARK(BM_RLPDecode)->Arg(0)->Arg(1024);
+
+void BM_P2PCreateMessage(benchmark::State& state) {
+  const zbytes message = TestUtils::GenerateRandomCharVector(state.range(0));
+  const zbytes hash(zil::p2p::HASH_LEN, 1);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(zil::p2p::CreateMessage(
+        message, hash, zil::p2p::START_BYTE_BROADCAST, false));
+  }
+  state.SetBytesProcessed(state.iterations() * message.size());
+}
+BENCHMARK(BM_P2PCreateMessage)->Arg(256)->Arg(1 << 20);
+
+void BM_P2PTryReadMessage(benchmark::State& state) {
+  const zbytes message = TestUtils::GenerateRandomCharVector(state.range(0));
+  const zbytes hash(zil::p2p::HASH_LEN, 1);
+  const auto raw = zil::p2p::CreateMessage(
+      message, hash, zil::p2p::START_BYTE_BROADCAST, false);
+  for (auto _ : state) {
+    zil::p2p::ReadMessageResult result{nullptr};
+    benchmark::DoNotOptimize(zil::p2p::TryReadMessage(
+        static_cast<const uint8_t*>(raw.data.get()), raw.size, result));
+  }
+  state.SetBytesProcessed(state.iterations() * raw.size);
+}
+BENCHMARK(BM_P2PTryReadMessage)->Arg(256)->Arg(1 << 20);
+
+}  // namespace
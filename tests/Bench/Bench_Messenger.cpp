@@ -0,0 +1,87 @@
+/*
+ * Copyright (C) 2023 Zilliqa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "BenchUtils.h"
+#include "libBlockchain/MicroBlock.h"
+#include "libMessage/Messenger.h"
+#include "libTestUtils/TestUtils.h"
+
+using namespace std;
+
+namespace {
+
+void BM_SetTransaction(benchmark::State& state) {
+  const auto& txn = BenchUtils::GetTransactions(1).front();
+  zbytes dst;
+  for (auto _ : state) {
+    dst.clear();
+    benchmark::DoNotOptimize(Messenger::SetTransaction(dst, 0, txn));
+  }
+  state.SetBytesProcessed(state.iterations() * dst.size());
+}
+BENCHMARK(BM_SetTransaction);
+
+void BM_GetTransaction(benchmark::State& state) {
+  zbytes src;
+  Messenger::SetTransaction(src, 0, BenchUtils::GetTransactions(1).front());
+  for (auto _ : state) {
+    Transaction txn;
+    benchmark::DoNotOptimize(Messenger::GetTransaction(src, 0, txn));
+  }
+  state.SetBytesProcessed(state.iterations() * src.size());
+}
+BENCHMARK(BM_GetTransaction);
+
+MicroBlock MakeMicroBlock(size_t numTxns) {
+  const auto& txns = BenchUtils::GetTransactions(numTxns);
+  vector<TxnHash> tranHashes;
+  tranHashes.reserve(numTxns);
+  for (size_t i = 0; i < numTxns; i++) {
+    tranHashes.emplace_back(txns[i].GetTranID());
+  }
+  MicroBlockHeader header(0, 1000000, 0, 0, 1, {},
+                          static_cast<uint32_t>(numTxns),
+                          TestUtils::GenerateRandomPubKey(), 1);
+  return MicroBlock(header, move(tranHashes),
+                    TestUtils::GenerateRandomCoSignatures());
+}
+
+void BM_SerializeMicroBlock(benchmark::State& state) {
+  const auto microBlock = MakeMicroBlock(state.range(0));
+  zbytes dst;
+  for (auto _ : state) {
+    dst.clear();
+    benchmark::DoNotOptimize(microBlock.Serialize(dst, 0));
+  }
+  state.SetBytesProcessed(state.iterations() * dst.size());
+}
+BENCHMARK(BM_SerializeMicroBlock)->Arg(100)->Arg(2000);
+
+void BM_DeserializeMicroBlock(benchmark::State& state) {
+  zbytes src;
+  MakeMicroBlock(state.range(0)).Serialize(src, 0);
+  for (auto _ : state) {
+    MicroBlock microBlock;
+    benchmark::DoNotOptimize(microBlock.Deserialize(src, 0));
+  }
+  state.SetBytesProcessed(state.iterations() * src.size());
+}
+BENCHMARK(BM_DeserializeMicroBlock)->Arg(100)->Arg(2000);
+
+}  // namespace
@@ -0,0 +1,138 @@
+/*
+ * Copyright (C) 2023 Zilliqa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <map>
+#include <string>
+
+#include <benchmark/benchmark.h>
+
+#include "common/Constants.h"
+#include "depends/common/FixedHash.h"
+#include "depends/libTrie/TrieDB.h"
+#include "libData/AccountData/Account.h"
+#include "libPersistence/ContractStorage.h"
+#include "libPersistence/ScillaMessage.pb.h"
+#include "libTestUtils/TestUtils.h"
+#include "libUtils/DataConversion.h"
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wunused-parameter"
+#include "depends/libDatabase/OverlayDB.h"
+#pragma GCC diagnostic pop
+
+using namespace std;
+
+namespace {
+
+using BenchTrie = dev::GenericTrieDB<dev::OverlayDB>;
+
+zbytes TrieKey(size_t i) {
+  return dev::h256(static_cast<unsigned>(i)).asBytes();
+}
+
+void BM_TrieInsert(benchmark::State& state) {
+  dev::OverlayDB db("benchTrieDB");
+  const zbytes value = TestUtils::GenerateRandomCharVector(64);
+  for (auto _ : state) {
+    state.PauseTiming();
+    db.ResetDB();
+    BenchTrie trie(&db);
+    trie.init();
+    state.ResumeTiming();
+    for (size_t i = 0; i < static_cast<size_t>(state.range(0)); i++) {
+      trie.insert(TrieKey(i), value);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_TrieInsert)->Arg(1000)->Arg(10000);
+
+void BM_TrieAt(benchmark::State& state) {
+  dev::OverlayDB db("benchTrieDB");
+  db.ResetDB();
+  BenchTrie trie(&db);
+  trie.init();
+  const zbytes value = TestUtils::GenerateRandomCharVector(64);
+  for (size_t i = 0; i < static_cast<size_t>(state.range(0)); i++) {
+    trie.insert(TrieKey(i), value);
+  }
+  size_t i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(trie.at(TrieKey(i++ % state.range(0))));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_TrieAt)->Arg(1000)->Arg(10000);
+
+void BM_TrieCommit(benchmark::State& state) {
+  dev::OverlayDB db("benchTrieDB");
+  const zbytes value = TestUtils::GenerateRandomCharVector(64);
+  for (auto _ : state) {
+    state.PauseTiming();
+    db.ResetDB();
+    BenchTrie trie(&db);
+    trie.init();
+    for (size_t i = 0; i < static_cast<size_t>(state.range(0)); i++) {
+      trie.insert(TrieKey(i), value);
+    }
+    state.ResumeTiming();
+    benchmark::DoNotOptimize(db.commit());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_TrieCommit)->Arg(1000)->Arg(10000);
+
+void BM_FetchStateValue(benchmark::State& state) {
+  auto& storage = Contract::ContractStorage::GetContractStorage();
+  const Address addr =
+      Account::GetAddressFromPublicKey(TestUtils::GenerateRandomPubKey());
+  const size_t numEntries = state.range(0);
+
+  auto mapKey = [](size_t i) { return "\"0x" + to_string(1000 + i) + "\""; };
+
+  map<string, zbytes> states;
+  states.emplace(
+      storage.GenerateStorageKey(addr, MAP_DEPTH_INDICATOR, {"balances"}),
+      DataConversion::StringToCharArray("1"));
+  for (size_t i = 0; i < numEntries; i++) {
+    states.emplace(storage.GenerateStorageKey(addr, "balances", {mapKey(i)}),
+                   DataConversion::StringToCharArray(to_string(i)));
+  }
+  dev::h256 root;
+  storage.UpdateStateDatasAndToDeletes(addr, dev::h256(), states, {}, root,
+                                       false, false);
+  storage.CommitStateDB(1);
+
+  ProtoScillaQuery query;
+  query.set_name("balances");
+  query.set_mapdepth(1);
+  size_t i = 0;
+  zbytes dst;
+  bool foundVal = false;
+  for (auto _ : state) {
+    state.PauseTiming();
+    query.clear_indices();
+    query.add_indices(mapKey(i++ % numEntries));
+    state.ResumeTiming();
+    benchmark::DoNotOptimize(
+        storage.FetchStateValue(addr, query, dst, 0, foundVal));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_FetchStateValue)->Arg(1000);
+
+}  // namespace
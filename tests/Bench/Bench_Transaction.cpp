@@ -0,0 +1,98 @@
+/*
+ * Copyright (C) 2023 Zilliqa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <list>
+
+#include <benchmark/benchmark.h>
+
+#include "BenchUtils.h"
+#include "libData/AccountData/TxnPool.h"
+#include "libNode/RootComputation.h"
+
+using namespace std;
+
+namespace {
+
+void BM_TransactionVerify(benchmark::State& state) {
+  const auto& txn = BenchUtils::GetTransactions(1).front();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(Transaction::Verify(txn));
+  }
+}
+BENCHMARK(BM_TransactionVerify);
+
+void BM_ComputeRootOfHashes(benchmark::State& state) {
+  const auto& txns = BenchUtils::GetTransactions(state.range(0));
+  vector<dev::h256> hashes;
+  for (size_t i = 0; i < static_cast<size_t>(state.range(0)); i++) {
+    hashes.emplace_back(txns[i].GetTranID());
+  }
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(ComputeRoot(hashes));
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ComputeRootOfHashes)->Arg(100)->Arg(2000);
+
+void BM_ComputeRootOfTransactions(benchmark::State& state) {
+  const auto& txns = BenchUtils::GetTransactions(state.range(0));
+  const list<Transaction> received(txns.begin(), txns.begin() + state.range(0));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(ComputeRoot(received, {}));
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ComputeRootOfTransactions)->Arg(100)->Arg(2000);
+
+void BM_TxnPoolInsert(benchmark::State& state) {
+  const auto& txns = BenchUtils::GetTransactions(state.range(0));
+  MempoolInsertionStatus status;
+  for (auto _ : state) {
+    state.PauseTiming();
+    TxnPool pool;
+    state.ResumeTiming();
+    for (size_t i = 0; i < static_cast<size_t>(state.range(0)); i++) {
+      pool.insert(txns[i], status);
+    }
+    state.PauseTiming();
+    pool.clear();
+    state.ResumeTiming();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_TxnPoolInsert)->Arg(1000)->Arg(10000);
+
+void BM_TxnPoolFindOne(benchmark::State& state) {
+  const auto& txns = BenchUtils::GetTransactions(state.range(0));
+  MempoolInsertionStatus status;
+  for (auto _ : state) {
+    state.PauseTiming();
+    TxnPool pool;
+    for (size_t i = 0; i < static_cast<size_t>(state.range(0)); i++) {
+      pool.insert(txns[i], status);
+    }
+    state.ResumeTiming();
+    Transaction txn;
+    while (pool.findOne(txn)) {
+      benchmark::DoNotOptimize(txn);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_TxnPoolFindOne)->Arg(1000)->Arg(10000);
+
+}  // namespace
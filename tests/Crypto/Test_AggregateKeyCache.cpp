@@ -0,0 +1,166 @@
+/*
+ * Copyright (C) 2023 Zilliqa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <random>
+
+#include <MultiSig.h>
+#include "libConsensus/AggregateKeyCache.h"
+#include "libConsensus/ConsensusCommon.h"
+#include "libNetwork/ShardStruct.h"
+#include "libUtils/Logger.h"
+
+#define BOOST_TEST_MODULE aggregatekeycachetest
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+
+namespace {
+
+DequeOfNode GenerateCommittee(unsigned int size) {
+  DequeOfNode committee;
+  for (unsigned int i = 0; i < size; i++) {
+    committee.emplace_back(Schnorr::GenKeyPair().second, Peer());
+  }
+  return committee;
+}
+
+// Bitmap with the consensus threshold of randomly chosen members set
+vector<bool> GenerateBitmap(unsigned int size, mt19937& rng) {
+  vector<bool> bitmap(size, false);
+  fill_n(bitmap.begin(), ConsensusCommon::NumForConsensus(size), true);
+  shuffle(bitmap.begin(), bitmap.end(), rng);
+  return bitmap;
+}
+
+shared_ptr<PubKey> AggregateDirectly(const DequeOfNode& committee,
+                                     const vector<bool>& bitmap) {
+  vector<PubKey> keys;
+  for (size_t i = 0; i < committee.size(); i++) {
+    if (bitmap[i]) {
+      keys.emplace_back(committee[i].first);
+    }
+  }
+  return MultiSig::AggregatePubKeys(keys);
+}
+
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(aggregatekeycachetest)
+
+BOOST_AUTO_TEST_CASE(test_matches_direct_aggregation) {
+  INIT_STDOUT_LOGGER();
+
+  auto& cache = AggregateKeyCache::GetInstance();
+  cache.Clear();
+
+  mt19937 rng(1);
+  const auto committee = GenerateCommittee(100);
+  for (unsigned int i = 0; i < 50; i++) {
+    auto bitmap = GenerateBitmap(committee.size(), rng);
+    if (i % 10 == 0) {
+      // Also cover bitmaps where most of the committee is absent
+      bitmap.flip();
+    }
+    const auto expected = AggregateDirectly(committee, bitmap);
+    BOOST_REQUIRE(expected);
+
+    const auto key = cache.GetAggregatedKey(committee, bitmap);
+    BOOST_REQUIRE(key);
+    BOOST_CHECK(*key == *expected);
+
+    // The second lookup is served from the cache
+    BOOST_CHECK(cache.GetAggregatedKey(committee, bitmap) == key);
+  }
+
+  const vector<bool> allPresent(committee.size(), true);
+  BOOST_CHECK(*cache.GetAggregatedKey(committee, allPresent) ==
+              *AggregateDirectly(committee, allPresent));
+
+  const vector<bool> nonePresent(committee.size(), false);
+  BOOST_CHECK(!cache.GetAggregatedKey(committee, nonePresent));
+
+  const vector<bool> wrongSize(committee.size() - 1, true);
+  BOOST_CHECK(!cache.GetAggregatedKey(committee, wrongSize));
+}
+
+BOOST_AUTO_TEST_CASE(test_committee_change) {
+  INIT_STDOUT_LOGGER();
+
+  auto& cache = AggregateKeyCache::GetInstance();
+  cache.Clear();
+
+  mt19937 rng(2);
+  auto committee = GenerateCommittee(20);
+  const auto bitmap = GenerateBitmap(committee.size(), rng);
+  const auto key = cache.GetAggregatedKey(committee, bitmap);
+  BOOST_REQUIRE(key);
+
+  // Rotating the committee must not return the key of the old one
+  const auto last = committee.back();
+  committee.pop_back();
+  committee.push_front(last);
+  const auto rotatedKey = cache.GetAggregatedKey(committee, bitmap);
+  BOOST_REQUIRE(rotatedKey);
+  BOOST_CHECK(*rotatedKey == *AggregateDirectly(committee, bitmap));
+}
+
+// Compares the time to aggregate the keys of 10k co-signature bitmaps of a
+// 600 member committee with and without the cache
+BOOST_AUTO_TEST_CASE(benchmark_aggregation) {
+  INIT_STDOUT_LOGGER();
+
+  auto& cache = AggregateKeyCache::GetInstance();
+  cache.Clear();
+
+  const unsigned int COMMITTEE_SIZE = 600;
+  const unsigned int NUM_BLOCKS = 10000;
+  // Co-signers rarely change between consecutive blocks
+  const unsigned int NUM_DISTINCT_BITMAPS = 100;
+
+  mt19937 rng(3);
+  const auto committee = GenerateCommittee(COMMITTEE_SIZE);
+  vector<vector<bool>> bitmaps;
+  for (unsigned int i = 0; i < NUM_DISTINCT_BITMAPS; i++) {
+    bitmaps.emplace_back(GenerateBitmap(COMMITTEE_SIZE, rng));
+  }
+
+  auto start = chrono::steady_clock::now();
+  for (unsigned int i = 0; i < NUM_BLOCKS; i++) {
+    BOOST_REQUIRE(AggregateDirectly(committee, bitmaps[i % bitmaps.size()]));
+  }
+  const auto directMs = chrono::duration_cast<chrono::milliseconds>(
+                            chrono::steady_clock::now() - start)
+                            .count();
+
+  start = chrono::steady_clock::now();
+  for (unsigned int i = 0; i < NUM_BLOCKS; i++) {
+    BOOST_REQUIRE(
+        cache.GetAggregatedKey(committee, bitmaps[i % bitmaps.size()]));
+  }
+  const auto cachedMs = chrono::duration_cast<chrono::milliseconds>(
+                            chrono::steady_clock::now() - start)
+                            .count();
+
+  LOG_GENERAL(INFO, "Aggregated keys of " << NUM_BLOCKS << " blocks in "
+                                          << directMs << " ms directly, "
+                                          << cachedMs << " ms cached");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,101 @@
+/*
+ * Copyright (C) 2023 Zilliqa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <MultiSig.h>
+#include "libConsensus/ConsensusCommon.h"
+#include "libUtils/Logger.h"
+
+#define BOOST_TEST_MODULE aggregateresponsetest
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+
+namespace {
+
+// One round of responses as a leader sees them: the signer keys, their
+// commits and their responses to the challenge over the aggregate
+struct Round {
+  vector<PubKey> keys;
+  vector<CommitPoint> commits;
+  vector<Response> responses;
+  PubKey aggregatedKey;
+  Challenge challenge;
+};
+
+Round GenerateRound(unsigned int nbsigners) {
+  Round round;
+  vector<PrivKey> privkeys;
+  for (unsigned int i = 0; i < nbsigners; i++) {
+    PairOfKey keypair = Schnorr::GenKeyPair();
+    privkeys.emplace_back(keypair.first);
+    round.keys.emplace_back(keypair.second);
+  }
+
+  vector<CommitSecret> secrets(nbsigners);
+  for (unsigned int i = 0; i < nbsigners; i++) {
+    round.commits.emplace_back(secrets.at(i));
+  }
+
+  round.aggregatedKey = *MultiSig::AggregatePubKeys(round.keys);
+  const zbytes message(1024, 0x01);
+  round.challenge = Challenge(*MultiSig::AggregateCommits(round.commits),
+                              round.aggregatedKey, message);
+  for (unsigned int i = 0; i < nbsigners; i++) {
+    round.responses.emplace_back(secrets.at(i), round.challenge,
+                                 privkeys.at(i));
+  }
+  return round;
+}
+
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(aggregateresponsetest)
+
+BOOST_AUTO_TEST_CASE(test_valid_responses_pass_aggregate_check) {
+  INIT_STDOUT_LOGGER();
+
+  const Round round = GenerateRound(50);
+
+  BOOST_CHECK(ConsensusCommon::VerifyAggregatedResponses(
+      round.responses, round.challenge, round.aggregatedKey, round.commits));
+  BOOST_CHECK(ConsensusCommon::FindInvalidResponses(
+                  round.responses, round.challenge, round.keys, round.commits)
+                  .empty());
+}
+
+BOOST_AUTO_TEST_CASE(test_tampered_response_is_removed) {
+  INIT_STDOUT_LOGGER();
+
+  Round round = GenerateRound(50);
+
+  // Swap in a response to another challenge, which is well formed but does
+  // not satisfy s * G + c * P = Q for this round
+  const size_t tampered = 17;
+  const Round other = GenerateRound(1);
+  round.responses.at(tampered) = other.responses.front();
+
+  BOOST_CHECK(!ConsensusCommon::VerifyAggregatedResponses(
+      round.responses, round.challenge, round.aggregatedKey, round.commits));
+
+  const auto invalid = ConsensusCommon::FindInvalidResponses(
+      round.responses, round.challenge, round.keys, round.commits);
+  BOOST_REQUIRE_EQUAL(invalid.size(), 1u);
+  BOOST_CHECK_EQUAL(invalid.front(), tampered);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -148,4 +148,26 @@ BOOST_AUTO_TEST_CASE(testAddrDecodeNegativeCase3) {
   }
 }
 
+BOOST_AUTO_TEST_CASE(testStateTrieKeys) {
+  zbytes tmpAddr;
+  DataConversion::HexStrToUint8Vec("4baf5fada8e5db92c3d3242618c5b47133ae003c",
+                                   tmpAddr);
+  const Address address{tmpAddr};
+
+  const auto hexKey = GetStateTrieKey(address, HEX_ADDRESS_KEYS);
+  BOOST_CHECK_EQUAL(DataConversion::CharArrayToString(hexKey), address.hex());
+  const auto binaryKey = GetStateTrieKey(address, BINARY_ADDRESS_KEYS);
+  BOOST_CHECK(binaryKey == address.asBytes());
+
+  BOOST_CHECK_EQUAL(GetAddressFromStateTrieKey(dev::zbytesConstRef(&hexKey)),
+                    address);
+  BOOST_CHECK_EQUAL(
+      GetAddressFromStateTrieKey(dev::zbytesConstRef(&binaryKey)), address);
+
+  const zbytes invalidKey(7, 'x');
+  BOOST_CHECK_EQUAL(
+      GetAddressFromStateTrieKey(dev::zbytesConstRef(&invalidKey)),
+      NullAddress);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
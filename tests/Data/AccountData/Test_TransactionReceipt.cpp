@@ -26,6 +26,8 @@
 #include "libData/AccountData/TransactionReceipt.h"
 #include "libTestUtils/TestUtils.h"
 #include "libUtils/DataConversion.h"
+#include "libUtils/JsonUtils.h"
+#include "libUtils/MemoryStats.h"
 
 struct Fixture {
   Fixture() { INIT_STDOUT_LOGGER() }
@@ -148,4 +150,89 @@ BOOST_AUTO_TEST_CASE(transactionwithreceipt) {
                         txnOrder, twr_map, th_out));
   BOOST_CHECK_EQUAL(true, hash == th_out);
 }
+
+TransactionReceipt BuildReceipt(unsigned int numLogs) {
+  TransactionReceipt tr;
+  tr.SetResult(true);
+  tr.SetCumGas(TestUtils::DistUint64());
+  tr.SetEpochNum(TestUtils::DistUint64());
+  for (unsigned int i = 0; i < numLogs; i++) {
+    Json::Value params;
+    params["vname"] = "amount";
+    params["type"] = "Uint128";
+    params["value"] = std::to_string(TestUtils::DistUint64());
+    Json::Value log;
+    log["_eventname"] = "TransferSuccess";
+    log["address"] = "0x" + Address::random().hex();
+    log["params"].append(params);
+    tr.AppendJsonEntry(log);
+  }
+  tr.AddTransition(Address::random(), Json::Value("transfer"), 1);
+  tr.update();
+  return tr;
+}
+
+BOOST_AUTO_TEST_CASE(transactionreceipt_update_after_render) {
+  // Errors added to an empty receipt are dropped, as before it was rendered
+  TransactionReceipt tr;
+  tr.AddError(RUNNER_FAILED);
+  tr.update();
+  BOOST_CHECK_EQUAL(tr.GetString(), "{}");
+
+  tr.SetResult(false);
+  tr.update();
+  const std::string rendered = tr.GetString();
+  BOOST_CHECK_EQUAL(tr.GetSuccess(), false);
+  BOOST_CHECK_EQUAL(tr.GetJsonValue()["errors"]["0"][0].asUInt(),
+                    RUNNER_FAILED);
+
+  // Building on a rendered receipt starts from its string
+  tr.AddEdge();
+  tr.AddError(GAS_NOT_SUFFICIENT);
+  tr.SetResult(true);
+  BOOST_CHECK_EQUAL(tr.GetString(), rendered);
+  tr.update();
+  BOOST_CHECK_EQUAL(tr.GetSuccess(), true);
+  const auto receiptJson = tr.GetJsonValue();
+  BOOST_CHECK_EQUAL(receiptJson["errors"]["0"][0].asUInt(), RUNNER_FAILED);
+  BOOST_CHECK_EQUAL(receiptJson["errors"]["1"][0].asUInt(),
+                    GAS_NOT_SUFFICIENT);
+  BOOST_CHECK_EQUAL(receiptJson["success"].asBool(), true);
+
+  zbytes src;
+  BOOST_CHECK(tr.Serialize(src, 0));
+  TransactionReceipt tr_2;
+  BOOST_CHECK(tr_2.Deserialize(src, 0));
+  BOOST_CHECK_EQUAL(tr_2.GetString(), tr.GetString());
+  BOOST_CHECK_EQUAL(tr_2.GetSuccess(), true);
+}
+
+BOOST_AUTO_TEST_CASE(transactionreceipt_memory_10k) {
+  constexpr unsigned int NUM_RECEIPTS = 10000;
+  constexpr unsigned int NUM_LOGS = 4;
+
+  const int64_t startMem = DisplayPhysicalMemoryStats("Receipts start", 0);
+  std::vector<TransactionReceipt> receipts;
+  receipts.reserve(NUM_RECEIPTS);
+  for (unsigned int i = 0; i < NUM_RECEIPTS; i++) {
+    receipts.emplace_back(BuildReceipt(NUM_LOGS));
+  }
+  const int64_t receiptsMem =
+      DisplayPhysicalMemoryStats("Receipts rendered", startMem);
+
+  // What every receipt used to keep on top of its string
+  std::vector<Json::Value> trees(NUM_RECEIPTS);
+  for (unsigned int i = 0; i < NUM_RECEIPTS; i++) {
+    BOOST_REQUIRE(JSONUtils::GetInstance().convertStrtoJson(
+        receipts[i].GetString(), trees[i]));
+    BOOST_CHECK(trees[i] == receipts[i].GetJsonValue());
+  }
+  const int64_t treesMem =
+      DisplayPhysicalMemoryStats("Receipt JSON trees", receiptsMem);
+
+  LOG_GENERAL(INFO, NUM_RECEIPTS << " receipts: " << receiptsMem - startMem
+                                 << " MB, JSON trees: "
+                                 << treesMem - receiptsMem << " MB more");
+}
+
 BOOST_AUTO_TEST_SUITE_END()
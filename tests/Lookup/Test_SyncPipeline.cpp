@@ -0,0 +1,246 @@
+/*
+ * Copyright (C) 2023 Zilliqa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include "libLookup/SyncPipeline.h"
+#include "libUtils/Logger.h"
+
+#define BOOST_TEST_MODULE syncpipelinetest
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+
+namespace {
+
+// Stands in for a seed node, answering range requests after a delay
+class StandInSeed {
+ public:
+  StandInSeed(SyncPipeline& pipeline, chrono::milliseconds latency,
+              bool responsive = true)
+      : m_pipeline(pipeline),
+        m_latency(latency),
+        m_responsive(responsive),
+        m_thread([this]() { Serve(); }) {}
+
+  ~StandInSeed() {
+    {
+      lock_guard<mutex> g(m_mutex);
+      m_stop = true;
+    }
+    m_cv.notify_all();
+    m_thread.join();
+  }
+
+  void Request(uint64_t low, uint64_t high) {
+    {
+      lock_guard<mutex> g(m_mutex);
+      m_requests.emplace_back(low, high);
+    }
+    m_cv.notify_all();
+  }
+
+  unsigned int GetNumRequests() const { return m_numRequests; }
+
+ private:
+  void Serve() {
+    unique_lock<mutex> lock(m_mutex);
+    while (true) {
+      m_cv.wait(lock, [this]() { return m_stop || !m_requests.empty(); });
+      if (m_stop) {
+        return;
+      }
+      const auto [low, high] = m_requests.front();
+      m_requests.pop_front();
+      m_numRequests++;
+      if (!m_responsive) {
+        continue;
+      }
+
+      lock.unlock();
+      this_thread::sleep_for(m_latency);
+      vector<zbytes> items;
+      for (uint64_t blockNum = low; blockNum <= high; blockNum++) {
+        items.emplace_back(zbytes{static_cast<uint8_t>(blockNum)});
+      }
+      m_pipeline.OnResponse(low, high, std::move(items));
+      lock.lock();
+    }
+  }
+
+  SyncPipeline& m_pipeline;
+  const chrono::milliseconds m_latency;
+  const bool m_responsive;
+  mutex m_mutex;
+  condition_variable m_cv;
+  deque<pair<uint64_t, uint64_t>> m_requests;
+  atomic<unsigned int> m_numRequests{0};
+  bool m_stop = false;
+  thread m_thread;
+};
+
+struct SeedNetwork {
+  vector<Peer> m_peers;
+  vector<unique_ptr<StandInSeed>> m_seeds;
+
+  void Add(SyncPipeline& pipeline, chrono::milliseconds latency,
+           bool responsive = true) {
+    m_peers.emplace_back(m_peers.size() + 1, 30303);
+    m_seeds.emplace_back(
+        make_unique<StandInSeed>(pipeline, latency, responsive));
+  }
+
+  SyncPipeline::SendRequest Sender() {
+    return [this](const Peer& peer, uint64_t low, uint64_t high) {
+      for (size_t i = 0; i < m_peers.size(); i++) {
+        if (m_peers[i] == peer) {
+          m_seeds[i]->Request(low, high);
+        }
+      }
+    };
+  }
+};
+
+// Checks that the blocks are applied exactly once and in order
+SyncPipeline::ApplyRange OrderChecker(uint64_t& nextBlockNum) {
+  return [&nextBlockNum](uint64_t low, uint64_t high,
+                         const vector<zbytes>& items) {
+    BOOST_REQUIRE_EQUAL(low, nextBlockNum);
+    BOOST_REQUIRE_EQUAL(items.size(), high - low + 1);
+    for (const auto& item : items) {
+      BOOST_REQUIRE(item == zbytes{static_cast<uint8_t>(nextBlockNum)});
+      nextBlockNum++;
+    }
+    return true;
+  };
+}
+
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(syncpipelinetest)
+
+BOOST_AUTO_TEST_CASE(test_in_order_from_several_seeds) {
+  INIT_STDOUT_LOGGER();
+
+  SyncPipeline pipeline("test", 8, 10, chrono::seconds(5), 3);
+  SeedNetwork network;
+  // Responses from the faster seeds overtake the ones of the slower seeds
+  network.Add(pipeline, chrono::milliseconds(1));
+  network.Add(pipeline, chrono::milliseconds(5));
+  network.Add(pipeline, chrono::milliseconds(20));
+
+  uint64_t nextBlockNum = 1;
+  BOOST_REQUIRE(pipeline.Run(1, 1000, network.m_peers, network.Sender(),
+                             OrderChecker(nextBlockNum)));
+  BOOST_CHECK_EQUAL(nextBlockNum, 1001);
+
+  // Every seed got requests and was measured
+  for (size_t i = 0; i < network.m_seeds.size(); i++) {
+    BOOST_CHECK_GT(network.m_seeds[i]->GetNumRequests(), 0);
+    BOOST_CHECK_GT(pipeline.GetThroughput(network.m_peers[i]), 0);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(test_unresponsive_seed) {
+  INIT_STDOUT_LOGGER();
+
+  SyncPipeline pipeline("test", 4, 10, chrono::milliseconds(100), 3);
+  SeedNetwork network;
+  network.Add(pipeline, chrono::milliseconds(1), false);
+  network.Add(pipeline, chrono::milliseconds(1));
+
+  // The ranges sent to the unresponsive seed are sent again to the other
+  uint64_t nextBlockNum = 1;
+  BOOST_REQUIRE(pipeline.Run(1, 200, network.m_peers, network.Sender(),
+                             OrderChecker(nextBlockNum)));
+  BOOST_CHECK_EQUAL(nextBlockNum, 201);
+}
+
+BOOST_AUTO_TEST_CASE(test_no_responsive_seed) {
+  INIT_STDOUT_LOGGER();
+
+  SyncPipeline pipeline("test", 4, 10, chrono::milliseconds(50), 2);
+  SeedNetwork network;
+  network.Add(pipeline, chrono::milliseconds(1), false);
+
+  uint64_t nextBlockNum = 1;
+  BOOST_CHECK(!pipeline.Run(1, 100, network.m_peers, network.Sender(),
+                            OrderChecker(nextBlockNum)));
+  BOOST_CHECK_EQUAL(nextBlockNum, 1);
+  BOOST_CHECK(!pipeline.IsRunning());
+  BOOST_CHECK(!pipeline.OnResponse(1, 10, vector<zbytes>(10)));
+}
+
+BOOST_AUTO_TEST_CASE(test_finish) {
+  INIT_STDOUT_LOGGER();
+
+  SyncPipeline pipeline("test", 4, 10, chrono::seconds(5), 3);
+  SeedNetwork network;
+  network.Add(pipeline, chrono::milliseconds(1), false);
+
+  // Finishing stops waiting for the unresponsive seed but isn't a failure
+  uint64_t nextBlockNum = 1;
+  thread finisher([&pipeline]() {
+    while (!pipeline.IsRunning()) {
+      this_thread::sleep_for(chrono::milliseconds(1));
+    }
+    pipeline.Finish();
+  });
+  BOOST_CHECK(pipeline.Run(1, 100, network.m_peers, network.Sender(),
+                           OrderChecker(nextBlockNum)));
+  finisher.join();
+  BOOST_CHECK_EQUAL(nextBlockNum, 1);
+  BOOST_CHECK(!pipeline.IsRunning());
+}
+
+// Catch-up time of 10k blocks from 4 stand-in seeds, stop-and-wait against
+// the pipeline
+BOOST_AUTO_TEST_CASE(benchmark_catch_up) {
+  INIT_STDOUT_LOGGER();
+
+  const uint64_t NUM_BLOCKS = 10000;
+  const uint64_t CHUNK_SIZE = 100;
+  const auto LATENCY = chrono::milliseconds(20);
+
+  for (const unsigned int window : {1u, 8u}) {
+    SyncPipeline pipeline("test", window, CHUNK_SIZE, chrono::seconds(5), 3);
+    SeedNetwork network;
+    for (unsigned int i = 0; i < 4; i++) {
+      network.Add(pipeline, LATENCY);
+    }
+
+    uint64_t nextBlockNum = 1;
+    const auto start = chrono::steady_clock::now();
+    BOOST_REQUIRE(pipeline.Run(1, NUM_BLOCKS, network.m_peers,
+                               network.Sender(), OrderChecker(nextBlockNum)));
+    const auto elapsedMs = chrono::duration_cast<chrono::milliseconds>(
+                               chrono::steady_clock::now() - start)
+                               .count();
+    BOOST_CHECK_EQUAL(nextBlockNum, NUM_BLOCKS + 1);
+    LOG_GENERAL(INFO, "Window " << window << ": " << NUM_BLOCKS
+                                << " blocks in " << elapsedMs << " ms");
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -34,6 +34,7 @@
 #include <boost/test/unit_test.hpp>
 #include <fstream>
 #include <iostream>
+#include <thread>
 #include <vector>
 #include "libTestUtils/TestUtils.h"
 
@@ -265,6 +266,28 @@ BOOST_AUTO_TEST_CASE(test_block60000_verification) {
   BOOST_REQUIRE(POW::CheckDifficulty(ret.final_hash, difficulty));
 }
 
+BOOST_AUTO_TEST_CASE(pregenerated_epoch_context_verification) {
+  // Same solution as test_block30001_verification, hashed with the context
+  // that was pregenerated before the node reached epoch 1
+  POW& POWClient = POW::GetInstance();
+  POWClient.EthashConfigureClient(ETHASH_EPOCH_LENGTH - 1);
+  POWClient.PregenerateNextEpochContext(ETHASH_EPOCH_LENGTH - 1, false);
+  for (int i = 0; i < 600 && !POWClient.IsEpochContextReady(1, false); ++i) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  }
+  BOOST_REQUIRE(POWClient.IsEpochContextReady(1, false));
+
+  ethash_hash256 seedhash = POW::StringToBlockhash(
+      "7e44356ee3441623bc72a683fd3708fdf75e971bbe294f33e539eedad4b92b34");
+  ethash::result ret =
+      POWClient.LightHash(30001, seedhash, 0x318df1c8adef7e5eU);
+  BOOST_REQUIRE(!POWClient.IsEpochContextReady(1, false));
+  ethash_hash256 difficulty{};
+  const auto&& initList = {0x17, 0x62, 0xff};
+  move(initList.begin(), initList.end(), difficulty.bytes);
+  BOOST_REQUIRE(POW::CheckDifficulty(ret.final_hash, difficulty));
+}
+
 BOOST_AUTO_TEST_CASE(mining_and_verification) {
   POW& POWClient = POW::GetInstance();
   std::array<unsigned char, 32> rand1 = {{'0', '1'}};
@@ -309,6 +332,50 @@ BOOST_AUTO_TEST_CASE(mining_and_verification) {
   BOOST_REQUIRE(!verifyWinningNonce);
 }
 
+BOOST_AUTO_TEST_CASE(batch_verification) {
+  POW& POWClient = POW::GetInstance();
+  std::array<unsigned char, 32> rand1 = {{'0', '1'}};
+  std::array<unsigned char, 32> rand2 = {{'0', '2'}};
+  auto peer = TestUtils::GenerateRandomPeer();
+  auto keyPair = Schnorr::GenKeyPair();
+  auto pubKey = keyPair.second;
+
+  uint8_t difficultyToUse = 5;
+  uint64_t blockToUse = 0;
+  auto headerHash = POW::GenHeaderHash(rand1, rand2, peer, pubKey, 0, 0, {});
+  HeaderHashParams headerParams{rand1, rand2, peer, pubKey, 0, 0};
+  ethash_mining_result_t winning_result =
+      POWClient.PoWMine(blockToUse, difficultyToUse, keyPair, headerHash, false,
+                        std::time(0), POW_WINDOW_IN_SECONDS, headerParams);
+  BOOST_REQUIRE(winning_result.success);
+
+  rand1 = {{'0', '3'}};
+  auto wrongHeaderHash =
+      POW::GenHeaderHash(rand1, rand2, peer, pubKey, 0, 0, {});
+
+  const PoWVerifyRequest valid{blockToUse,
+                               difficultyToUse,
+                               headerHash,
+                               winning_result.winning_nonce,
+                               winning_result.result,
+                               winning_result.mix_hash};
+  auto wrongHeader = valid;
+  wrongHeader.headerHash = wrongHeaderHash;
+  auto tooDifficult = valid;
+  tooDifficult.difficulty = 30;
+  auto wrongNonce = valid;
+  wrongNonce.nonce = 0;
+
+  // The repeated valid submission is served from the verified cache
+  const std::vector<PoWVerifyRequest> requests{valid, wrongHeader,
+                                               tooDifficult, wrongNonce, valid};
+  const std::vector<bool> expected{true, false, false, false, true};
+  for (unsigned int numThreads : {1u, 2u, 4u, 0u}) {
+    BOOST_CHECK(POWClient.PoWVerifyBatch(requests, numThreads) == expected);
+  }
+  BOOST_CHECK(POWClient.PoWVerifyBatch({}).empty());
+}
+
 BOOST_AUTO_TEST_CASE(mining_and_verification_big_block_number) {
   POW& POWClient = POW::GetInstance();
   std::array<unsigned char, 32> rand1 = {{'0', '1'}};
@@ -420,6 +487,58 @@ BOOST_AUTO_TEST_CASE(mining_high_diffculty_time_out) {
   BOOST_REQUIRE(!verifyLight);
 }
 
+BOOST_AUTO_TEST_CASE(multithreaded_mining_and_verification) {
+  POW& POWClient = POW::GetInstance();
+  std::array<unsigned char, 32> rand1 = {{'0', '1'}};
+  std::array<unsigned char, 32> rand2 = {{'0', '2'}};
+  auto peer = TestUtils::GenerateRandomPeer();
+  auto keyPair = Schnorr::GenKeyPair();
+  auto pubKey = keyPair.second;
+
+  uint8_t difficultyToUse = 5;
+  uint64_t blockToUse = 0;
+  auto headerHash = POW::GenHeaderHash(rand1, rand2, peer, pubKey, 0, 0, {});
+  auto boundary = POW::DifficultyLevelInIntDevided(difficultyToUse);
+  for (unsigned int numThreads : {1, 2, 4}) {
+    ethash_mining_result_t winning_result =
+        POWClient.PoWMineCpu(blockToUse, headerHash, boundary, false,
+                             std::time(0), POW_WINDOW_IN_SECONDS, numThreads);
+    BOOST_REQUIRE(winning_result.success);
+    BOOST_REQUIRE(POWClient.PoWVerify(
+        blockToUse, difficultyToUse, headerHash, winning_result.winning_nonce,
+        winning_result.result, winning_result.mix_hash));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(cpu_mining_hashrate) {
+  POW& POWClient = POW::GetInstance();
+  std::array<unsigned char, 32> rand1 = {{'0', '1'}};
+  std::array<unsigned char, 32> rand2 = {{'0', '2'}};
+  auto peer = TestUtils::GenerateRandomPeer();
+  auto pubKey = Schnorr::GenKeyPair().second;
+  auto headerHash = POW::GenHeaderHash(rand1, rand2, peer, pubKey, 0, 0, {});
+
+  // No hash is below a zero boundary, so every run mines for the whole window
+  const ethash_hash256 boundary{};
+  std::vector<unsigned int> threadCounts;
+  for (unsigned int n = 1; n < POW::GetCpuMineThreads(); n *= 2) {
+    threadCounts.emplace_back(n);
+  }
+  threadCounts.emplace_back(POW::GetCpuMineThreads());
+
+  for (bool fullDataset : {false, true}) {
+    for (auto numThreads : threadCounts) {
+      auto result = POWClient.PoWMineCpu(0, headerHash, boundary, fullDataset,
+                                         0, 2, numThreads);
+      BOOST_CHECK(!result.success);
+      BOOST_CHECK_GT(POWClient.GetCpuHashrate(), 0u);
+      LOG_GENERAL(INFO, (fullDataset ? "Full" : "Light")
+                            << " dataset, " << numThreads << " threads: "
+                            << POWClient.GetCpuHashrate() << " hashes/s");
+    }
+  }
+}
+
 // Please enable the OPENCL_GPU_MINE option in constants.xml to run this test
 // case
 BOOST_AUTO_TEST_CASE(gpu_mining_and_verification_1) {
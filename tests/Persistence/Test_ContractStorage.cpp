@@ -101,4 +101,69 @@ BOOST_AUTO_TEST_CASE(contract_proof_test) {
       proof, root1, hashed_key2));
 }
 
+BOOST_AUTO_TEST_CASE(contract_state_page_test) {
+  INIT_STDOUT_LOGGER();
+
+  LOG_MARKER();
+
+  auto& storage = ContractStorage::GetContractStorage();
+  PairOfKey kpair = Schnorr::GenKeyPair();
+  Address addr = Account::GetAddressFromPublicKey(kpair.second);
+
+  auto balanceEntry = [&](unsigned int i) {
+    const string key = "\"0xaa" + to_string(100 + i) + "\"";
+    return make_pair(storage.GenerateStorageKey(addr, "balances", {key}),
+                     DataConversion::StringToCharArray(
+                         "\"" + to_string(i) + "\""));
+  };
+
+  // Half of the entries are committed to the database, the rest stays in
+  // memory, so that the page walk has to merge both
+  map<string, zbytes> committed;
+  committed.emplace(
+      storage.GenerateStorageKey(addr, MAP_DEPTH_INDICATOR, {"balances"}),
+      DataConversion::StringToCharArray("1"));
+  map<string, zbytes> uncommitted;
+  for (unsigned int i = 0; i < 10; i++) {
+    (i % 2 == 0 ? committed : uncommitted).emplace(balanceEntry(i));
+  }
+
+  h256 root;
+  storage.UpdateStateDatasAndToDeletes(addr, dev::h256(), committed, {}, root,
+                                       false, false);
+  BOOST_CHECK(storage.CommitStateDB(101));
+  storage.UpdateStateDatasAndToDeletes(addr, root, uncommitted, {}, root,
+                                       false, false);
+
+  set<string> seen;
+  string cursor;
+  unsigned int pages = 0;
+  do {
+    Json::Value page;
+    string nextCursor;
+    BOOST_REQUIRE(storage.FetchStateJsonPageForContract(
+        page, addr, "balances", "", cursor, 3, nextCursor));
+    BOOST_CHECK_LE(page["balances"].size(), 3u);
+    for (const auto& key : page["balances"].getMemberNames()) {
+      BOOST_CHECK(seen.insert(key).second);
+    }
+    cursor = nextCursor;
+    ++pages;
+  } while (!cursor.empty() && pages < 10);
+
+  BOOST_CHECK_EQUAL(seen.size(), 10u);
+  BOOST_CHECK_EQUAL(seen.count("0xaa100"), 1u);
+
+  Json::Value projected;
+  string nextCursor;
+  BOOST_REQUIRE(storage.FetchStateJsonPageForContract(
+      projected, addr, "balances", "0xaa10", "", 100, nextCursor));
+  BOOST_CHECK_EQUAL(projected["balances"].size(), 10u);
+  BOOST_CHECK_EQUAL(projected["balances"]["0xaa105"].asString(), "5");
+  BOOST_CHECK(nextCursor.empty());
+
+  BOOST_CHECK(!storage.FetchStateJsonPageForContract(
+      projected, addr, "balances", "", "zz", 100, nextCursor));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
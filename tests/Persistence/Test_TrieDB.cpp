@@ -16,10 +16,15 @@
  */
 
 #include <leveldb/db.h>
+#include <chrono>
+#include <map>
+#include <random>
 #include <string>
+#include <thread>
 
 #include "depends/common/FixedHash.h"
 #include "depends/common/RLP.h"
+#include "depends/common/SHA3.h"
 #include "libData/AccountData/Account.h"
 #include "libData/DataStructures/TraceableDB.h"
 #include "libUtils/DataConversion.h"
@@ -48,6 +53,17 @@ struct Fixture {
 
 BOOST_GLOBAL_FIXTURE(Fixture);
 
+/// Benchmarks only run when TRIE_BENCH_ACCOUNTS is set to the number of
+/// accounts to use, e.g. 1000000 for a mainnet-sized state
+boost::test_tools::assertion_result BenchmarkEnabled(
+    boost::unit_test::test_unit_id) {
+  return getenv("TRIE_BENCH_ACCOUNTS") != nullptr;
+}
+
+unsigned int BenchmarkAccounts() {
+  return stoul(getenv("TRIE_BENCH_ACCOUNTS"));
+}
+
 BOOST_AUTO_TEST_SUITE(persistencetest)
 
 dev::h256 root1, root2;
@@ -227,6 +243,316 @@ BOOST_AUTO_TEST_CASE(proof) {
   LOG_GENERAL(INFO, JSONUtils::GetInstance().convertJsontoStr(j_value));
 }
 
+BOOST_AUTO_TEST_CASE(readsAfterCommit) {
+  constexpr unsigned int NUM_ENTRIES = 20000;
+  constexpr unsigned int NUM_LOOKUPS = 1000;
+
+  dev::OverlayDB m_db("trieDBReads");
+  GenericTrieDB<dev::OverlayDB> m_trie(&m_db);
+  m_trie.init();
+
+  vector<zbytes> keys;
+  for (unsigned int i = 0; i < NUM_ENTRIES; i++) {
+    keys.emplace_back(DataConversion::StringToCharArray("key" + to_string(i)));
+    m_trie.insert(keys.back(), DataConversion::StringToCharArray(to_string(i)));
+  }
+  BOOST_REQUIRE(m_trie.db()->commit());
+
+  // The first lookups after a commit are served by leveldb, measure them
+  // against the same lookups once warm
+  auto timeLookups = [&]() {
+    auto started = std::chrono::steady_clock::now();
+    for (unsigned int i = 0; i < NUM_LOOKUPS; i++) {
+      BOOST_CHECK_EQUAL(m_trie.at(keys[i]), to_string(i));
+    }
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+               std::chrono::steady_clock::now() - started)
+        .count();
+  };
+
+  const auto firstUs = timeLookups();
+  const auto warmUs = timeLookups();
+  LOG_GENERAL(INFO, "First " << NUM_LOOKUPS << " lookups after commit: "
+                             << firstUs << " us, warm: " << warmUs << " us");
+}
+
+BOOST_AUTO_TEST_CASE(killDropsOneReference) {
+  dev::OverlayDB db("memoryDBKill");
+  db.ResetDB();
+
+  // Two trie paths that share a node each hold a reference to it
+  const zbytes value = DataConversion::StringToCharArray("shared node");
+  const h256 hash = dev::sha3(value);
+  db.insert(hash, &value);
+  db.insert(hash, &value);
+
+  // Removing one path leaves the node to the other
+  db.kill(hash);
+  BOOST_CHECK(db.exists(hash));
+  BOOST_REQUIRE(db.commit());
+  BOOST_CHECK_EQUAL(db.lookup(hash), DataConversion::CharArrayToString(value));
+  db.ResetDB();
+}
+
+BOOST_AUTO_TEST_CASE(trieNodeCache) {
+  TrieNodeCache cache("test", 16 * 1024);
+
+  string value;
+  BOOST_CHECK(!cache.Get(h256(1), value));
+  cache.Put(h256(1), "node1", cache.GetEraseEpoch(h256(1)));
+  BOOST_CHECK(cache.Get(h256(1), value));
+  BOOST_CHECK_EQUAL(value, "node1");
+  cache.Erase(h256(1));
+  BOOST_CHECK(!cache.Get(h256(1), value));
+  BOOST_CHECK_EQUAL(cache.GetHits(), 1u);
+  BOOST_CHECK_EQUAL(cache.GetMisses(), 2u);
+
+  // A node read from disk before it was erased isn't cached again
+  const auto eraseEpoch = cache.GetEraseEpoch(h256(2));
+  cache.Erase(h256(2));
+  cache.Put(h256(2), "node2", eraseEpoch);
+  BOOST_CHECK(!cache.Get(h256(2), value));
+  cache.Put(h256(2), "node2", cache.GetEraseEpoch(h256(2)));
+  BOOST_CHECK(cache.Get(h256(2), value));
+
+  // Every shard holds 1KB, older nodes get evicted
+  for (unsigned int i = 0; i < 1000; i++) {
+    cache.Put(h256(i), string(100, 'x'), cache.GetEraseEpoch(h256(i)));
+  }
+  unsigned int cached = 0;
+  for (unsigned int i = 0; i < 1000; i++) {
+    cached += cache.Get(h256(i), value) ? 1 : 0;
+  }
+  BOOST_CHECK_GT(cached, 0u);
+  BOOST_CHECK_LT(cached, 1000u);
+}
+
+BOOST_AUTO_TEST_CASE(randomAccountReads,
+                     *boost::unit_test::precondition(BenchmarkEnabled)) {
+  const unsigned int numAccounts = BenchmarkAccounts();
+  constexpr unsigned int NUM_READS = 20000;
+
+  h256 root;
+  vector<zbytes> keys;
+  keys.reserve(numAccounts);
+  for (unsigned int i = 0; i < numAccounts; i++) {
+    keys.emplace_back(sha3(to_string(i)).asBytes());
+  }
+
+  {
+    dev::OverlayDB db("trieDBRandomReads");
+    db.ResetDB();
+    GenericTrieDB<dev::OverlayDB> trie(&db);
+    trie.init();
+    for (unsigned int i = 0; i < numAccounts; i++) {
+      trie.insert(keys[i], DataConversion::StringToCharArray(to_string(i)));
+    }
+    BOOST_REQUIRE(db.commit());
+    root = trie.root();
+  }
+
+  std::mt19937 gen(42);
+  std::uniform_int_distribution<unsigned int> dist(0, numAccounts - 1);
+  vector<unsigned int> reads(NUM_READS);
+  for (auto& read : reads) {
+    read = dist(gen);
+  }
+
+  auto timeReads = [&](GenericTrieDB<dev::OverlayDB>& trie) {
+    auto started = std::chrono::steady_clock::now();
+    for (auto i : reads) {
+      BOOST_CHECK_EQUAL(trie.at(keys[i]), to_string(i));
+    }
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+               std::chrono::steady_clock::now() - started)
+        .count();
+  };
+
+  int64_t uncachedUs = 0;
+  {
+    dev::OverlayDB db("trieDBRandomReads");
+    GenericTrieDB<dev::OverlayDB> trie(&db);
+    trie.setRoot(root);
+    timeReads(trie);
+    uncachedUs = timeReads(trie);
+  }
+
+  dev::OverlayDB db("trieDBRandomReads", 256 * 1024 * 1024);
+  GenericTrieDB<dev::OverlayDB> trie(&db);
+  trie.setRoot(root);
+  const auto coldUs = timeReads(trie);
+  const auto cachedUs = timeReads(trie);
+
+  LOG_GENERAL(INFO, NUM_READS << " random reads over " << numAccounts
+                              << " accounts, without node cache: "
+                              << uncachedUs << " us, cold: " << coldUs
+                              << " us, with node cache: " << cachedUs
+                              << " us");
+  db.ResetDB();
+}
+
+BOOST_AUTO_TEST_CASE(insertBatch) {
+  // Both the 40 character hex keys and the 20 byte binary keys of the state
+  // trie, so that the top branches are both sparse and full.
+  vector<pair<zbytes, zbytes>> base;
+  vector<pair<zbytes, zbytes>> updates;
+  for (unsigned int i = 0; i < 3000; i++) {
+    auto hash = sha3(to_string(i));
+    auto hex = hash.hex().substr(0, 40);
+    zbytes key = (i % 2) ? zbytes(hex.begin(), hex.end())
+                         : zbytes(hash.begin(), hash.begin() + 20);
+    auto value = DataConversion::StringToCharArray(to_string(i));
+    if (i < 2000) {
+      base.emplace_back(key, value);
+    }
+    if (i >= 1000) {
+      updates.emplace_back(key, zbytes(i % 7 + 1, i % 256));
+    }
+  }
+  // A repeated key must keep its last value
+  updates.emplace_back(updates.front().first, zbytes{1, 2, 3});
+  updates.emplace_back(updates.front().first, zbytes{4, 5, 6});
+
+  auto check = [&](unsigned int maxThreads, bool fromEmpty) {
+    dev::OverlayDB seqDB("trieDBBatchSeq");
+    seqDB.ResetDB();
+    GenericTrieDB<dev::OverlayDB> seqTrie(&seqDB);
+    seqTrie.init();
+
+    dev::OverlayDB batchDB("trieDBBatch");
+    batchDB.ResetDB();
+    GenericTrieDB<dev::OverlayDB> batchTrie(&batchDB);
+    batchTrie.init();
+
+    if (!fromEmpty) {
+      for (const auto& kv : base) {
+        seqTrie.insert(kv.first, kv.second);
+      }
+      batchTrie.insertBatch(base, maxThreads);
+      BOOST_CHECK_EQUAL(seqTrie.root(), batchTrie.root());
+    }
+
+    for (const auto& kv : updates) {
+      seqTrie.insert(kv.first, kv.second);
+    }
+    batchTrie.insertBatch(updates, maxThreads);
+    BOOST_CHECK_EQUAL(seqTrie.root(), batchTrie.root());
+
+    // Every node of the new trie must have made it to disk
+    BOOST_REQUIRE(batchDB.commit());
+    h256 root = batchTrie.root();
+    dev::OverlayDB reopened("trieDBBatch");
+    GenericTrieDB<dev::OverlayDB> reopenedTrie(&reopened);
+    reopenedTrie.setRoot(root);
+    map<zbytes, zbytes> expected;
+    if (!fromEmpty) {
+      for (const auto& kv : base) {
+        expected[kv.first] = kv.second;
+      }
+    }
+    for (const auto& kv : updates) {
+      expected[kv.first] = kv.second;
+    }
+    for (const auto& kv : expected) {
+      BOOST_CHECK_EQUAL(reopenedTrie.at(kv.first),
+                        DataConversion::CharArrayToString(kv.second));
+    }
+
+    seqDB.ResetDB();
+    batchDB.ResetDB();
+  };
+
+  for (unsigned int maxThreads : {1, 4, 0}) {
+    check(maxThreads, false);
+    check(maxThreads, true);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(insertBatchBenchmark,
+                     *boost::unit_test::precondition(BenchmarkEnabled)) {
+  const unsigned int numAccounts = BenchmarkAccounts();
+
+  vector<pair<zbytes, zbytes>> kvs;
+  kvs.reserve(numAccounts);
+  for (unsigned int i = 0; i < numAccounts; i++) {
+    kvs.emplace_back(sha3(to_string(i)).asBytes(),
+                     DataConversion::StringToCharArray(to_string(i)));
+  }
+
+  auto timeInsert = [&](bool batch) {
+    dev::OverlayDB db("trieDBBatchBench");
+    db.ResetDB();
+    GenericTrieDB<dev::OverlayDB> trie(&db);
+    trie.init();
+    auto started = std::chrono::steady_clock::now();
+    if (batch) {
+      trie.insertBatch(kvs);
+    } else {
+      for (const auto& kv : kvs) {
+        trie.insert(kv.first, kv.second);
+      }
+    }
+    auto root = trie.root();
+    auto us = std::chrono::duration_cast<std::chrono::microseconds>(
+                  std::chrono::steady_clock::now() - started)
+                  .count();
+    db.ResetDB();
+    return make_pair(root, us);
+  };
+
+  const auto sequential = timeInsert(false);
+  const auto batch = timeInsert(true);
+  BOOST_CHECK_EQUAL(sequential.first, batch.first);
+
+  LOG_GENERAL(INFO, "State root of " << numAccounts
+                                     << " accounts, sequential inserts: "
+                                     << sequential.second
+                                     << " us, batch insert: " << batch.second
+                                     << " us");
+}
+
+BOOST_AUTO_TEST_CASE(traceableDBIncrementalPurge) {
+  // Historical state is only kept on lookups
+  const bool lookupNodeMode = LOOKUP_NODE_MODE;
+  LOOKUP_NODE_MODE = true;
+  {
+    TraceableDB db("traceableDBPurge");
+    db.ResetDB();
+    GenericTrieDB<TraceableDB> trie(&db);
+    trie.init();
+    const auto key = DataConversion::StringToCharArray("aaa");
+
+    // The intermediate roots become garbage within the commit
+    uint64_t dsBlockNum = 1;
+    trie.insert(key, DataConversion::StringToCharArray("111"));
+    const h256 transient1 = trie.root();
+    trie.insert(key, DataConversion::StringToCharArray("222"));
+    const h256 transient2 = trie.root();
+    trie.insert(key, DataConversion::StringToCharArray("333"));
+    BOOST_REQUIRE(db.commit(dsBlockNum));
+    BOOST_CHECK(!db.lookup(transient1).empty());
+    BOOST_CHECK(!db.lookup(transient2).empty());
+
+    // A later epoch brings one of them back
+    trie.insert(key, DataConversion::StringToCharArray("111"));
+    BOOST_CHECK_EQUAL(trie.root(), transient1);
+    BOOST_REQUIRE(db.commit(++dsBlockNum));
+
+    while (dsBlockNum <= NUM_DS_EPOCHS_STATE_HISTORY + 1) {
+      BOOST_REQUIRE(db.commit(++dsBlockNum));
+    }
+    BOOST_CHECK_GT(db.GetPurgeLag(), 0u);
+
+    // Commits only queue the nodes, the purge worker deletes them
+    BOOST_CHECK(db.WaitForPurge(chrono::seconds(30)));
+    BOOST_CHECK_EQUAL(db.GetPurgeLag(), 0u);
+    BOOST_CHECK(db.lookup(transient2).empty());
+    BOOST_CHECK_EQUAL(trie.at(key), "111");
+    db.ResetDB();
+  }
+  LOOKUP_NODE_MODE = lookupNodeMode;
+}
+
 /*
   No longer applicable since we introduce TraceableDB
 */
@@ -228,4 +228,55 @@ BOOST_AUTO_TEST_CASE(testRandomBlockAccesses) {
   }
 }
 
+BOOST_AUTO_TEST_CASE(testTxLocations) {
+  LOG_MARKER();
+  if (LOOKUP_NODE_MODE) {
+    const uint64_t blockNum = TestUtils::DistUint32();
+
+    std::vector<MicroBlock> microBlocks;
+    std::vector<MicroBlockInfo> mbInfos;
+    for (uint32_t shardId = 0; shardId < 2; ++shardId) {
+      std::vector<TxnHash> tranHashes;
+      for (int i = 0; i < 3; ++i) {
+        tranHashes.emplace_back(
+            constructDummyTxBody(shardId * 3 + i).GetTransaction().GetTranID());
+      }
+      MicroBlockHashSet hashSet{};
+      hashSet.m_txRootHash = tranHashes[0];
+      MicroBlockHeader header(shardId, 0, 0, 0, blockNum, hashSet,
+                              tranHashes.size(), PubKey(), 0);
+      microBlocks.emplace_back(header, tranHashes, CoSignatures());
+      const auto& mb = microBlocks.back();
+      mbInfos.push_back({mb.GetBlockHash(), mb.GetHeader().GetTxRootHash(),
+                         shardId});
+
+      zbytes body;
+      mb.Serialize(body, 0);
+      BlockStorage::GetBlockStorage().PutMicroBlock(mb.GetBlockHash(), blockNum,
+                                                    shardId, body);
+    }
+
+    TxBlock txBlock(TestUtils::createTxBlockHeader(blockNum), mbInfos,
+                    CoSignatures());
+    zbytes serializedTxBlock;
+    txBlock.Serialize(serializedTxBlock, 0);
+    BlockStorage::GetBlockStorage().PutTxBlock(txBlock.GetHeader(),
+                                               serializedTxBlock);
+
+    BOOST_CHECK(BlockStorage::GetBlockStorage().PutTxLocations(microBlocks[1]));
+
+    TxLocation location;
+    BOOST_REQUIRE(BlockStorage::GetBlockStorage().GetTxLocation(
+        microBlocks[1].GetTranHashes()[2], location));
+    BOOST_CHECK_EQUAL(location.m_blockNum, blockNum);
+    BOOST_CHECK_EQUAL(location.m_mbIndex, 1u);
+    BOOST_CHECK_EQUAL(location.m_txIndexInMb, 2u);
+    BOOST_REQUIRE(location.m_txIndexInBlock);
+    BOOST_CHECK_EQUAL(*location.m_txIndexInBlock, 5u);
+
+    BOOST_CHECK(!BlockStorage::GetBlockStorage().GetTxLocation(
+        microBlocks[0].GetTranHashes()[0], location));
+  }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
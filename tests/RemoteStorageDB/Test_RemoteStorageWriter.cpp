@@ -0,0 +1,214 @@
+/*
+ * Copyright (C) 2023 Zilliqa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <bsoncxx/builder/basic/document.hpp>
+#include <bsoncxx/builder/basic/kvp.hpp>
+#include <mongocxx/model/insert_one.hpp>
+
+#include "libRemoteStorageDB/RemoteStorageWriter.h"
+#include "libUtils/Logger.h"
+
+#define BOOST_TEST_MODULE remotestoragewritertest
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+using bsoncxx::builder::basic::kvp;
+using bsoncxx::builder::basic::make_document;
+
+namespace {
+
+// Stands in for mongod, recording the size of the batches written to it. It
+// can be held to keep a batch write from completing, or made to fail them.
+class StandInMongo {
+ public:
+  bool Write(vector<RemoteStorageWriter::Op>& batch) {
+    unique_lock<mutex> lock(m_mutex);
+    m_writing = true;
+    m_cv.notify_all();
+    m_cv.wait(lock, [this]() { return !m_held; });
+    m_writing = false;
+    m_batchSizes.push_back(batch.size());
+    return !m_failing;
+  }
+
+  RemoteStorageWriter::WriteBatch Sink() {
+    return [this](vector<RemoteStorageWriter::Op>& batch) {
+      return Write(batch);
+    };
+  }
+
+  void Hold() {
+    lock_guard<mutex> g(m_mutex);
+    m_held = true;
+  }
+
+  void Release() {
+    {
+      lock_guard<mutex> g(m_mutex);
+      m_held = false;
+    }
+    m_cv.notify_all();
+  }
+
+  void SetFailing(bool failing) {
+    lock_guard<mutex> g(m_mutex);
+    m_failing = failing;
+  }
+
+  void WaitForWrite() {
+    unique_lock<mutex> lock(m_mutex);
+    m_cv.wait(lock, [this]() { return m_writing; });
+  }
+
+  vector<size_t> GetBatchSizes() {
+    lock_guard<mutex> g(m_mutex);
+    return m_batchSizes;
+  }
+
+ private:
+  mutex m_mutex;
+  condition_variable m_cv;
+  bool m_held = false;
+  bool m_writing = false;
+  bool m_failing = false;
+  vector<size_t> m_batchSizes;
+};
+
+RemoteStorageWriter::Op MakeOp(unsigned int i) {
+  return mongocxx::model::insert_one{
+      make_document(kvp("ID", to_string(i)), kvp("status", 1))};
+}
+
+}  // namespace
+
+struct Fixture {
+  Fixture() { INIT_STDOUT_LOGGER() }
+};
+
+BOOST_GLOBAL_FIXTURE(Fixture);
+
+BOOST_AUTO_TEST_SUITE(remotestoragewritertest)
+
+BOOST_AUTO_TEST_CASE(batches_by_size) {
+  StandInMongo mongo;
+  RemoteStorageWriter writer{mongo.Sink(), 100, 10, chrono::seconds(60),
+                             chrono::milliseconds(100)};
+  for (unsigned int i = 0; i < 25; i++) {
+    BOOST_CHECK(writer.Enqueue(MakeOp(i)));
+  }
+  BOOST_CHECK(writer.FlushAndWait());
+  BOOST_CHECK_EQUAL(writer.GetQueued(), 0);
+
+  const auto batchSizes = mongo.GetBatchSizes();
+  BOOST_REQUIRE_EQUAL(batchSizes.size(), 3);
+  BOOST_CHECK_EQUAL(batchSizes[0], 10);
+  BOOST_CHECK_EQUAL(batchSizes[1], 10);
+  BOOST_CHECK_EQUAL(batchSizes[2], 5);
+}
+
+BOOST_AUTO_TEST_CASE(batches_by_time) {
+  StandInMongo mongo;
+  RemoteStorageWriter writer{mongo.Sink(), 100, 10, chrono::milliseconds(50),
+                             chrono::milliseconds(100)};
+  for (unsigned int i = 0; i < 3; i++) {
+    BOOST_CHECK(writer.Enqueue(MakeOp(i)));
+  }
+  // Written without a flush once the oldest op waited for the batch delay
+  mongo.WaitForWrite();
+  this_thread::sleep_for(chrono::milliseconds(50));
+  BOOST_CHECK_EQUAL(writer.GetQueued(), 0);
+  BOOST_REQUIRE_EQUAL(mongo.GetBatchSizes().size(), 1);
+  BOOST_CHECK_EQUAL(mongo.GetBatchSizes()[0], 3);
+}
+
+BOOST_AUTO_TEST_CASE(applies_backpressure) {
+  constexpr auto ENQUEUE_TIMEOUT = chrono::milliseconds(100);
+
+  StandInMongo mongo;
+  mongo.Hold();
+  RemoteStorageWriter writer{mongo.Sink(), 5, 5, chrono::seconds(60),
+                             ENQUEUE_TIMEOUT};
+
+  // A full batch is taken off the queue while mongod holds it
+  for (unsigned int i = 0; i < 5; i++) {
+    BOOST_CHECK(writer.Enqueue(MakeOp(i)));
+  }
+  mongo.WaitForWrite();
+  for (unsigned int i = 5; i < 10; i++) {
+    BOOST_CHECK(writer.Enqueue(MakeOp(i)));
+  }
+  BOOST_CHECK_EQUAL(writer.GetQueued(), 5);
+
+  // The queue is full, the first op waits for room then is dropped
+  auto started = chrono::steady_clock::now();
+  BOOST_CHECK(!writer.Enqueue(MakeOp(10)));
+  BOOST_CHECK(chrono::steady_clock::now() - started >= ENQUEUE_TIMEOUT);
+
+  // The next ones are dropped without waiting
+  started = chrono::steady_clock::now();
+  BOOST_CHECK(!writer.Enqueue(MakeOp(11)));
+  BOOST_CHECK(chrono::steady_clock::now() - started < ENQUEUE_TIMEOUT);
+
+  mongo.Release();
+  BOOST_CHECK(writer.FlushAndWait());
+  const auto batchSizes = mongo.GetBatchSizes();
+  BOOST_REQUIRE_EQUAL(batchSizes.size(), 2);
+  BOOST_CHECK_EQUAL(batchSizes[0] + batchSizes[1], 10);
+
+  // Batches are written again, so ops are accepted again
+  BOOST_CHECK(writer.Enqueue(MakeOp(12)));
+  BOOST_CHECK(writer.FlushAndWait());
+}
+
+BOOST_AUTO_TEST_CASE(reports_failed_writes) {
+  StandInMongo mongo;
+  mongo.SetFailing(true);
+  RemoteStorageWriter writer{mongo.Sink(), 100, 10, chrono::seconds(60),
+                             chrono::milliseconds(100)};
+  BOOST_CHECK(writer.Enqueue(MakeOp(0)));
+  BOOST_CHECK(!writer.FlushAndWait());
+
+  mongo.SetFailing(false);
+  BOOST_CHECK(writer.Enqueue(MakeOp(1)));
+  BOOST_CHECK(writer.FlushAndWait());
+}
+
+BOOST_AUTO_TEST_CASE(writes_queued_ops_when_stopped) {
+  StandInMongo mongo;
+  {
+    RemoteStorageWriter writer{mongo.Sink(), 100, 10, chrono::seconds(60),
+                               chrono::milliseconds(100)};
+    for (unsigned int i = 0; i < 15; i++) {
+      BOOST_CHECK(writer.Enqueue(MakeOp(i)));
+    }
+  }
+  size_t written = 0;
+  for (const auto size : mongo.GetBatchSizes()) {
+    written += size;
+  }
+  BOOST_CHECK_EQUAL(written, 15);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
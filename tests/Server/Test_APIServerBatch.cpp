@@ -0,0 +1,234 @@
+/*
+ * Copyright (C) 2023 Zilliqa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <jsonrpccpp/client/connectors/httpclient.h>
+#include <jsonrpccpp/server.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#include "libServer/APIServer.h"
+#include "libUtils/Logger.h"
+
+#define BOOST_TEST_MODULE apiserverbatch
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+using namespace rpc;
+
+namespace {
+
+constexpr uint16_t TEST_PORT = 4301;
+constexpr size_t NUM_THREADS = 8;
+constexpr size_t MAX_BATCH_SIZE = 100;
+constexpr uint64_t CALL_DURATION_MS = 10;
+
+/// Upper bound for a call waiting on its peer, only reached if the batch is
+/// not executed concurrently
+constexpr auto MEET_TIMEOUT = std::chrono::seconds(10);
+
+/// Server which records how many of its calls run at the same time
+class TestServer : public jsonrpc::AbstractServer<TestServer> {
+ public:
+  explicit TestServer(jsonrpc::AbstractServerConnector& connector)
+      : jsonrpc::AbstractServer<TestServer>(connector,
+                                            jsonrpc::JSONRPC_SERVER_V2) {
+    this->bindAndAddMethod(
+        jsonrpc::Procedure("Sleep", jsonrpc::PARAMS_BY_POSITION,
+                           jsonrpc::JSON_INTEGER, "param01",
+                           jsonrpc::JSON_INTEGER, NULL),
+        &TestServer::SleepI);
+    this->bindAndAddMethod(
+        jsonrpc::Procedure("Meet", jsonrpc::PARAMS_BY_POSITION,
+                           jsonrpc::JSON_BOOLEAN, "param01",
+                           jsonrpc::JSON_INTEGER, NULL),
+        &TestServer::MeetI);
+    this->bindAndAddNotification(
+        jsonrpc::Procedure("Notify", jsonrpc::PARAMS_BY_POSITION, "param01",
+                           jsonrpc::JSON_INTEGER, NULL),
+        &TestServer::NotifyI);
+  }
+
+  void SleepI(const Json::Value& request, Json::Value& response) {
+    Enter();
+    std::this_thread::sleep_for(std::chrono::milliseconds(CALL_DURATION_MS));
+    Leave();
+    response = request[0u];
+  }
+
+  /// Waits until as many calls as given in the parameter have arrived, the
+  /// result is false if they did not within MEET_TIMEOUT
+  void MeetI(const Json::Value& request, Json::Value& response) {
+    const auto expected = request[0u].asUInt64();
+    std::unique_lock<std::mutex> lock(m_meetMutex);
+    ++m_arrived;
+    m_meetCondition.notify_all();
+    response = m_meetCondition.wait_for(
+        lock, MEET_TIMEOUT, [&] { return m_arrived >= expected; });
+  }
+
+  void NotifyI(const Json::Value&) { ++m_notifications; }
+
+  size_t GetMaxConcurrent() const { return m_maxConcurrent; }
+  size_t GetNotifications() const { return m_notifications; }
+
+  void ResetCounters() {
+    m_maxConcurrent = 0;
+    m_notifications = 0;
+  }
+
+ private:
+  void Enter() {
+    size_t running = ++m_running;
+    size_t max = m_maxConcurrent;
+    while (running > max &&
+           !m_maxConcurrent.compare_exchange_weak(max, running)) {
+    }
+  }
+
+  void Leave() { --m_running; }
+
+  std::atomic<size_t> m_running{0};
+  std::atomic<size_t> m_maxConcurrent{0};
+  std::atomic<size_t> m_notifications{0};
+
+  std::mutex m_meetMutex;
+  std::condition_variable m_meetCondition;
+  uint64_t m_arrived = 0;
+};
+
+Json::Value MakeCall(const std::string& method, uint64_t param) {
+  Json::Value call;
+  call["jsonrpc"] = "2.0";
+  call["method"] = method;
+  call["params"].append(Json::UInt64(param));
+  return call;
+}
+
+std::string WriteBatch(const Json::Value& batch) {
+  Json::StreamWriterBuilder builder;
+  builder["indentation"] = "";
+  return Json::writeString(builder, batch);
+}
+
+std::string MakeBatch(size_t batchSize) {
+  Json::Value batch = Json::arrayValue;
+  for (size_t i = 0; i < batchSize; ++i) {
+    Json::Value call = MakeCall("Sleep", i);
+    call["id"] = Json::UInt64(i);
+    batch.append(call);
+  }
+  return WriteBatch(batch);
+}
+
+struct Fixture {
+  Fixture() {
+    INIT_STDOUT_LOGGER();
+
+    APIServer::Options options;
+    options.port = TEST_PORT;
+    options.bindToLocalhost = true;
+    options.threadPoolName = "BatchTest";
+    options.numThreads = NUM_THREADS;
+    options.maxBatchSize = MAX_BATCH_SIZE;
+
+    apiServer = APIServer::CreateAndStart(std::move(options));
+    BOOST_REQUIRE(apiServer);
+    server = std::make_unique<TestServer>(apiServer->GetRPCServerBackend());
+  }
+
+  ~Fixture() { apiServer->Close(); }
+
+  std::shared_ptr<APIServer> apiServer;
+  std::unique_ptr<TestServer> server;
+  jsonrpc::HttpClient client{"http://127.0.0.1:" + std::to_string(TEST_PORT)};
+};
+
+}  // namespace
+
+BOOST_FIXTURE_TEST_SUITE(apiserverbatch, Fixture)
+
+BOOST_AUTO_TEST_CASE(test_batch_order_and_concurrency) {
+  for (size_t batchSize : {1, 10, 100}) {
+    server->ResetCounters();
+
+    std::string result;
+    client.SendRPCMessage(MakeBatch(batchSize), result);
+
+    Json::Value responses;
+    BOOST_REQUIRE(Json::Reader().parse(result, responses));
+    BOOST_REQUIRE(responses.isArray());
+    BOOST_REQUIRE_EQUAL(responses.size(), batchSize);
+
+    // Responses must come back in request order
+    for (Json::ArrayIndex i = 0; i < batchSize; ++i) {
+      BOOST_CHECK_EQUAL(responses[i]["id"].asUInt64(), i);
+      BOOST_CHECK_EQUAL(responses[i]["result"].asUInt64(), i);
+    }
+
+    // A batch never occupies more than the whole pool
+    BOOST_CHECK_LE(server->GetMaxConcurrent(),
+                   std::min(batchSize, NUM_THREADS));
+  }
+
+  // Each call only completes once the other one has started, which cannot
+  // happen if the batch is executed sequentially
+  Json::Value batch = Json::arrayValue;
+  for (uint64_t i = 0; i < 2; ++i) {
+    Json::Value call = MakeCall("Meet", 2);
+    call["id"] = Json::UInt64(i);
+    batch.append(call);
+  }
+
+  std::string result;
+  client.SendRPCMessage(WriteBatch(batch), result);
+
+  Json::Value responses;
+  BOOST_REQUIRE(Json::Reader().parse(result, responses));
+  BOOST_REQUIRE(responses.isArray());
+  BOOST_REQUIRE_EQUAL(responses.size(), 2);
+  BOOST_CHECK(responses[0]["result"].asBool());
+  BOOST_CHECK(responses[1]["result"].asBool());
+}
+
+BOOST_AUTO_TEST_CASE(test_batch_size_limit) {
+  std::string result;
+  client.SendRPCMessage(MakeBatch(MAX_BATCH_SIZE + 1), result);
+  Json::Value response;
+  BOOST_REQUIRE(Json::Reader().parse(result, response));
+  BOOST_CHECK(response.isObject());
+  BOOST_CHECK(response.isMember("error"));
+}
+
+BOOST_AUTO_TEST_CASE(test_batch_of_notifications) {
+  constexpr size_t batchSize = 3;
+  Json::Value batch = Json::arrayValue;
+  for (size_t i = 0; i < batchSize; ++i) {
+    batch.append(MakeCall("Notify", i));
+  }
+
+  // Any response code other than 2xx makes the client throw
+  std::string result;
+  BOOST_CHECK_NO_THROW(client.SendRPCMessage(WriteBatch(batch), result));
+  BOOST_CHECK(result.empty());
+  BOOST_CHECK_EQUAL(server->GetNotifications(), batchSize);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
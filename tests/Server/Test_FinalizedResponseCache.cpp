@@ -0,0 +1,87 @@
+/*
+ * Copyright (C) 2023 Zilliqa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "libServer/FinalizedResponseCache.h"
+#include "libUtils/Logger.h"
+
+#define BOOST_TEST_MODULE finalizedresponsecache
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+using namespace rpc;
+
+BOOST_AUTO_TEST_SUITE(finalizedresponsecache)
+
+Json::Value makeResponse(uint64_t blockNum) {
+  Json::Value response;
+  response["number"] = std::to_string(blockNum);
+  response["payload"] = std::string(100, 'a');
+  return response;
+}
+
+BOOST_AUTO_TEST_CASE(test_hit_and_miss) {
+  INIT_STDOUT_LOGGER();
+
+  FinalizedResponseCache cache(1024 * 1024);
+  const auto key = FinalizedResponseCache::MakeKey("eth_getBlock", 7, true);
+
+  BOOST_CHECK(!cache.Get(key));
+  cache.Put(key, makeResponse(7));
+
+  auto cached = cache.Get(key);
+  BOOST_REQUIRE(cached);
+  BOOST_CHECK_EQUAL((*cached)["number"].asString(), "7");
+
+  BOOST_CHECK(!cache.Get(FinalizedResponseCache::MakeKey("eth_getBlock", 7)));
+  BOOST_CHECK_NE(FinalizedResponseCache::MakeKey("eth_getBlock", "07"),
+                 FinalizedResponseCache::MakeKey("eth_getBlock", 7));
+
+  cache.Clear();
+  BOOST_CHECK(!cache.Get(key));
+}
+
+BOOST_AUTO_TEST_CASE(test_lru_eviction) {
+  INIT_STDOUT_LOGGER();
+
+  // Room for roughly two responses
+  FinalizedResponseCache cache(300);
+  const auto key1 = FinalizedResponseCache::MakeKey("GetTxBlock", 1);
+  const auto key2 = FinalizedResponseCache::MakeKey("GetTxBlock", 2);
+  const auto key3 = FinalizedResponseCache::MakeKey("GetTxBlock", 3);
+
+  cache.Put(key1, makeResponse(1));
+  cache.Put(key2, makeResponse(2));
+
+  // Touch key1 so that key2 becomes the least recently used
+  BOOST_CHECK(cache.Get(key1));
+  cache.Put(key3, makeResponse(3));
+
+  BOOST_CHECK(cache.Get(key1));
+  BOOST_CHECK(!cache.Get(key2));
+  BOOST_CHECK(cache.Get(key3));
+}
+
+BOOST_AUTO_TEST_CASE(test_disabled) {
+  INIT_STDOUT_LOGGER();
+
+  FinalizedResponseCache cache(0);
+  const auto key = FinalizedResponseCache::MakeKey("GetTxBlock", 1);
+  cache.Put(key, makeResponse(1));
+  BOOST_CHECK(!cache.Get(key));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
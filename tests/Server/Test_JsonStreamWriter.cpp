@@ -0,0 +1,154 @@
+/*
+ * Copyright (C) 2023 Zilliqa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <sys/resource.h>
+#include <chrono>
+#include <vector>
+
+#include "libServer/JsonStreamWriter.h"
+#include "libUtils/Logger.h"
+
+#define BOOST_TEST_MODULE jsonstreamwriter
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+using namespace rpc;
+
+namespace {
+
+std::string WriteWithBuilder(const Json::Value& value) {
+  Json::StreamWriterBuilder builder;
+  builder["indentation"] = "";
+  return Json::writeString(builder, value);
+}
+
+std::string WriteStreaming(Json::Value value) {
+  std::string out;
+  JsonStreamWriter(out).Write(std::move(value));
+  return out;
+}
+
+/// Resembles a GetTxnBodiesForTxBlock response
+Json::Value MakeLargeResponse(size_t approxBytes) {
+  Json::Value result = Json::arrayValue;
+  size_t bytes = 0;
+  for (uint64_t i = 0; bytes < approxBytes; ++i) {
+    Json::Value txn;
+    txn["ID"] = std::string(64, 'a' + (i % 26));
+    txn["amount"] = std::to_string(i * 1000);
+    txn["nonce"] = std::to_string(i);
+    txn["receipt"]["cumulative_gas"] = std::to_string(i * 50);
+    txn["receipt"]["success"] = true;
+    txn["toAddr"] = std::string(40, '0');
+    bytes += 250;
+    result.append(std::move(txn));
+  }
+
+  Json::Value response;
+  response["id"] = 1;
+  response["jsonrpc"] = "2.0";
+  response["result"] = std::move(result);
+  return response;
+}
+
+long MaxRssKb() {
+  struct rusage usage {};
+  getrusage(RUSAGE_SELF, &usage);
+  return usage.ru_maxrss;
+}
+
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(jsonstreamwriter)
+
+BOOST_AUTO_TEST_CASE(test_same_output_as_jsoncpp) {
+  INIT_STDOUT_LOGGER();
+
+  Json::Value value;
+  value["null"] = Json::nullValue;
+  value["bool"] = false;
+  value["int"] = Json::Int64(-42);
+  value["uint"] = Json::UInt64(18446744073709551615ULL);
+  value["double"] = 0.1;
+  value["string"] = "quote\" backslash\\ newline\n tab\t utf8 \xc3\xa9";
+  value["emptyArray"] = Json::arrayValue;
+  value["emptyObject"] = Json::objectValue;
+  value["nested"]["array"].append(1);
+  value["nested"]["array"].append("two");
+  value["nested"]["array"].append(Json::objectValue);
+  value["nested"]["z"]["a"] = Json::arrayValue;
+
+  BOOST_CHECK_EQUAL(WriteStreaming(value), WriteWithBuilder(value));
+
+  const std::vector<Json::Value> scalars{Json::Value{}, Json::Value{true},
+                                         Json::Value{"text"}, Json::Value{7}};
+  for (const auto& scalar : scalars) {
+    BOOST_CHECK_EQUAL(WriteStreaming(scalar), WriteWithBuilder(scalar));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(test_value_consumed) {
+  INIT_STDOUT_LOGGER();
+
+  Json::Value value;
+  value["a"].append(1);
+  std::string out;
+  JsonStreamWriter(out).Write(std::move(value));
+  BOOST_CHECK(value.isNull());
+  BOOST_CHECK_EQUAL(out, "{\"a\":[1]}");
+}
+
+BOOST_AUTO_TEST_CASE(test_large_response_report) {
+  INIT_STDOUT_LOGGER();
+
+  constexpr size_t RESPONSE_BYTES = 10 * 1024 * 1024;
+
+  // Streaming path first, the peak RSS of a process never decreases
+  std::string streamed;
+  {
+    auto response = MakeLargeResponse(RESPONSE_BYTES);
+    const auto rssBefore = MaxRssKb();
+    const auto started = std::chrono::steady_clock::now();
+    JsonStreamWriter(streamed).Write(std::move(response));
+    const auto elapsed =
+        std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - started)
+            .count();
+    LOG_GENERAL(INFO, "Streaming writer: " << streamed.size() << " bytes in "
+                                           << elapsed << " ms, peak RSS +"
+                                           << MaxRssKb() - rssBefore << " KB");
+  }
+
+  std::string built;
+  {
+    auto response = MakeLargeResponse(RESPONSE_BYTES);
+    const auto rssBefore = MaxRssKb();
+    const auto started = std::chrono::steady_clock::now();
+    built = WriteWithBuilder(response);
+    const auto elapsed =
+        std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - started)
+            .count();
+    LOG_GENERAL(INFO, "jsoncpp writer: " << built.size() << " bytes in "
+                                         << elapsed << " ms, peak RSS +"
+                                         << MaxRssKb() - rssBefore << " KB");
+  }
+
+  BOOST_CHECK(streamed == built);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,128 @@
+/*
+ * Copyright (C) 2023 Zilliqa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <chrono>
+#include <thread>
+
+#include "libMetrics/EpochTimeline.h"
+#include "libUtils/Logger.h"
+
+#define BOOST_TEST_MODULE epochtimeline
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+
+struct Fixture {
+  Fixture() { INIT_STDOUT_LOGGER() }
+};
+
+BOOST_GLOBAL_FIXTURE(Fixture);
+
+BOOST_AUTO_TEST_SUITE(epochtimeline)
+
+BOOST_AUTO_TEST_CASE(records_phases_by_epoch) {
+  auto& timeline = EpochTimeline::GetInstance();
+  timeline.SetEpoch(1, 10);
+  {
+    EpochPhaseScope phase(EpochPhase::TXN_PROCESSING);
+    this_thread::sleep_for(chrono::milliseconds(5));
+  }
+  // A phase that ends in the next epoch is kept in the one it began in
+  timeline.Begin(EpochPhase::FINALBLOCK_CONSENSUS);
+  timeline.SetEpoch(1, 11);
+  timeline.End(EpochPhase::FINALBLOCK_CONSENSUS);
+  // Ending a phase that didn't begin records nothing
+  timeline.End(EpochPhase::DS_CONSENSUS);
+  timeline.Record(EpochPhase::PERSISTENCE, 11, chrono::system_clock::now(),
+                  chrono::milliseconds(2));
+  timeline.Record(EpochPhase::PERSISTENCE, 11, chrono::system_clock::now(),
+                  chrono::milliseconds(3));
+
+  const auto recent = timeline.GetRecent(2);
+  BOOST_REQUIRE_EQUAL(recent.size(), 2);
+  BOOST_CHECK_EQUAL(recent[0].m_txEpoch, 11);
+  BOOST_CHECK_EQUAL(recent[1].m_txEpoch, 10);
+  BOOST_CHECK_EQUAL(recent[1].m_dsEpoch, 1);
+
+  const auto& processing = recent[1].m_phases[static_cast<size_t>(
+      EpochPhase::TXN_PROCESSING)];
+  BOOST_CHECK_EQUAL(processing.m_count, 1);
+  BOOST_CHECK_GE(processing.m_duration.count(), 5);
+  BOOST_CHECK_EQUAL(recent[1]
+                        .m_phases[static_cast<size_t>(
+                            EpochPhase::FINALBLOCK_CONSENSUS)]
+                        .m_count,
+                    1);
+
+  const auto& persistence =
+      recent[0].m_phases[static_cast<size_t>(EpochPhase::PERSISTENCE)];
+  BOOST_CHECK_EQUAL(persistence.m_count, 2);
+  BOOST_CHECK_EQUAL(persistence.m_duration.count(), 5);
+  BOOST_CHECK_EQUAL(
+      recent[0].m_phases[static_cast<size_t>(EpochPhase::DS_CONSENSUS)].m_count,
+      0);
+}
+
+BOOST_AUTO_TEST_CASE(keeps_the_latest_epochs) {
+  auto& timeline = EpochTimeline::GetInstance();
+  const uint64_t first = 1000;
+  for (uint64_t epoch = first; epoch < first + 2 * EpochTimeline::MAX_EPOCHS;
+       epoch++) {
+    timeline.SetEpoch(2, epoch);
+    timeline.Record(EpochPhase::STATE_COMMIT, epoch,
+                    chrono::system_clock::now(), chrono::milliseconds(1));
+  }
+
+  const auto recent = timeline.GetRecent(EpochTimeline::MAX_EPOCHS + 1);
+  BOOST_REQUIRE_EQUAL(recent.size(), EpochTimeline::MAX_EPOCHS);
+  BOOST_CHECK_EQUAL(recent.front().m_txEpoch,
+                    first + 2 * EpochTimeline::MAX_EPOCHS - 1);
+  BOOST_CHECK_EQUAL(recent.back().m_txEpoch,
+                    first + EpochTimeline::MAX_EPOCHS);
+  BOOST_CHECK_EQUAL(EpochTimeline::GetPhaseName(EpochPhase::STATE_COMMIT),
+                    "STATE_COMMIT");
+}
+
+BOOST_AUTO_TEST_CASE(other_epochs_add_to_existing_records) {
+  auto& timeline = EpochTimeline::GetInstance();
+  timeline.SetEpoch(3, 5000);
+  timeline.Record(EpochPhase::STATE_COMMIT, 5000, chrono::system_clock::now(),
+                  chrono::milliseconds(1));
+  timeline.SetEpoch(4, 5001);
+
+  // The previous epoch has a record, with the DS epoch it ran in
+  timeline.Record(EpochPhase::PERSISTENCE, 5000, chrono::system_clock::now(),
+                  chrono::milliseconds(1));
+  // Blocks of older epochs, e.g. stored while syncing, have no DS epoch
+  timeline.Record(EpochPhase::PERSISTENCE, 4000, chrono::system_clock::now(),
+                  chrono::milliseconds(1));
+
+  const auto recent = timeline.GetRecent(EpochTimeline::MAX_EPOCHS);
+  BOOST_REQUIRE(!recent.empty());
+  BOOST_CHECK_EQUAL(recent.front().m_txEpoch, 5000);
+  BOOST_CHECK_EQUAL(recent.front().m_dsEpoch, 3);
+  BOOST_CHECK_EQUAL(recent.front()
+                        .m_phases[static_cast<size_t>(EpochPhase::PERSISTENCE)]
+                        .m_count,
+                    1);
+  for (const auto& record : recent) {
+    BOOST_CHECK_NE(record.m_txEpoch, 4000);
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,151 @@
+/*
+ * Copyright (C) 2023 Zilliqa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <chrono>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+#include "libMetrics/ScopedTimer.h"
+#include "libUtils/Logger.h"
+
+#define BOOST_TEST_MODULE scopedtimer
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+using zil::metrics::ScopedTimer;
+
+namespace {
+
+const string TIMED_CALL = "Test_ScopedTimer.cpp:TimedCall";
+const string SLEEPING_CALL = "Test_ScopedTimer.cpp:SleepingCall";
+
+volatile uint64_t g_sink = 0;
+
+void TimedCall(uint64_t value) {
+  SCOPED_TIMER();
+  g_sink = g_sink + value;
+}
+
+void MarkedCall(uint64_t value) {
+  LOG_MARKER();
+  g_sink = g_sink + value;
+}
+
+void LoggedBeforeFirstCall() { SCOPED_TIMER(); }
+
+void SleepingCall() {
+  SCOPED_TIMER();
+  this_thread::sleep_for(chrono::milliseconds(3));
+}
+
+template <class Func>
+double NsPerCall(unsigned int numCalls, Func&& func) {
+  const auto start = chrono::steady_clock::now();
+  for (unsigned int i = 0; i < numCalls; i++) {
+    func(i);
+  }
+  const auto elapsed = chrono::steady_clock::now() - start;
+  return chrono::duration<double, nano>(elapsed).count() / numCalls;
+}
+
+}  // namespace
+
+struct Fixture {
+  Fixture() { INIT_FILE_LOGGER("scopedtimer", "./") }
+};
+
+BOOST_GLOBAL_FIXTURE(Fixture);
+
+BOOST_AUTO_TEST_SUITE(scopedtimer)
+
+BOOST_AUTO_TEST_CASE(counts_calls_of_all_threads) {
+  constexpr unsigned int NUM_THREADS = 4;
+  constexpr unsigned int NUM_CALLS = 10000;
+
+  const auto before = ScopedTimer::GetStats(TIMED_CALL);
+  vector<thread> threads;
+  for (unsigned int t = 0; t < NUM_THREADS; t++) {
+    threads.emplace_back([] {
+      for (unsigned int i = 0; i < NUM_CALLS; i++) {
+        TimedCall(i);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  // The threads exited, their counters are kept
+  const auto after = ScopedTimer::GetStats(TIMED_CALL);
+  BOOST_CHECK_EQUAL(after.m_calls - before.m_calls, NUM_THREADS * NUM_CALLS);
+  BOOST_CHECK_EQUAL(
+      accumulate(after.m_buckets.begin(), after.m_buckets.end(), uint64_t{0}),
+      after.m_calls);
+  BOOST_CHECK_EQUAL(
+      ScopedTimer::GetStats("Test_ScopedTimer.cpp:NoSuchFunction").m_calls, 0);
+}
+
+BOOST_AUTO_TEST_CASE(buckets_by_latency) {
+  SleepingCall();
+  const auto stats = ScopedTimer::GetStats(SLEEPING_CALL);
+  BOOST_CHECK_EQUAL(stats.m_calls, 1);
+  BOOST_CHECK_GE(stats.m_totalNs, 3000000);
+  // 3 ms falls at or above the 2048 us bucket
+  BOOST_CHECK_EQUAL(
+      accumulate(stats.m_buckets.begin() + 12, stats.m_buckets.end(),
+                 uint64_t{0}),
+      1);
+}
+
+BOOST_AUTO_TEST_CASE(logging_per_site) {
+  TimedCall(1);
+  BOOST_CHECK(!ScopedTimer::IsLogging(TIMED_CALL));
+  ScopedTimer::SetLogging(TIMED_CALL, true);
+  BOOST_CHECK(ScopedTimer::IsLogging(TIMED_CALL));
+  // Sites are told apart by file, the bare function name matches nothing
+  BOOST_CHECK(!ScopedTimer::IsLogging("TimedCall"));
+  TimedCall(1);
+  ScopedTimer::SetLogging(TIMED_CALL, false);
+  BOOST_CHECK(!ScopedTimer::IsLogging(TIMED_CALL));
+
+  // A site reached after logging was enabled picks it up on registration
+  const string key = "Test_ScopedTimer.cpp:LoggedBeforeFirstCall";
+  ScopedTimer::SetLogging(key, true);
+  LoggedBeforeFirstCall();
+  BOOST_CHECK(ScopedTimer::IsLogging(key));
+  ScopedTimer::SetLogging(key, false);
+  BOOST_CHECK(!ScopedTimer::IsLogging(key));
+}
+
+BOOST_AUTO_TEST_CASE(overhead_per_marker) {
+  constexpr unsigned int NUM_CALLS = 100000;
+
+  const double markerNs = NsPerCall(NUM_CALLS, MarkedCall);
+  const double timerNs = NsPerCall(NUM_CALLS, TimedCall);
+  ScopedTimer::SetLogging(TIMED_CALL, true);
+  const double loggedTimerNs = NsPerCall(NUM_CALLS, TimedCall);
+  ScopedTimer::SetLogging(TIMED_CALL, false);
+
+  LOG_GENERAL(INFO, "LOG_MARKER: " << markerNs << " ns/call, SCOPED_TIMER: "
+                                   << timerNs << " ns/call, logged: "
+                                   << loggedTimerNs << " ns/call");
+  BOOST_CHECK_LT(timerNs, markerNs);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
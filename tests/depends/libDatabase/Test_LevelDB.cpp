@@ -17,6 +17,7 @@
 
 #include <arpa/inet.h>
 #include <array>
+#include <chrono>
 #include <string>
 #include <thread>
 #include <vector>
@@ -124,4 +125,121 @@ BOOST_AUTO_TEST_CASE(iterator_order) {
   delete iter;
 }
 
+BOOST_AUTO_TEST_CASE(tuning_profiles) {
+  LOG_MARKER();
+
+  BOOST_CHECK(LevelDB::GetProfile("txBodies") == LevelDBProfile::POINT_LOOKUP);
+  BOOST_CHECK(LevelDB::GetProfile("txBlocks") ==
+              LevelDBProfile::SEQUENTIAL_WRITE);
+  BOOST_CHECK(LevelDB::GetProfile("tuning_profiles") ==
+              LevelDBProfile::DEFAULT);
+
+  // Rotated databases share the profile of the first one
+  BOOST_CHECK(LevelDB::GetProfile("txBodies_1") ==
+              LevelDBProfile::POINT_LOOKUP);
+  BOOST_CHECK(LevelDB::GetProfile("txBodies_12") ==
+              LevelDBProfile::POINT_LOOKUP);
+  BOOST_CHECK(LevelDB::GetProfile("txBodies_") == LevelDBProfile::DEFAULT);
+  BOOST_CHECK(LevelDB::GetProfile("txBodies_x") == LevelDBProfile::DEFAULT);
+
+  // Reads through the shared block cache return what was written
+  LevelDB testDB("txBodies");
+  for (unsigned int i = 0; i < 1000; ++i) {
+    testDB.Insert(to_string(i), zbytes(100, static_cast<uint8_t>(i)));
+  }
+  testDB.compact();
+  for (unsigned int i = 0; i < 1000; ++i) {
+    BOOST_CHECK_EQUAL(testDB.Lookup(to_string(i)),
+                      string(100, static_cast<char>(i)));
+  }
+  BOOST_CHECK(testDB.Lookup(string("missing")).empty());
+}
+
+BOOST_AUTO_TEST_CASE(block_num_keys) {
+  LOG_MARKER();
+
+  constexpr uint64_t NUM_BLOCKS = 20000;
+
+  BOOST_CHECK(LevelDB::BlockNumKey(9) < LevelDB::BlockNumKey(10));
+  BOOST_CHECK(LevelDB::BlockNumKey(255) < LevelDB::BlockNumKey(256));
+  BOOST_CHECK(LevelDB::BlockNumKey(UINT64_MAX) < "0");
+
+  uint64_t parsed = 0;
+  BOOST_CHECK(LevelDB::ParseBlockNumKey(LevelDB::BlockNumKey(12345), parsed));
+  BOOST_CHECK_EQUAL(parsed, 12345u);
+  BOOST_CHECK(LevelDB::ParseBlockNumKey(leveldb::Slice("12345678"), parsed));
+  BOOST_CHECK_EQUAL(parsed, 12345678u);
+  BOOST_CHECK(!LevelDB::ParseBlockNumKey(leveldb::Slice("MaxKey"), parsed));
+
+  LevelDB testDB("txBlocks");
+  testDB.ResetDB();
+  BOOST_CHECK(testDB.HasBinaryBlockNumKeys());
+
+  // Decimal keys as written before the migration
+  for (uint64_t i = 0; i < NUM_BLOCKS; ++i) {
+    testDB.Insert(leveldb::Slice(to_string(i)), leveldb::Slice(to_string(i)));
+  }
+  testDB.compact();
+
+  BOOST_CHECK_EQUAL(testDB.Lookup((uint256_t)1234), "1234");
+
+  auto start = chrono::steady_clock::now();
+  uint64_t last = 0;
+  BOOST_CHECK(testDB.GetLastBlockNum(last));
+  BOOST_CHECK_EQUAL(last, NUM_BLOCKS - 1);
+  LOG_GENERAL(INFO, "GetLastBlockNum with decimal keys: "
+                        << chrono::duration_cast<chrono::microseconds>(
+                               chrono::steady_clock::now() - start)
+                               .count()
+                        << " us");
+
+  // Interrupted migration leaves both encodings readable
+  BOOST_CHECK_EQUAL(testDB.MigrateBlockNumKeys(NUM_BLOCKS / 2, 1000),
+                    NUM_BLOCKS / 2);
+  for (uint64_t i = 0; i < NUM_BLOCKS; i += 997) {
+    BOOST_CHECK_EQUAL(testDB.Lookup((uint256_t)i), to_string(i));
+  }
+  BOOST_CHECK(testDB.GetLastBlockNum(last));
+  BOOST_CHECK_EQUAL(last, NUM_BLOCKS - 1);
+
+  BOOST_CHECK_EQUAL(testDB.MigrateBlockNumKeys(NUM_BLOCKS),
+                    NUM_BLOCKS - NUM_BLOCKS / 2);
+  BOOST_CHECK_EQUAL(testDB.MigrateBlockNumKeys(NUM_BLOCKS), 0u);
+  testDB.compact();
+
+  start = chrono::steady_clock::now();
+  BOOST_CHECK(testDB.GetLastBlockNum(last));
+  BOOST_CHECK_EQUAL(last, NUM_BLOCKS - 1);
+  LOG_GENERAL(INFO, "GetLastBlockNum with binary keys: "
+                        << chrono::duration_cast<chrono::microseconds>(
+                               chrono::steady_clock::now() - start)
+                               .count()
+                        << " us");
+
+  // Range scan in numeric order
+  start = chrono::steady_clock::now();
+  std::unique_ptr<leveldb::Iterator> it{
+      testDB.GetDB()->NewIterator(leveldb::ReadOptions())};
+  uint64_t expected = 100;
+  for (it->Seek(LevelDB::BlockNumKey(100)); it->Valid() && expected < 200;
+       it->Next(), ++expected) {
+    BOOST_REQUIRE(LevelDB::ParseBlockNumKey(it->key(), parsed));
+    BOOST_CHECK_EQUAL(parsed, expected);
+  }
+  BOOST_CHECK_EQUAL(expected, 200u);
+  LOG_GENERAL(INFO, "Range scan of 100 blocks: "
+                        << chrono::duration_cast<chrono::microseconds>(
+                               chrono::steady_clock::now() - start)
+                               .count()
+                        << " us");
+
+  // New writes and deletes use the binary keys
+  testDB.Insert((uint256_t)NUM_BLOCKS, string("new"));
+  BOOST_CHECK_EQUAL(testDB.Lookup(LevelDB::BlockNumKey(NUM_BLOCKS)), "new");
+  BOOST_CHECK_EQUAL(testDB.DeleteKey((uint256_t)NUM_BLOCKS), 0);
+  BOOST_CHECK(!testDB.Exists((uint256_t)NUM_BLOCKS));
+
+  testDB.ResetDB();
+}
+
 BOOST_AUTO_TEST_SUITE_END()